@@ -0,0 +1,117 @@
+#include "AdaptiveSmoother.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr double minimumNoiseVariance = 1.0e-4; // BPM^2
+    constexpr double minimumSpan = 1.0e-3;          // seconds
+
+    void updateAverage(double& average, bool& primed, double sample, double weight)
+    {
+        if (! primed)
+        {
+            average = sample;
+            primed = true;
+            return;
+        }
+
+        average += weight * (sample - average);
+    }
+}
+
+void AdaptiveSmoother::setTimeConstantRange(float minSeconds, float maxSeconds)
+{
+    minTimeConstant = std::max(0.01f, std::min(minSeconds, maxSeconds));
+    maxTimeConstant = std::max(minTimeConstant, std::max(minSeconds, maxSeconds));
+    timeConstant = std::clamp(timeConstant, minTimeConstant, maxTimeConstant);
+}
+
+void AdaptiveSmoother::reset()
+{
+    readingCount = 0;
+    newestIndex = 0;
+    shortVariance = shortSpan = longVariance = longSpan = 0.0;
+    shortPrimed = longPrimed = false;
+    timeConstant = std::sqrt(minTimeConstant * maxTimeConstant);
+    outputInitialised = false;
+}
+
+void AdaptiveSmoother::addMeasurement(float value, double timeSeconds)
+{
+    constexpr int ringSize = LAG; // oldest slot is exactly LAG readings back
+
+    if (readingCount > 0)
+    {
+        const auto& previous = readings[(size_t)newestIndex];
+        const double span = timeSeconds - previous.time;
+        if (span < minimumSpan)
+            return; // duplicate or out-of-order reading
+
+        const double diff = value - previous.value;
+        bool spanPrimed = shortPrimed;
+        updateAverage(shortVariance, shortPrimed, diff * diff, FORGETTING);
+        updateAverage(shortSpan, spanPrimed, span, FORGETTING);
+
+        if (readingCount >= LAG)
+        {
+            const auto& lagged = readings[(size_t)((newestIndex + 1) % ringSize)];
+            const double longDiff = value - lagged.value;
+            bool longSpanPrimed = longPrimed;
+            updateAverage(longVariance, longPrimed, longDiff * longDiff, FORGETTING);
+            updateAverage(longSpan, longSpanPrimed, timeSeconds - lagged.time, FORGETTING);
+        }
+    }
+
+    newestIndex = (readingCount == 0) ? 0 : (newestIndex + 1) % ringSize;
+    readings[(size_t)newestIndex] = { value, timeSeconds };
+    readingCount = std::min(readingCount + 1, ringSize);
+
+    if (longPrimed)
+        retune();
+}
+
+float AdaptiveSmoother::advance(float target, float dtSeconds)
+{
+    if (! outputInitialised)
+    {
+        output = target;
+        outputInitialised = true;
+        return output;
+    }
+
+    if (dtSeconds > 0.0f)
+    {
+        const float alpha = 1.0f - std::exp(-dtSeconds / timeConstant);
+        output += alpha * (target - output);
+    }
+
+    return output;
+}
+
+float AdaptiveSmoother::getMeasurementAlpha() const
+{
+    const double interval = shortPrimed ? std::max(shortSpan, minimumSpan) : 1.0;
+    return (float)(1.0 - std::exp(-interval / timeConstant));
+}
+
+void AdaptiveSmoother::retune()
+{
+    // Local-level model: Var(z[n]-z[n-k]) = 2R + q * span_k
+    const double spanDelta = std::max(longSpan - shortSpan, minimumSpan);
+    const double trendRate = std::max(0.0, (longVariance - shortVariance) / spanDelta);
+    const double noiseVariance = std::max(minimumNoiseVariance, 0.5 * (shortVariance - trendRate * shortSpan));
+
+    // Steady-state Kalman gain for signal-to-noise ratio lambda
+    const double lambda = trendRate * shortSpan / noiseVariance;
+    const double gain = 0.5 * (-lambda + std::sqrt(lambda * lambda + 4.0 * lambda));
+
+    double tau = maxTimeConstant;
+    if (gain >= 1.0)
+        tau = minTimeConstant;
+    else if (gain > 0.0)
+        tau = -shortSpan / std::log(1.0 - gain);
+
+    timeConstant = (float)std::clamp(tau, (double)minTimeConstant, (double)maxTimeConstant);
+}
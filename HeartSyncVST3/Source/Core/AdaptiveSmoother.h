@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+
+/**
+ * @brief Heart-rate smoother whose time constant tracks the signal statistics.
+ *
+ * Treats the heart rate as a local-level process (random-walk trend plus
+ * white measurement noise). Each new measurement updates running estimates
+ * of the first-difference and K-lag-difference variances; their ratio
+ * separates trend variance from noise variance, which gives the steady-state
+ * Kalman gain and therefore the time constant. At rest (noise dominated) the
+ * time constant grows towards the maximum; during exercise ramps (trend
+ * dominated) it shrinks towards the minimum.
+ *
+ * addMeasurement() is O(1) and must be called once per new sensor reading.
+ * advance() runs the first-order low-pass with the adapted time constant and
+ * can be called at any rate (e.g. once per audio block). Single-threaded.
+ */
+class AdaptiveSmoother
+{
+public:
+    AdaptiveSmoother() = default;
+
+    void setTimeConstantRange(float minSeconds, float maxSeconds);
+    void reset();
+
+    /** Feeds one sensor reading (timeSeconds on any monotonic clock). */
+    void addMeasurement(float value, double timeSeconds);
+
+    /** Moves the output towards target over dtSeconds and returns it. */
+    float advance(float target, float dtSeconds);
+
+    float getValue() const { return output; }
+    float getTimeConstant() const { return timeConstant; }
+
+    /** Equivalent exponential-smoothing α per measurement interval. */
+    float getMeasurementAlpha() const;
+
+private:
+    static constexpr int LAG = 4;           // long-difference lag in measurements
+    static constexpr double FORGETTING = 0.05;
+
+    struct Reading
+    {
+        float value{0.0f};
+        double time{0.0};
+    };
+
+    void retune();
+
+    std::array<Reading, LAG> readings{};
+    int readingCount{0};
+    int newestIndex{0};
+
+    // Running statistics (exponentially weighted)
+    double shortVariance{0.0};   // E[(z[n] - z[n-1])^2]
+    double shortSpan{0.0};       // E[t[n] - t[n-1]]
+    double longVariance{0.0};    // E[(z[n] - z[n-LAG])^2]
+    double longSpan{0.0};        // E[t[n] - t[n-LAG]]
+    bool shortPrimed{false};
+    bool longPrimed{false};
+
+    float minTimeConstant{0.5f};
+    float maxTimeConstant{15.0f};
+    float timeConstant{3.0f};
+    float output{0.0f};
+    bool outputInitialised{false};
+};
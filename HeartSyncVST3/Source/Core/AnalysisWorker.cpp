@@ -0,0 +1,305 @@
+#include "AnalysisWorker.h"
+
+namespace
+{
+    constexpr double beatClockRealignMs = 2000.0;  // larger jumps mean beats were lost
+    constexpr double beatClockSmoothing = 0.05;    // notification latency jitter filter
+    constexpr double ecgActiveTimeoutMs = 3000.0;  // ECG beats older than this hand back to sensor RR
+}
+
+float AnalysisWorker::RespirationState::getPhaseAt(double nowMs) const
+{
+    if (! valid)
+        return 0.0f;
+
+    const double cycles = phaseCycles + (breathsPerMinute / 60.0) * (nowMs - referenceMs) / 1000.0;
+    return (float)(cycles - std::floor(cycles));
+}
+
+AnalysisWorker::AnalysisWorker()
+    : juce::Thread("HeartSync Analysis")
+{
+    rPeakDetector.onBeat = [this](const RPeakDetector::Beat& beat) { handleEcgBeat(beat); };
+}
+
+AnalysisWorker::~AnalysisWorker()
+{
+    stop();
+}
+
+void AnalysisWorker::start()
+{
+    if (! isThreadRunning())
+        startThread(juce::Thread::Priority::low);
+}
+
+void AnalysisWorker::stop()
+{
+    stopThread(1000);
+}
+
+void AnalysisWorker::pushRRIntervals(const juce::Array<float>& rrIntervalsMs, double receivedMs)
+{
+    if (rrIntervalsMs.isEmpty())
+        return;
+
+    const auto scope = intervalFifo.write(rrIntervalsMs.size());
+
+    for (int i = 0; i < scope.blockSize1; ++i)
+        intervals[(size_t)(scope.startIndex1 + i)] = { rrIntervalsMs.getUnchecked(i), receivedMs };
+
+    for (int i = 0; i < scope.blockSize2; ++i)
+        intervals[(size_t)(scope.startIndex2 + i)] = { rrIntervalsMs.getUnchecked(scope.blockSize1 + i), receivedMs };
+
+    notify();
+}
+
+void AnalysisWorker::pushEcgSamples(const float* samplesMicrovolts, int numSamples, double sampleRateHz,
+                                    bool discontinuity, double receivedMs)
+{
+    if (numSamples <= 0 || sampleRateHz <= 0.0)
+        return;
+
+    if (ecgSampleRate.exchange(sampleRateHz) != sampleRateHz)
+        discontinuity = true;
+
+    if (discontinuity)
+        ecgBuffer.markDiscontinuity();
+
+    ecgBuffer.write(samplesMicrovolts, numSamples);
+    lastEcgFrameMs.store(receivedMs);
+    notify();
+}
+
+void AnalysisWorker::setSharedRing(const BiometricSharedRing* ring)
+{
+    sharedRing.store(ring);
+    notify();
+}
+
+void AnalysisWorker::requestReset()
+{
+    resetRequested.store(true);
+    notify();
+}
+
+AnalysisWorker::RespirationState AnalysisWorker::getRespirationState() const
+{
+    const juce::SpinLock::ScopedLockType lock(respirationLock);
+    return respirationState;
+}
+
+AnalysisWorker::EcgState AnalysisWorker::getEcgState() const
+{
+    EcgState state;
+    {
+        const juce::SpinLock::ScopedLockType lock(ecgLock);
+        state = ecgState;
+    }
+
+    state.droppedSamples = ecgBuffer.getDroppedSampleCount();
+    state.active = state.beatCount > 0
+                   && juce::Time::getMillisecondCounterHiRes() - state.lastBeatMs < ecgActiveTimeoutMs;
+    return state;
+}
+
+void AnalysisWorker::run()
+{
+    while (! threadShouldExit())
+    {
+        wait(250);
+
+        if (resetRequested.exchange(false))
+        {
+            const auto discarded = intervalFifo.read(intervalFifo.getNumReady());
+            juce::ignoreUnused(discarded);
+            respiration.reset();
+            beatClockAligned = false;
+            rrHistoryGap = true;
+            rrSpectrogram.restart();
+            spectrogramGridSamples = 0;
+
+            ecgBuffer.discardPending();
+            ecgDetectorRate = 0.0;
+            ecgRecentRrCount = 0;
+
+            {
+                const juce::SpinLock::ScopedLockType lock(respirationLock);
+                respirationState = {};
+            }
+
+            const juce::SpinLock::ScopedLockType lock(ecgLock);
+            ecgState = {};
+        }
+
+        respirationUpdated = false;
+        processPendingEcg();
+        processPendingIntervals();
+        processSharedRing();
+
+        if (respirationUpdated)
+            publishRespiration(beatClockOffsetMs);
+    }
+}
+
+void AnalysisWorker::processPendingIntervals()
+{
+    const auto scope = intervalFifo.read(intervalFifo.getNumReady());
+
+    // Sensor RR intervals are only used while no ECG beats are available
+    if (isEcgDriving())
+        return;
+
+    for (int i = 0; i < scope.blockSize1; ++i)
+    {
+        const auto& interval = intervals[(size_t)(scope.startIndex1 + i)];
+        addBeatInterval(interval.rrMs, interval.receivedMs);
+    }
+
+    for (int i = 0; i < scope.blockSize2; ++i)
+    {
+        const auto& interval = intervals[(size_t)(scope.startIndex2 + i)];
+        addBeatInterval(interval.rrMs, interval.receivedMs);
+    }
+}
+
+void AnalysisWorker::processSharedRing()
+{
+    const auto* ring = sharedRing.load();
+    if (ring != workerRing)
+    {
+        workerRing = ring;
+        if (ring != nullptr)
+            workerRingCursor = ring->makeCursor();
+    }
+
+    if (ring == nullptr)
+        return;
+
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    const double nowSeconds = BiometricSharedRing::now();
+    const bool ecgDriving = isEcgDriving();
+
+    BiometricSharedRing::Record record;
+    for (uint32_t i = 0; i < ring->getCapacity(); ++i)
+    {
+        const auto result = ring->read(workerRingCursor, record);
+        if (result == BiometricSharedRing::ReadResult::Empty)
+            break;
+
+        if (result != BiometricSharedRing::ReadResult::Record || ecgDriving)
+            continue;
+
+        // Records carry their write time, so the beat clock does not see the polling delay
+        const double receivedMs = nowMs - juce::jmax(0.0, nowSeconds - record.timestampSeconds) * 1000.0;
+        for (int i = 0; i < record.numRrIntervals; ++i)
+            addBeatInterval(record.rrIntervalsMs[(size_t)i], receivedMs);
+    }
+}
+
+void AnalysisWorker::processPendingEcg()
+{
+    for (;;)
+    {
+        bool discontinuity = false;
+        const int numRead = ecgBuffer.read(ecgChunk.data(), ECG_CHUNK_SIZE, discontinuity);
+
+        const double rate = ecgSampleRate.load();
+        if (discontinuity || rate != ecgDetectorRate)
+        {
+            rPeakDetector.prepare(rate > 0.0 ? rate : rPeakDetector.getSampleRate());
+            ecgDetectorRate = rate;
+            ecgSamplesConsumed = 0;
+            ecgRecentRrCount = 0;
+            rrHistoryGap = true;
+        }
+
+        if (numRead == 0)
+            break;
+
+        ecgSamplesConsumed += (uint64_t)numRead;
+        rPeakDetector.process(ecgChunk.data(), numRead);
+    }
+}
+
+void AnalysisWorker::handleEcgBeat(const RPeakDetector::Beat& beat)
+{
+    // Place the beat on the host clock relative to the newest consumed sample
+    const double consumedSeconds = (double)ecgSamplesConsumed / rPeakDetector.getSampleRate();
+    const double beatMs = lastEcgFrameMs.load() - (consumedSeconds - beat.timeSeconds) * 1000.0;
+
+    EcgState state;
+    {
+        const juce::SpinLock::ScopedLockType lock(ecgLock);
+        state = ecgState;
+    }
+
+    ++state.beatCount;
+    state.lastBeatMs = beatMs;
+
+    if (beat.rrMs > 0.0)
+    {
+        ecgRecentRr[(size_t)ecgRecentRrPosition] = beat.rrMs;
+        ecgRecentRrPosition = (ecgRecentRrPosition + 1) % ECG_RR_AVERAGE_COUNT;
+        ecgRecentRrCount = juce::jmin(ecgRecentRrCount + 1, ECG_RR_AVERAGE_COUNT);
+
+        double sum = 0.0;
+        for (int i = 0; i < ecgRecentRrCount; ++i)
+            sum += ecgRecentRr[(size_t)i];
+        state.heartRate = (float)(60000.0 * ecgRecentRrCount / sum);
+
+        addBeatInterval((float)beat.rrMs, beatMs);
+    }
+
+    const juce::SpinLock::ScopedLockType lock(ecgLock);
+    ecgState = state;
+}
+
+void AnalysisWorker::addBeatInterval(float rrMs, double beatMs)
+{
+    rrHistory.push({ rrMs, beatMs, rrHistoryGap });
+    rrHistoryGap = false;
+
+    if (respiration.addInterval(rrMs))
+    {
+        respirationUpdated = true;
+
+        // A beat yields at most a few grid samples, far fewer than the estimator keeps
+        const long long produced = respiration.getNumGridSamples();
+        for (; spectrogramGridSamples < produced; ++spectrogramGridSamples)
+            rrSpectrogram.addSample(respiration.getGridSample(spectrogramGridSamples));
+    }
+
+    // Map the beat clock onto the host clock; the last beat of a
+    // notification arrives with that notification
+    const double offset = beatMs - respiration.getBeatTime() * 1000.0;
+    if (! beatClockAligned || std::abs(offset - beatClockOffsetMs) > beatClockRealignMs)
+    {
+        beatClockOffsetMs = offset;
+        beatClockAligned = true;
+    }
+    else
+    {
+        beatClockOffsetMs += beatClockSmoothing * (offset - beatClockOffsetMs);
+    }
+}
+
+bool AnalysisWorker::isEcgDriving() const
+{
+    return getEcgState().active;
+}
+
+void AnalysisWorker::publishRespiration(double offsetMs)
+{
+    const auto& estimate = respiration.getEstimate();
+
+    RespirationState state;
+    state.breathsPerMinute = estimate.breathsPerMinute;
+    state.confidence = estimate.confidence;
+    state.phaseCycles = estimate.phaseCycles;
+    state.referenceMs = estimate.referenceTime * 1000.0 + offsetMs;
+    state.valid = estimate.valid;
+
+    const juce::SpinLock::ScopedLockType lock(respirationLock);
+    respirationState = state;
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include "RespirationEstimator.h"
+#include "EcgRingBuffer.h"
+#include "RPeakDetector.h"
+#include "BiometricSharedRing.h"
+#include "RrHistory.h"
+#include "RrSpectrogram.h"
+
+/**
+ * @brief Background thread for the heavier biometric analysis.
+ *
+ * Beat-level data (RR intervals) is queued from the message thread through a
+ * lock-free FIFO (or read straight from the bridge's shared-memory ring when
+ * one is attached), raw ECG from the socket thread through an SPSC ring, and
+ * both are processed here, so neither the message thread nor the audio
+ * thread pays for the analysis. While ECG beats are flowing they replace the
+ * sensor's own RR intervals, which are coarser (1/1024 s) and batched. Results are published as small
+ * snapshots that the audio thread can read without blocking for long, and
+ * as wait-free histories (RR intervals, spectrogram columns) for the editor.
+ *
+ * Work per wake-up is bounded by the FIFO size, and each analysis stage has a
+ * fixed cost per input sample, so one worker per plugin instance can run
+ * continuously.
+ */
+class AnalysisWorker : private juce::Thread
+{
+public:
+    struct RespirationState
+    {
+        float breathsPerMinute{0.0f};
+        float confidence{0.0f};
+        double phaseCycles{0.0};   // breath phase at referenceMs (0 = heart-rate peak)
+        double referenceMs{0.0};   // juce::Time::getMillisecondCounterHiRes() clock
+        bool valid{false};
+
+        /** Breath phase extrapolated to nowMs, in [0, 1). */
+        float getPhaseAt(double nowMs) const;
+    };
+
+    AnalysisWorker();
+    ~AnalysisWorker() override;
+
+    struct EcgState
+    {
+        float heartRate{0.0f};     // from the mean of the last few R-R intervals
+        double lastBeatMs{0.0};    // host clock
+        uint64_t beatCount{0};
+        uint64_t droppedSamples{0};
+        bool active{false};        // beats detected recently
+    };
+
+    void start();
+    void stop();
+
+    /** Producer side (message thread): queue RR intervals received at receivedMs. */
+    void pushRRIntervals(const juce::Array<float>& rrIntervalsMs, double receivedMs);
+
+    /**
+     * Producer side (socket thread): queue raw ECG samples in microvolts.
+     * discontinuity marks a gap before these samples (lost frames).
+     */
+    void pushEcgSamples(const float* samplesMicrovolts, int numSamples, double sampleRateHz,
+                        bool discontinuity, double receivedMs);
+
+    /**
+     * Reads RR intervals from the bridge's shared-memory ring instead of
+     * pushRRIntervals(); nullptr goes back to the FIFO. Any thread.
+     */
+    void setSharedRing(const BiometricSharedRing* ring);
+
+    /** Discards all analysis state, e.g. when the sensor changes. Any thread. */
+    void requestReset();
+
+    RespirationState getRespirationState() const;
+    EcgState getEcgState() const;
+
+    /** Every interval the analysis used, sensor or ECG; wait-free, any thread. */
+    void readRrHistory(RrHistory::Snapshot& snapshot, uint64_t sinceVersion = 0) const { rrHistory.read(snapshot, sinceVersion); }
+    uint64_t getRrHistoryVersion() const { return rrHistory.getVersion(); }
+
+    /** Spectrogram columns of the tachogram, computed here; wait-free, any thread. */
+    void readRrSpectrogram(RrSpectrogram::Snapshot& snapshot, uint64_t sinceVersion = 0) const { rrSpectrogram.read(snapshot, sinceVersion); }
+    uint64_t getRrSpectrogramVersion() const { return rrSpectrogram.getVersion(); }
+
+private:
+    void run() override;
+    void processPendingIntervals();
+    void processSharedRing();
+    void processPendingEcg();
+    void handleEcgBeat(const RPeakDetector::Beat& beat);
+    void addBeatInterval(float rrMs, double beatMs);
+    bool isEcgDriving() const;
+    void publishRespiration(double offsetMs);
+
+    struct Interval
+    {
+        float rrMs{0.0f};
+        double receivedMs{0.0};
+    };
+
+    static constexpr int FIFO_CAPACITY = 256;
+    juce::AbstractFifo intervalFifo{FIFO_CAPACITY};
+    std::array<Interval, FIFO_CAPACITY> intervals{};
+    std::atomic<bool> resetRequested{false};
+
+    std::atomic<const BiometricSharedRing*> sharedRing{nullptr};
+    const BiometricSharedRing* workerRing{nullptr};
+    BiometricSharedRing::Cursor workerRingCursor;
+
+    static constexpr int ECG_CHUNK_SIZE = 512;
+    static constexpr int ECG_RR_AVERAGE_COUNT = 4;
+    EcgRingBuffer ecgBuffer;
+    std::atomic<double> ecgSampleRate{0.0};
+    std::atomic<double> lastEcgFrameMs{0.0};
+
+    // Worker-thread state
+    RespirationEstimator respiration;
+    double beatClockOffsetMs{0.0};
+    bool beatClockAligned{false};
+    bool respirationUpdated{false};
+    bool rrHistoryGap{true};          // the next beat does not follow the last one recorded
+
+    RrHistory rrHistory;
+    RrSpectrogram rrSpectrogram;
+    long long spectrogramGridSamples{0};   // respiration grid samples already passed on
+
+    RPeakDetector rPeakDetector;
+    std::array<float, ECG_CHUNK_SIZE> ecgChunk{};
+    double ecgDetectorRate{0.0};
+    uint64_t ecgSamplesConsumed{0};   // since the detector was last prepared
+    std::array<double, ECG_RR_AVERAGE_COUNT> ecgRecentRr{};
+    int ecgRecentRrCount{0};
+    int ecgRecentRrPosition{0};
+
+    mutable juce::SpinLock respirationLock;
+    RespirationState respirationState;
+
+    mutable juce::SpinLock ecgLock;
+    EcgState ecgState;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalysisWorker)
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "SeqlockRing.h"
+
+/**
+ * @brief Versioned history of the processor's biometric outputs.
+ *
+ * Each entry holds raw HR, smoothed HR, wet/dry and a timestamp, so every
+ * series in a snapshot lines up. The processor records valid readings at a
+ * fixed 10 Hz rather than per audio block. Single writer (the audio
+ * thread); readers are wait-free (see SeqlockRing).
+ */
+class BiometricHistory
+{
+public:
+    struct Entry
+    {
+        float rawHeartRate{0.0f};
+        float smoothedHeartRate{0.0f};
+        float wetDryRatio{50.0f};
+        double timestampMs{0.0};      // juce::Time::getMillisecondCounterHiRes() timebase
+    };
+
+    static constexpr size_t CAPACITY = 256;   // 25.6 s at the processor's 10 Hz
+
+    using Ring = SeqlockRing<Entry, CAPACITY>;
+    using Snapshot = Ring::Snapshot;
+
+    /** Writer only. */
+    void push(const Entry& entry) { ring.publish(entry); }
+
+    uint64_t getVersion() const { return ring.getVersion(); }
+
+    /** Entries newer than sinceVersion (0 for everything still held); reuse one Snapshot to avoid allocating. */
+    void read(Snapshot& snapshot, uint64_t sinceVersion = 0) const { ring.read(snapshot, sinceVersion); }
+
+private:
+    Ring ring;
+};
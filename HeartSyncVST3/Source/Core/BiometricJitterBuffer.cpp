@@ -0,0 +1,193 @@
+#include "BiometricJitterBuffer.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Fritsch–Butland tangent: weighted harmonic mean of the neighbouring
+    // secants, zero at local extrema, so the interpolant never overshoots.
+    double monotoneTangent(double slopeBefore, double slopeAfter, double spanBefore, double spanAfter)
+    {
+        if (slopeBefore * slopeAfter <= 0.0)
+            return 0.0;
+
+        const double weightBefore = (2.0 * spanAfter + spanBefore) / slopeBefore;
+        const double weightAfter = (spanAfter + 2.0 * spanBefore) / slopeAfter;
+        return 3.0 * (spanBefore + spanAfter) / (weightBefore + weightAfter);
+    }
+}
+
+void BiometricJitterBuffer::setPlayoutLatencyMs(double latencyMs)
+{
+    playoutLatencyMs.store(std::max(0.0, latencyMs), std::memory_order_relaxed);
+}
+
+bool BiometricJitterBuffer::push(double timestampMs, float value)
+{
+    const auto write = fifoWrite.load(std::memory_order_relaxed);
+    const auto read = fifoRead.load(std::memory_order_acquire);
+
+    if (write - read >= FIFO_CAPACITY)
+    {
+        overruns.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    fifo[write & (FIFO_CAPACITY - 1)] = { timestampMs, value };
+    fifoWrite.store(write + 1, std::memory_order_release);
+    samplesReceived.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool BiometricJitterBuffer::read(double nowMs, float& value)
+{
+    if (resetRequested.exchange(false, std::memory_order_acq_rel))
+        discardConsumerState();
+
+    drainIncoming();
+
+    if (historyCount == 0)
+        return false;
+
+    double playoutTime = nowMs - playoutLatencyMs.load(std::memory_order_relaxed);
+
+    if (! primed)
+    {
+        if (playoutTime < history[0].timeMs)
+            return false;
+
+        primed = true;
+        lastPlayoutTime = playoutTime;
+    }
+
+    // The playout clock never runs backwards, even if the latency is reduced
+    playoutTime = std::max(playoutTime, lastPlayoutTime);
+    lastPlayoutTime = playoutTime;
+
+    // Keep exactly one sample behind the active segment for the tangent estimate
+    int drop = 0;
+    while (historyCount - drop >= 3 && history[(size_t)drop + 2].timeMs <= playoutTime)
+        ++drop;
+
+    if (drop > 0)
+    {
+        std::copy(history.begin() + drop, history.begin() + historyCount, history.begin());
+        historyCount -= drop;
+    }
+
+    const auto& newest = history[(size_t)historyCount - 1];
+    if (playoutTime >= newest.timeMs)
+    {
+        if (! inUnderrun)
+        {
+            inUnderrun = true;
+            underruns.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        value = newest.value;
+        return true;
+    }
+
+    inUnderrun = false;
+
+    int segment = 0;
+    while (segment + 1 < historyCount && history[(size_t)segment + 1].timeMs <= playoutTime)
+        ++segment;
+
+    value = interpolate(segment, playoutTime);
+    return true;
+}
+
+BiometricJitterBuffer::Stats BiometricJitterBuffer::getStats() const
+{
+    Stats stats;
+    stats.samplesReceived = samplesReceived.load(std::memory_order_relaxed);
+    stats.underruns = underruns.load(std::memory_order_relaxed);
+    stats.overruns = overruns.load(std::memory_order_relaxed);
+    stats.lateSamples = lateSamples.load(std::memory_order_relaxed);
+    stats.playoutLatencyMs = playoutLatencyMs.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void BiometricJitterBuffer::drainIncoming()
+{
+    auto read = fifoRead.load(std::memory_order_relaxed);
+    const auto write = fifoWrite.load(std::memory_order_acquire);
+
+    while (read != write)
+    {
+        appendToHistory(fifo[read & (FIFO_CAPACITY - 1)]);
+        ++read;
+    }
+
+    fifoRead.store(read, std::memory_order_release);
+}
+
+void BiometricJitterBuffer::appendToHistory(const Sample& sample)
+{
+    if (historyCount > 0 && sample.timeMs <= history[(size_t)historyCount - 1].timeMs)
+    {
+        lateSamples.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    if (historyCount == HISTORY_CAPACITY)
+    {
+        // Latency is longer than the history can span; skip ahead
+        std::copy(history.begin() + 1, history.end(), history.begin());
+        --historyCount;
+        overruns.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    history[(size_t)historyCount++] = sample;
+}
+
+float BiometricJitterBuffer::interpolate(int segment, double playoutTime) const
+{
+    const auto& p1 = history[(size_t)segment];
+    const auto& p2 = history[(size_t)segment + 1];
+    const bool hasBefore = segment > 0;
+    const bool hasAfter = segment + 2 < historyCount;
+
+    const double span = p2.timeMs - p1.timeMs;
+    const double slope = (p2.value - p1.value) / span;
+
+    double spanBefore = span, slopeBefore = slope;
+    if (hasBefore)
+    {
+        const auto& p0 = history[(size_t)segment - 1];
+        spanBefore = p1.timeMs - p0.timeMs;
+        slopeBefore = (p1.value - p0.value) / spanBefore;
+    }
+
+    double spanAfter = span, slopeAfter = slope;
+    if (hasAfter)
+    {
+        const auto& p3 = history[(size_t)segment + 2];
+        spanAfter = p3.timeMs - p2.timeMs;
+        slopeAfter = (p3.value - p2.value) / spanAfter;
+    }
+
+    const double m1 = monotoneTangent(slopeBefore, slope, spanBefore, span);
+    const double m2 = monotoneTangent(slope, slopeAfter, span, spanAfter);
+
+    const double s = (playoutTime - p1.timeMs) / span;
+    const double s2 = s * s;
+    const double s3 = s2 * s;
+
+    const double h00 = 2.0 * s3 - 3.0 * s2 + 1.0;
+    const double h10 = s3 - 2.0 * s2 + s;
+    const double h01 = -2.0 * s3 + 3.0 * s2;
+    const double h11 = s3 - s2;
+
+    return (float)(h00 * p1.value + h10 * span * m1 + h01 * p2.value + h11 * span * m2);
+}
+
+void BiometricJitterBuffer::discardConsumerState()
+{
+    fifoRead.store(fifoWrite.load(std::memory_order_acquire), std::memory_order_release);
+    historyCount = 0;
+    lastPlayoutTime = 0.0;
+    primed = false;
+    inUnderrun = false;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Timestamped playout buffer for the biometric control stream.
+ *
+ * Heart-rate samples arrive from the bridge at irregular intervals (socket
+ * and message-thread stalls bunch them up). The buffer delays the stream by a
+ * fixed playout latency and reconstructs a continuous control signal with a
+ * monotone cubic Hermite interpolant, so the audio thread sees smooth
+ * modulation instead of steps.
+ *
+ * Threading: push() is called from a single producer thread, read() from a
+ * single consumer thread (the processor does both on the audio thread).
+ * Neither side locks or allocates.
+ */
+class BiometricJitterBuffer
+{
+public:
+    struct Stats
+    {
+        uint64_t samplesReceived{0};
+        uint64_t underruns{0};      // playout ran past the newest sample
+        uint64_t overruns{0};       // samples dropped because the buffer was full
+        uint64_t lateSamples{0};    // samples older than the current playout point
+        double playoutLatencyMs{0.0};
+    };
+
+    BiometricJitterBuffer() = default;
+
+    /** Playout latency in milliseconds; safe to call from the consumer thread. */
+    void setPlayoutLatencyMs(double latencyMs);
+    double getPlayoutLatencyMs() const { return playoutLatencyMs.load(std::memory_order_relaxed); }
+
+    /** Producer side: queue a sample stamped with its arrival time. */
+    bool push(double timestampMs, float value);
+
+    /**
+     * Consumer side: evaluate the interpolated signal at (nowMs - latency).
+     * Returns false until the playout clock has reached the first sample.
+     */
+    bool read(double nowMs, float& value);
+
+    /** Requests that the consumer discard all state on its next read(). */
+    void requestReset() { resetRequested.store(true, std::memory_order_release); }
+
+    Stats getStats() const;
+
+private:
+    struct Sample
+    {
+        double timeMs{0.0};
+        float value{0.0f};
+    };
+
+    static constexpr uint32_t FIFO_CAPACITY = 64;   // power of two
+    static constexpr int HISTORY_CAPACITY = 32;
+
+    void drainIncoming();
+    void appendToHistory(const Sample& sample);
+    float interpolate(int segment, double playoutTime) const;
+    void discardConsumerState();
+
+    // Producer -> consumer SPSC queue
+    std::array<Sample, FIFO_CAPACITY> fifo{};
+    std::atomic<uint32_t> fifoWrite{0};
+    std::atomic<uint32_t> fifoRead{0};
+
+    // Consumer-owned, time-ordered history around the playout point
+    std::array<Sample, HISTORY_CAPACITY> history{};
+    int historyCount{0};
+    double lastPlayoutTime{0.0};
+    bool primed{false};
+    bool inUnderrun{false};
+
+    std::atomic<double> playoutLatencyMs{1200.0};
+    std::atomic<bool> resetRequested{false};
+
+    std::atomic<uint64_t> samplesReceived{0};
+    std::atomic<uint64_t> underruns{0};
+    std::atomic<uint64_t> overruns{0};
+    std::atomic<uint64_t> lateSamples{0};
+};
@@ -0,0 +1,288 @@
+#include "BiometricSharedRing.h"
+
+#include <chrono>
+#include <cstring>
+#include <new>
+
+#if defined(__APPLE__) || defined(__unix__)
+ #include <sys/mman.h>
+ #include <sys/stat.h>
+ #include <fcntl.h>
+ #include <unistd.h>
+ #include <cerrno>
+ #define HEARTSYNC_HAS_POSIX_SHM 1
+#else
+ #define HEARTSYNC_HAS_POSIX_SHM 0
+#endif
+
+namespace
+{
+    uint32_t roundUpToPowerOfTwo(uint32_t value)
+    {
+        uint32_t result = 16;
+        while (result < value && result < (1u << 20))
+            result <<= 1;
+        return result;
+    }
+
+    uint64_t floatBits(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    float bitsToFloat(uint64_t bits)
+    {
+        const uint32_t narrow = (uint32_t)bits;
+        float value;
+        std::memcpy(&value, &narrow, sizeof(value));
+        return value;
+    }
+}
+
+//==============================================================================
+BiometricSharedRing::BiometricSharedRing(std::string nameToUse, void* mapping, size_t size, bool isOwner)
+    : name(std::move(nameToUse)),
+      header(static_cast<Header*>(mapping)),
+      mappingSize(size),
+      capacity(header->capacity),
+      mask((uint64_t)header->capacity - 1),
+      owner(isOwner)
+{
+}
+
+BiometricSharedRing::~BiometricSharedRing()
+{
+#if HEARTSYNC_HAS_POSIX_SHM
+    ::munmap(header, mappingSize);
+
+    if (owner)
+        ::shm_unlink(name.c_str());
+#endif
+}
+
+size_t BiometricSharedRing::getMappingSize(uint32_t slotCount)
+{
+    return sizeof(Header) + (size_t)slotCount * sizeof(Slot);
+}
+
+BiometricSharedRing::Slot& BiometricSharedRing::slotFor(uint64_t index) const
+{
+    auto* slots = reinterpret_cast<Slot*>(reinterpret_cast<char*>(header) + sizeof(Header));
+    return slots[index & mask];
+}
+
+double BiometricSharedRing::now()
+{
+    const auto sinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration<double>(sinceEpoch).count();
+}
+
+#if HEARTSYNC_HAS_POSIX_SHM
+
+std::unique_ptr<BiometricSharedRing> BiometricSharedRing::create(const std::string& name, uint32_t requestedCapacity, std::string& error)
+{
+    const uint32_t slotCount = roundUpToPowerOfTwo(requestedCapacity);
+    const size_t size = getMappingSize(slotCount);
+
+    // A stale object from a crashed writer would keep old readers attached to dead data
+    ::shm_unlink(name.c_str());
+
+    const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+    {
+        error = "shm_open(" + name + "): " + std::strerror(errno);
+        return nullptr;
+    }
+
+    if (::ftruncate(fd, (off_t)size) != 0)
+    {
+        error = "ftruncate: " + std::string(std::strerror(errno));
+        ::close(fd);
+        ::shm_unlink(name.c_str());
+        return nullptr;
+    }
+
+    void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (mapping == MAP_FAILED)
+    {
+        error = "mmap: " + std::string(std::strerror(errno));
+        ::shm_unlink(name.c_str());
+        return nullptr;
+    }
+
+    auto* header = new (mapping) Header();
+    header->capacity = slotCount;
+    header->slotSize = (uint32_t)sizeof(Slot);
+    header->layoutVersion = LAYOUT_VERSION;
+    header->writeIndex.store(0, std::memory_order_relaxed);
+
+    auto* slots = reinterpret_cast<Slot*>(static_cast<char*>(mapping) + sizeof(Header));
+    for (uint32_t i = 0; i < slotCount; ++i)
+    {
+        auto* slot = new (slots + i) Slot();
+        slot->sequence.store(0, std::memory_order_relaxed);
+        for (auto& word : slot->words)
+            word.store(0, std::memory_order_relaxed);
+    }
+
+    // Readers validate the magic last, so it is published after everything else
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = MAGIC;
+
+    return std::unique_ptr<BiometricSharedRing>(new BiometricSharedRing(name, mapping, size, true));
+}
+
+std::unique_ptr<BiometricSharedRing> BiometricSharedRing::open(const std::string& name, std::string& error)
+{
+    const int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+    {
+        error = "shm_open(" + name + "): " + std::strerror(errno);
+        return nullptr;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(Header))
+    {
+        error = "shared ring " + name + " is too small";
+        ::close(fd);
+        return nullptr;
+    }
+
+    const size_t size = (size_t)info.st_size;
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (mapping == MAP_FAILED)
+    {
+        error = "mmap: " + std::string(std::strerror(errno));
+        return nullptr;
+    }
+
+    const auto* header = static_cast<const Header*>(mapping);
+    const uint32_t slotCount = header->capacity;
+
+    if (header->magic != MAGIC || header->layoutVersion != LAYOUT_VERSION
+        || header->slotSize != sizeof(Slot) || slotCount == 0 || (slotCount & (slotCount - 1)) != 0
+        || size < getMappingSize(slotCount))
+    {
+        error = "shared ring " + name + " has an incompatible layout";
+        ::munmap(mapping, size);
+        return nullptr;
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return std::unique_ptr<BiometricSharedRing>(new BiometricSharedRing(name, mapping, size, false));
+}
+
+#else
+
+std::unique_ptr<BiometricSharedRing> BiometricSharedRing::create(const std::string&, uint32_t, std::string& error)
+{
+    error = "shared memory is not supported on this platform";
+    return nullptr;
+}
+
+std::unique_ptr<BiometricSharedRing> BiometricSharedRing::open(const std::string&, std::string& error)
+{
+    error = "shared memory is not supported on this platform";
+    return nullptr;
+}
+
+#endif
+
+//==============================================================================
+void BiometricSharedRing::write(const Record& record)
+{
+    const uint64_t index = header->writeIndex.load(std::memory_order_relaxed);
+    Slot& slot = slotFor(index);
+
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const int numRr = record.numRrIntervals < 0 ? 0
+                    : (record.numRrIntervals > MAX_RR_PER_RECORD ? MAX_RR_PER_RECORD : record.numRrIntervals);
+
+    uint64_t timestampBits;
+    std::memcpy(&timestampBits, &record.timestampSeconds, sizeof(timestampBits));
+
+    slot.words[0].store(timestampBits, std::memory_order_relaxed);
+    slot.words[1].store((uint64_t)record.sequence | (floatBits(record.bpm) << 32), std::memory_order_relaxed);
+    slot.words[2].store((uint64_t)record.type | ((uint64_t)numRr << 8), std::memory_order_relaxed);
+
+    for (int i = 0; i < MAX_RR_PER_RECORD / 2; ++i)
+    {
+        const float low = i * 2 < numRr ? record.rrIntervalsMs[(size_t)(i * 2)] : 0.0f;
+        const float high = i * 2 + 1 < numRr ? record.rrIntervalsMs[(size_t)(i * 2 + 1)] : 0.0f;
+        slot.words[3 + i].store(floatBits(low) | (floatBits(high) << 32), std::memory_order_relaxed);
+    }
+
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+    header->writeIndex.store(index + 1, std::memory_order_release);
+}
+
+BiometricSharedRing::Cursor BiometricSharedRing::makeCursor() const
+{
+    Cursor cursor;
+    cursor.next = header->writeIndex.load(std::memory_order_acquire);
+    return cursor;
+}
+
+BiometricSharedRing::ReadResult BiometricSharedRing::read(Cursor& cursor, Record& record) const
+{
+    const uint64_t published = header->writeIndex.load(std::memory_order_acquire);
+    if (cursor.next >= published)
+        return ReadResult::Empty;
+
+    if (published - cursor.next > capacity)
+    {
+        // The slot at published - capacity may be the one being rewritten now
+        cursor.next = published - capacity + 1;
+        ++cursor.overruns;
+        return ReadResult::Overrun;
+    }
+
+    const Slot& slot = slotFor(cursor.next);
+    const uint64_t expected = 2 * cursor.next + 2;
+
+    const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+
+    uint64_t words[PAYLOAD_WORDS];
+    for (int i = 0; i < PAYLOAD_WORDS; ++i)
+        words[i] = slot.words[i].load(std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t after = slot.sequence.load(std::memory_order_relaxed);
+
+    if (before != expected || after != expected)
+    {
+        // The writer has wrapped onto this slot; the oldest record that can
+        // still be intact is one full lap behind the writer
+        const uint64_t latest = header->writeIndex.load(std::memory_order_acquire);
+        const uint64_t oldest = latest > capacity ? latest - capacity + 1 : 0;
+        cursor.next = oldest > cursor.next ? oldest : cursor.next + 1;
+        ++cursor.overruns;
+        return ReadResult::Overrun;
+    }
+
+    std::memcpy(&record.timestampSeconds, &words[0], sizeof(record.timestampSeconds));
+    record.sequence = (uint32_t)words[1];
+    record.bpm = bitsToFloat(words[1] >> 32);
+    record.type = (RecordType)(uint8_t)words[2];
+    record.numRrIntervals = (int)((words[2] >> 8) & 0xFF);
+    if (record.numRrIntervals > MAX_RR_PER_RECORD)
+        record.numRrIntervals = MAX_RR_PER_RECORD;
+
+    for (int i = 0; i < MAX_RR_PER_RECORD / 2; ++i)
+    {
+        record.rrIntervalsMs[(size_t)(i * 2)] = bitsToFloat(words[3 + i]);
+        record.rrIntervalsMs[(size_t)(i * 2 + 1)] = bitsToFloat(words[3 + i] >> 32);
+    }
+
+    ++cursor.next;
+    return ReadResult::Record;
+}
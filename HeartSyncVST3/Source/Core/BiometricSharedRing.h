@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Shared-memory ring of timestamped biometric records (bridge -> plugins).
+ *
+ * The bridge creates a POSIX shared-memory object and offers its name over
+ * the socket control channel ({"type":"shm_offer",...}, see
+ * HeartSyncBLEClient). Once a client has mapped it, heart-rate and RR records
+ * are delivered through the ring instead of the socket: no syscalls, no
+ * message-thread hop, and any number of plugin instances can map the same
+ * object.
+ *
+ * The ring has one writer and any number of readers. Each slot is guarded
+ * by its own sequence counter (a seqlock): the writer marks the slot odd,
+ * stores the record, then publishes an even value derived from the record
+ * index. Readers never block or retry in a loop; a record overwritten while
+ * it was being copied is reported as an overrun and the reader's cursor
+ * skips ahead. read() is therefore wait-free and safe on the audio thread.
+ * Readers keep their own Cursor, so they never write to the mapping (it is
+ * mapped read-only on the client side).
+ *
+ * Record timestamps use std::chrono::steady_clock, which is system-wide on
+ * macOS and Linux, so a reader can work out how long ago a record was
+ * written regardless of when it polls.
+ */
+class BiometricSharedRing
+{
+public:
+    static constexpr uint32_t MAGIC = 0x48535242;     // "HSRB"
+    static constexpr uint32_t LAYOUT_VERSION = 1;
+    static constexpr uint32_t DEFAULT_CAPACITY = 1024;
+    static constexpr int MAX_RR_PER_RECORD = 8;
+
+    enum class RecordType : uint8_t
+    {
+        HeartRate = 1,
+        RrIntervals = 2
+    };
+
+    struct Record
+    {
+        RecordType type{RecordType::HeartRate};
+        uint32_t sequence{0};             // writer's per-stream counter
+        double timestampSeconds{0.0};     // steady_clock at write
+        float bpm{0.0f};                  // 0 for RrIntervals records
+        int numRrIntervals{0};
+        std::array<float, MAX_RR_PER_RECORD> rrIntervalsMs{};
+    };
+
+    enum class ReadResult
+    {
+        Record,     // record filled in
+        Empty,      // nothing new
+        Overrun     // the writer lapped this reader; cursor moved to the oldest intact record
+    };
+
+    /** Per-reader position. Not shared between threads. */
+    struct Cursor
+    {
+        uint64_t next{0};
+        uint64_t overruns{0};
+    };
+
+    ~BiometricSharedRing();
+
+    /**
+     * Writer side: creates (or replaces) the shared-memory object.
+     * capacity is rounded up to a power of two. Returns nullptr and fills
+     * error on failure. The object is unlinked when the writer is destroyed.
+     */
+    static std::unique_ptr<BiometricSharedRing> create(const std::string& name, uint32_t capacity, std::string& error);
+
+    /** Reader side: maps an existing object read-only and validates its layout. */
+    static std::unique_ptr<BiometricSharedRing> open(const std::string& name, std::string& error);
+
+    /** Single writer only. */
+    void write(const Record& record);
+
+    /** A cursor positioned after the newest record (readers skip history). */
+    Cursor makeCursor() const;
+
+    /** Wait-free; any number of readers, each with its own cursor. */
+    ReadResult read(Cursor& cursor, Record& record) const;
+
+    uint32_t getCapacity() const { return capacity; }
+    const std::string& getName() const { return name; }
+
+    /** Current steady_clock time in the records' timebase. */
+    static double now();
+
+private:
+    static constexpr int PAYLOAD_WORDS = 7;
+
+    struct Slot
+    {
+        std::atomic<uint64_t> sequence;
+        std::atomic<uint64_t> words[PAYLOAD_WORDS];
+    };
+
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t layoutVersion;
+        uint32_t capacity;
+        uint32_t slotSize;
+        alignas(64) std::atomic<uint64_t> writeIndex;   // records published so far
+    };                                                  // capacity slots follow the header
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared-memory atomics must be lock-free");
+    static_assert(sizeof(Slot) == 64, "one slot per cache line");
+
+    BiometricSharedRing(std::string name, void* mapping, size_t mappingSize, bool owner);
+
+    static size_t getMappingSize(uint32_t capacity);
+    Slot& slotFor(uint64_t index) const;
+
+    std::string name;
+    Header* header{nullptr};
+    size_t mappingSize{0};
+    uint32_t capacity{0};
+    uint64_t mask{0};
+    bool owner{false};
+};
@@ -0,0 +1,291 @@
+#include "BridgeProtocol.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    using namespace BridgeProtocol;
+
+    uint16_t readU16(const uint8_t* p)
+    {
+        return (uint16_t)(p[0] | (p[1] << 8));
+    }
+
+    uint32_t readU32(const uint8_t* p)
+    {
+        return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+
+    uint64_t readU64(const uint8_t* p)
+    {
+        return (uint64_t)readU32(p) | ((uint64_t)readU32(p + 4) << 32);
+    }
+
+    float readF32(const uint8_t* p)
+    {
+        const uint32_t bits = readU32(p);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    double readF64(const uint8_t* p)
+    {
+        const uint64_t bits = readU64(p);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    void writeU16(std::vector<uint8_t>& out, uint16_t value)
+    {
+        out.push_back((uint8_t)value);
+        out.push_back((uint8_t)(value >> 8));
+    }
+
+    void writeU32(std::vector<uint8_t>& out, uint32_t value)
+    {
+        for (int shift = 0; shift < 32; shift += 8)
+            out.push_back((uint8_t)(value >> shift));
+    }
+
+    void writeF32(std::vector<uint8_t>& out, float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        writeU32(out, bits);
+    }
+
+    void writeF64(std::vector<uint8_t>& out, double value)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        writeU32(out, (uint32_t)bits);
+        writeU32(out, (uint32_t)(bits >> 32));
+    }
+
+    void beginMessage(std::vector<uint8_t>& out, FrameType type, uint32_t sequence, int count, size_t bodySize)
+    {
+        const uint32_t payloadSize = (uint32_t)(HEADER_SIZE + bodySize);
+
+        out.clear();
+        out.reserve(4 + payloadSize);
+
+        // The length prefix keeps the stream's big-endian framing
+        out.push_back((uint8_t)(payloadSize >> 24));
+        out.push_back((uint8_t)(payloadSize >> 16));
+        out.push_back((uint8_t)(payloadSize >> 8));
+        out.push_back((uint8_t)payloadSize);
+
+        out.push_back(FRAME_MAGIC);
+        out.push_back(FRAME_VERSION);
+        out.push_back((uint8_t)type);
+        out.push_back(0);
+        writeU32(out, sequence);
+        writeU16(out, (uint16_t)count);
+        writeU16(out, 0);
+    }
+
+    int clampCount(int count, int maximum)
+    {
+        return std::clamp(count, 0, maximum);
+    }
+}
+
+namespace BridgeProtocol
+{
+    bool isBinaryFrame(const uint8_t* payload, size_t size)
+    {
+        return size > 0 && payload[0] == FRAME_MAGIC;
+    }
+
+    bool decodeHeader(const uint8_t* payload, size_t size, FrameHeader& header)
+    {
+        if (size < HEADER_SIZE || payload[0] != FRAME_MAGIC || payload[1] != FRAME_VERSION)
+            return false;
+
+        header.type = (FrameType)payload[2];
+        header.flags = payload[3];
+        header.sequence = readU32(payload + 4);
+        header.count = readU16(payload + 8);
+        return true;
+    }
+
+    bool decodeHeartRateFrame(const uint8_t* payload, size_t size, HeartRateFrame& frame)
+    {
+        FrameHeader header;
+        if (! decodeHeader(payload, size, header) || header.count > MAX_RR_PER_FRAME)
+            return false;
+
+        const uint8_t* body = payload + HEADER_SIZE;
+        size_t fixedSize = 0;
+
+        if (header.type == FrameType::HeartRate)
+        {
+            fixedSize = 4 + 8;
+            if (size < HEADER_SIZE + fixedSize)
+                return false;
+
+            frame.bpm = readF32(body);
+            frame.bridgeTimestamp = readF64(body + 4);
+        }
+        else if (header.type == FrameType::RrIntervals)
+        {
+            fixedSize = 8;
+            if (size < HEADER_SIZE + fixedSize)
+                return false;
+
+            frame.bpm = 0.0f;
+            frame.bridgeTimestamp = readF64(body);
+        }
+        else
+        {
+            return false;
+        }
+
+        if (size < HEADER_SIZE + fixedSize + (size_t)header.count * 4)
+            return false;
+
+        const uint8_t* rr = body + fixedSize;
+        for (int i = 0; i < (int)header.count; ++i)
+            frame.rrIntervalsMs[(size_t)i] = readF32(rr + (size_t)i * 4);
+
+        frame.sequence = header.sequence;
+        frame.numRrIntervals = header.count;
+        return true;
+    }
+
+    bool decodeHeartbeatFrame(const uint8_t* payload, size_t size, double& bridgeTimestamp)
+    {
+        FrameHeader header;
+        if (! decodeHeader(payload, size, header) || header.type != FrameType::Heartbeat || size < HEADER_SIZE + 8)
+            return false;
+
+        bridgeTimestamp = readF64(payload + HEADER_SIZE);
+        return true;
+    }
+
+    bool decodeEcgFrame(const uint8_t* payload, size_t size, EcgFrame& frame, float* samples, int maxSamples)
+    {
+        FrameHeader header;
+        if (! decodeHeader(payload, size, header) || header.type != FrameType::Ecg)
+            return false;
+
+        const size_t expectedSize = HEADER_SIZE + ECG_BODY_PREFIX_SIZE + (size_t)header.count * 4;
+        if (size < expectedSize || (int)header.count > maxSamples)
+            return false;
+
+        const uint8_t* body = payload + HEADER_SIZE;
+        const uint32_t sampleRateMilliHz = readU32(body);
+        if (sampleRateMilliHz == 0)
+            return false;
+
+        const uint8_t* data = body + ECG_BODY_PREFIX_SIZE;
+        for (int i = 0; i < (int)header.count; ++i)
+            samples[i] = (float)(int32_t)readU32(data + (size_t)i * 4);
+
+        frame.sequence = header.sequence;
+        frame.sampleRateHz = sampleRateMilliHz / 1000.0;
+        frame.numSamples = header.count;
+        return true;
+    }
+
+    void encodeHeartRateFrame(uint32_t sequence, float bpm, double bridgeTimestamp,
+                              const float* rrIntervalsMs, int numRrIntervals,
+                              std::vector<uint8_t>& out)
+    {
+        const int count = clampCount(numRrIntervals, MAX_RR_PER_FRAME);
+        beginMessage(out, FrameType::HeartRate, sequence, count, 12 + (size_t)count * 4);
+        writeF32(out, bpm);
+        writeF64(out, bridgeTimestamp);
+        for (int i = 0; i < count; ++i)
+            writeF32(out, rrIntervalsMs[i]);
+    }
+
+    void encodeRrIntervalsFrame(uint32_t sequence, double bridgeTimestamp,
+                                const float* rrIntervalsMs, int numRrIntervals,
+                                std::vector<uint8_t>& out)
+    {
+        const int count = clampCount(numRrIntervals, MAX_RR_PER_FRAME);
+        beginMessage(out, FrameType::RrIntervals, sequence, count, 8 + (size_t)count * 4);
+        writeF64(out, bridgeTimestamp);
+        for (int i = 0; i < count; ++i)
+            writeF32(out, rrIntervalsMs[i]);
+    }
+
+    void encodeHeartbeatFrame(uint32_t sequence, double bridgeTimestamp, std::vector<uint8_t>& out)
+    {
+        beginMessage(out, FrameType::Heartbeat, sequence, 0, 8);
+        writeF64(out, bridgeTimestamp);
+    }
+
+    void encodeEcgFrame(uint32_t sequence, double sampleRateHz,
+                        const int32_t* samplesMicrovolts, int numSamples,
+                        std::vector<uint8_t>& out)
+    {
+        const int count = clampCount(numSamples, MAX_ECG_SAMPLES);
+        beginMessage(out, FrameType::Ecg, sequence, count, ECG_BODY_PREFIX_SIZE + (size_t)count * 4);
+        writeU32(out, (uint32_t)std::lround(sampleRateHz * 1000.0));
+        for (int i = 0; i < count; ++i)
+            writeU32(out, (uint32_t)samplesMicrovolts[i]);
+    }
+
+    //==============================================================================
+    StreamDecoder::StreamDecoder()
+        : buffer(2 * (4 + MAX_PAYLOAD_SIZE))
+    {
+    }
+
+    void StreamDecoder::reset()
+    {
+        readPosition = 0;
+        writePosition = 0;
+    }
+
+    uint8_t* StreamDecoder::prepareWrite(size_t& available)
+    {
+        // Move the unread tail to the front once it can no longer grow into a full message
+        if (readPosition > 0 && buffer.size() - readPosition < 4 + MAX_PAYLOAD_SIZE)
+        {
+            std::memmove(buffer.data(), buffer.data() + readPosition, writePosition - readPosition);
+            writePosition -= readPosition;
+            readPosition = 0;
+        }
+
+        available = buffer.size() - writePosition;
+        return buffer.data() + writePosition;
+    }
+
+    void StreamDecoder::commitWrite(size_t numBytes)
+    {
+        writePosition = std::min(buffer.size(), writePosition + numBytes);
+    }
+
+    StreamDecoder::Result StreamDecoder::next(const uint8_t*& payload, size_t& size)
+    {
+        const size_t buffered = writePosition - readPosition;
+        if (buffered < 4)
+            return Result::NeedMore;
+
+        const uint8_t* prefix = buffer.data() + readPosition;
+        const uint32_t length = ((uint32_t)prefix[0] << 24) | ((uint32_t)prefix[1] << 16)
+                              | ((uint32_t)prefix[2] << 8) | (uint32_t)prefix[3];
+
+        if (length > MAX_PAYLOAD_SIZE)
+            return Result::Oversized;
+
+        if (buffered < 4 + (size_t)length)
+            return Result::NeedMore;
+
+        payload = prefix + 4;
+        size = length;
+        readPosition += 4 + (size_t)length;
+
+        if (readPosition == writePosition)
+            readPosition = writePosition = 0;
+
+        return Result::Message;
+    }
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Binary frames carried on the bridge socket next to the JSON messages.
+ *
+ * Every bridge message is a 4-byte big-endian length followed by a payload.
+ * JSON payloads always start with '{'; binary payloads start with
+ * FRAME_MAGIC instead, so both kinds share one stream.
+ *
+ * Protocol version 2 is negotiated in the handshake: the client sends
+ * {"type":"handshake","version":2,...} and the bridge answers with "ready"
+ * carrying the version it will speak. At version 2 the hot message types
+ * (heart rate, RR intervals, ECG, heartbeat) are sent as binary frames and
+ * JSON is only used for rare control messages. The client decodes both
+ * forms regardless of the negotiated version.
+ *
+ * Binary payload layout (little-endian, fixed offsets):
+ *   0  magic     u8   FRAME_MAGIC
+ *   1  version   u8   FRAME_VERSION
+ *   2  type      u8   FrameType
+ *   3  flags     u8   reserved, 0
+ *   4  sequence  u32  per-type counter, gaps mean dropped frames
+ *   8  count     u16  number of trailing elements (RR values, samples)
+ *  10  reserved  u16
+ *  12  type-specific body
+ *
+ * Bodies:
+ *   HeartRate   bpm f32, bridge timestamp f64 (s), count x RR f32 (ms)
+ *   RrIntervals bridge timestamp f64 (s), count x RR f32 (ms)
+ *   Ecg         sample rate u32 (milli-Hz), count x i32 samples (microvolts)
+ *   Heartbeat   bridge timestamp f64 (s)
+ *
+ * Decoding never allocates; callers provide the sample storage.
+ */
+namespace BridgeProtocol
+{
+    constexpr int PROTOCOL_VERSION = 2;          // highest version this client speaks
+    constexpr int FIRST_BINARY_VERSION = 2;      // hot messages are binary from this version on
+    constexpr uint8_t FRAME_MAGIC = 0xB5;
+    constexpr uint8_t FRAME_VERSION = 2;
+    constexpr size_t HEADER_SIZE = 12;
+    constexpr size_t MAX_PAYLOAD_SIZE = 65536;
+    constexpr int MAX_RR_PER_FRAME = 32;
+    constexpr size_t ECG_BODY_PREFIX_SIZE = 4;
+    constexpr int MAX_ECG_SAMPLES = (int)((MAX_PAYLOAD_SIZE - HEADER_SIZE - ECG_BODY_PREFIX_SIZE) / 4);
+
+    enum class FrameType : uint8_t
+    {
+        Ecg = 1,
+        HeartRate = 2,
+        RrIntervals = 3,
+        Heartbeat = 4
+    };
+
+    struct FrameHeader
+    {
+        FrameType type{FrameType::Ecg};
+        uint8_t flags{0};
+        uint32_t sequence{0};
+        uint16_t count{0};
+    };
+
+    struct HeartRateFrame
+    {
+        uint32_t sequence{0};
+        float bpm{0.0f};                      // 0 for RrIntervals frames
+        double bridgeTimestamp{0.0};
+        int numRrIntervals{0};
+        std::array<float, MAX_RR_PER_FRAME> rrIntervalsMs{};
+    };
+
+    struct EcgFrame
+    {
+        uint32_t sequence{0};
+        double sampleRateHz{0.0};
+        int numSamples{0};
+    };
+
+    /** True when the payload is a binary frame rather than JSON. */
+    bool isBinaryFrame(const uint8_t* payload, size_t size);
+
+    bool decodeHeader(const uint8_t* payload, size_t size, FrameHeader& header);
+
+    /** Decodes a HeartRate or RrIntervals frame. */
+    bool decodeHeartRateFrame(const uint8_t* payload, size_t size, HeartRateFrame& frame);
+
+    bool decodeHeartbeatFrame(const uint8_t* payload, size_t size, double& bridgeTimestamp);
+
+    /**
+     * Decodes an ECG frame, writing up to maxSamples samples (microvolts) to
+     * samples. Returns false for malformed or truncated frames.
+     */
+    bool decodeEcgFrame(const uint8_t* payload, size_t size, EcgFrame& frame, float* samples, int maxSamples);
+
+    //==============================================================================
+    // Encoders build a complete message (length prefix included) into out.
+    // They are used by the bridge side, tools and benchmarks.
+    void encodeHeartRateFrame(uint32_t sequence, float bpm, double bridgeTimestamp,
+                              const float* rrIntervalsMs, int numRrIntervals,
+                              std::vector<uint8_t>& out);
+
+    void encodeRrIntervalsFrame(uint32_t sequence, double bridgeTimestamp,
+                                const float* rrIntervalsMs, int numRrIntervals,
+                                std::vector<uint8_t>& out);
+
+    void encodeHeartbeatFrame(uint32_t sequence, double bridgeTimestamp, std::vector<uint8_t>& out);
+
+    void encodeEcgFrame(uint32_t sequence, double sampleRateHz,
+                        const int32_t* samplesMicrovolts, int numSamples,
+                        std::vector<uint8_t>& out);
+
+    //==============================================================================
+    /**
+     * Reassembles length-prefixed messages from a byte stream that arrives in
+     * arbitrary pieces (nonblocking reads). Bytes are received straight into
+     * the decoder's buffer, which is allocated once:
+     *
+     *     size_t space;
+     *     auto* dest = decoder.prepareWrite(space);
+     *     decoder.commitWrite(recv(fd, dest, space, 0));
+     *     while (decoder.next(payload, size) == StreamDecoder::Result::Message) ...
+     *
+     * A payload pointer stays valid until the next prepareWrite() or reset().
+     */
+    class StreamDecoder
+    {
+    public:
+        enum class Result
+        {
+            Message,     // payload/size describe one complete message
+            NeedMore,    // wait for more bytes
+            Oversized    // length prefix above MAX_PAYLOAD_SIZE; the stream cannot be resynchronised
+        };
+
+        StreamDecoder();
+
+        void reset();
+        uint8_t* prepareWrite(size_t& available);
+        void commitWrite(size_t numBytes);
+        Result next(const uint8_t*& payload, size_t& size);
+
+    private:
+        std::vector<uint8_t> buffer;
+        size_t readPosition{0};
+        size_t writePosition{0};
+    };
+}
@@ -0,0 +1,490 @@
+#include "BridgeServer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+
+namespace
+{
+#ifdef MSG_NOSIGNAL
+    constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+    constexpr int SEND_FLAGS = 0;      // SO_NOSIGPIPE is set per socket instead
+#endif
+
+    void setNonBlocking(int fd)
+    {
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+
+    int createSocket()
+    {
+       #ifdef SOCK_CLOEXEC
+        return ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+       #else
+        const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);     // macOS has no SOCK_CLOEXEC
+        if (fd >= 0)
+            ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+        return fd;
+       #endif
+    }
+
+    /** Returns 0 once nothing (or only a stale socket, now removed) is left at the path, else an errno. */
+    int clearSocketPath(const sockaddr_un& address)
+    {
+        const int probe = createSocket();
+        if (probe < 0)
+            return errno;
+
+        // Nonblocking, so a live bridge with a full backlog answers EAGAIN instead of stalling start()
+        ::fcntl(probe, F_SETFL, ::fcntl(probe, F_GETFL, 0) | O_NONBLOCK);
+        const int result = ::connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0 ? 0 : errno;
+        ::close(probe);
+
+        if (result == ENOENT)
+            return 0;
+
+        if (result != ECONNREFUSED)
+            return result == 0 ? EADDRINUSE : result;
+
+        // Refused: nobody listens, but only remove the file if it really is a socket
+        struct stat info{};
+        if (::lstat(address.sun_path, &info) == 0 && S_ISSOCK(info.st_mode))
+            ::unlink(address.sun_path);
+
+        return 0;
+    }
+
+    void createParentDirectories(const std::string& socketPath)
+    {
+        for (size_t slash = socketPath.find('/', 1); slash != std::string::npos; slash = socketPath.find('/', slash + 1))
+            ::mkdir(socketPath.substr(0, slash).c_str(), 0700);
+    }
+
+    constexpr uint32_t DEVICE_TYPES = BridgeServer::HeartRate | BridgeServer::RrIntervals | BridgeServer::Ecg
+                                    | BridgeServer::DeviceStatus | BridgeServer::Advertisements;
+}
+
+//==============================================================================
+bool BridgeServer::Subscription::wants(uint32_t type, const std::string& deviceId) const
+{
+    if ((types & type) == 0)
+        return false;
+
+    if ((type & DEVICE_TYPES) == 0 || devices.empty() || deviceId.empty())
+        return true;
+
+    return std::find(devices.begin(), devices.end(), deviceId) != devices.end();
+}
+
+//==============================================================================
+BridgeServer::BridgeServer() = default;
+
+BridgeServer::~BridgeServer()
+{
+    stop();
+}
+
+bool BridgeServer::start(const Options& optionsToUse, std::string& error)
+{
+    stop();
+    options = optionsToUse;
+
+    sockaddr_un address{};
+    if (options.socketPath.empty() || options.socketPath.size() >= sizeof(address.sun_path))
+    {
+        error = "invalid socket path: " + options.socketPath;
+        return false;
+    }
+
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, options.socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    createParentDirectories(options.socketPath);
+
+    if (const int inUse = clearSocketPath(address))
+    {
+        error = inUse == EADDRINUSE || inUse == EAGAIN || inUse == EWOULDBLOCK || inUse == EINPROGRESS
+                    ? "a bridge is already running on " + options.socketPath
+                    : options.socketPath + ": " + std::strerror(inUse);
+        return false;
+    }
+
+    listenFd = createSocket();
+    if (listenFd < 0)
+    {
+        error = "socket(): " + std::string(std::strerror(errno));
+        return false;
+    }
+
+    if (::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || ::listen(listenFd, 16) != 0)
+    {
+        error = "bind " + options.socketPath + ": " + std::strerror(errno);
+        ::close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+
+    struct stat info{};
+    if (::stat(options.socketPath.c_str(), &info) == 0)
+    {
+        boundDevice = (uint64_t)info.st_dev;
+        boundInode = (uint64_t)info.st_ino;
+    }
+
+    setNonBlocking(listenFd);
+    return true;
+}
+
+void BridgeServer::stop()
+{
+    for (auto& client : clients)
+        if (client->fd >= 0)
+            ::close(client->fd);
+
+    clients.clear();
+    stats.clients = 0;
+
+    if (listenFd >= 0)
+    {
+        ::close(listenFd);
+        listenFd = -1;
+
+        // Another bridge may have replaced the file since (its start() found ours stale)
+        struct stat info{};
+        if (::lstat(options.socketPath.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)
+            && (uint64_t)info.st_dev == boundDevice && (uint64_t)info.st_ino == boundInode)
+            ::unlink(options.socketPath.c_str());
+
+        boundDevice = boundInode = 0;
+    }
+}
+
+//==============================================================================
+void BridgeServer::poll(int timeoutMs)
+{
+    if (listenFd < 0)
+        return;
+
+    // Most queues drain without waiting for POLLOUT
+    for (auto& client : clients)
+        if (client->closeReason.empty() && ! client->queue.empty())
+            flushClient(*client);
+
+    reapClients();
+
+    std::vector<pollfd> fds;
+    fds.reserve(clients.size() + 1);
+    fds.push_back({ listenFd, POLLIN, 0 });
+
+    for (const auto& client : clients)
+        fds.push_back({ client->fd, (short)(POLLIN | (client->queue.empty() ? 0 : POLLOUT)), 0 });
+
+    const int ready = ::poll(fds.data(), (nfds_t)fds.size(), timeoutMs);
+    if (ready <= 0)
+        return;
+
+    // Clients accepted below are appended, so fds[i + 1] still matches clients[i]
+    const size_t numPolled = fds.size() - 1;
+
+    if (fds[0].revents & POLLIN)
+        acceptClients();
+
+    for (size_t i = 0; i < numPolled; ++i)
+    {
+        auto& client = *clients[i];
+        const short events = fds[i + 1].revents;
+
+        if (client.closeReason.empty() && (events & (POLLIN | POLLHUP | POLLERR)))
+            readClient(client);
+
+        if (client.closeReason.empty() && (events & POLLOUT))
+            flushClient(client);
+    }
+
+    reapClients();
+}
+
+void BridgeServer::acceptClients()
+{
+    for (;;)
+    {
+        const int fd = ::accept(listenFd, nullptr, nullptr);
+        if (fd < 0)
+            return;
+
+        if ((int)clients.size() >= options.maxClients)
+        {
+            ::close(fd);
+            continue;
+        }
+
+        setNonBlocking(fd);
+#ifdef SO_NOSIGPIPE
+        const int noSigPipe = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+
+        auto client = std::make_unique<Client>();
+        client->id = nextClientId++;
+        client->fd = fd;
+        clients.push_back(std::move(client));
+
+        ++stats.accepted;
+        stats.clients = (int)clients.size();
+
+        if (onClientConnected)
+            onClientConnected(clients.back()->id);
+    }
+}
+
+void BridgeServer::readClient(Client& client)
+{
+    for (;;)
+    {
+        size_t space = 0;
+        auto* dest = client.decoder.prepareWrite(space);
+        const ssize_t n = ::recv(client.fd, dest, space, 0);
+
+        if (n == 0)
+        {
+            client.closeReason = "closed by client";
+            return;
+        }
+
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                client.closeReason = std::string("recv: ") + std::strerror(errno);
+            return;
+        }
+
+        client.decoder.commitWrite((size_t)n);
+
+        const uint8_t* payload = nullptr;
+        size_t size = 0;
+        BridgeProtocol::StreamDecoder::Result result;
+
+        while ((result = client.decoder.next(payload, size)) == BridgeProtocol::StreamDecoder::Result::Message)
+        {
+            if (onMessage)
+                onMessage(client.id, payload, size);
+
+            if (! client.closeReason.empty())
+                return;
+        }
+
+        if (result == BridgeProtocol::StreamDecoder::Result::Oversized)
+        {
+            client.closeReason = "oversized message";
+            return;
+        }
+    }
+}
+
+void BridgeServer::flushClient(Client& client)
+{
+    while (! client.queue.empty())
+    {
+        struct iovec vectors[MAX_WRITE_BATCH];
+        int numVectors = 0;
+
+        for (const auto& frame : client.queue)
+        {
+            if (numVectors == MAX_WRITE_BATCH)
+                break;
+
+            const size_t offset = numVectors == 0 ? client.sendOffset : 0;
+            vectors[numVectors].iov_base = const_cast<uint8_t*>(frame->data()) + offset;
+            vectors[numVectors].iov_len = frame->size() - offset;
+            ++numVectors;
+        }
+
+        struct msghdr message;
+        std::memset(&message, 0, sizeof(message));
+        message.msg_iov = vectors;
+        message.msg_iovlen = numVectors;
+
+        ssize_t written = ::sendmsg(client.fd, &message, SEND_FLAGS);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                client.closeReason = std::string("send: ") + std::strerror(errno);
+            return;
+        }
+
+        stats.bytesSent += (uint64_t)written;
+
+        while (written > 0)
+        {
+            const size_t remaining = client.queue.front()->size() - client.sendOffset;
+            if ((size_t)written < remaining)
+            {
+                client.sendOffset += (size_t)written;
+                break;
+            }
+
+            written -= (ssize_t)remaining;
+            client.queuedBytes -= client.queue.front()->size();
+            client.queue.pop_front();
+            client.sendOffset = 0;
+        }
+    }
+}
+
+bool BridgeServer::enqueue(Client& client, const Frame& frame)
+{
+    if (! client.closeReason.empty())
+        return false;
+
+    if (client.queuedBytes + frame->size() > options.maxQueuedBytes)
+    {
+        // Dropping single frames would leave gaps the client cannot see;
+        // it reconnects and starts from a clean state instead
+        client.closeReason = "slow consumer";
+        ++stats.evicted;
+        return false;
+    }
+
+    client.queue.push_back(frame);
+    client.queuedBytes += frame->size();
+    ++stats.queued;
+    return true;
+}
+
+void BridgeServer::reapClients()
+{
+    for (auto it = clients.begin(); it != clients.end();)
+    {
+        auto& client = **it;
+        if (client.closeReason.empty())
+        {
+            ++it;
+            continue;
+        }
+
+        ::close(client.fd);
+        const ClientId id = client.id;
+        const std::string reason = client.closeReason;
+        it = clients.erase(it);
+        stats.clients = (int)clients.size();
+
+        if (onClientDisconnected)
+            onClientDisconnected(id, reason);
+    }
+}
+
+//==============================================================================
+int BridgeServer::publish(uint32_t type, const std::string& deviceId, const Encoder& encode)
+{
+    ++stats.published;
+
+    Frame encoded[2];
+    bool attempted[2] = { false, false };
+    int recipients = 0;
+
+    for (auto& client : clients)
+    {
+        if (! client->closeReason.empty() || ! client->subscription.wants(type, deviceId))
+            continue;
+
+        const int format = client->format == Format::Binary ? 1 : 0;
+        if (! attempted[format])
+        {
+            attempted[format] = true;
+            encoded[format] = encode(client->format);
+            if (encoded[format] != nullptr)
+                ++stats.encoded;
+        }
+
+        if (encoded[format] != nullptr && enqueue(*client, encoded[format]))
+            ++recipients;
+    }
+
+    return recipients;
+}
+
+bool BridgeServer::send(ClientId id, Frame frame)
+{
+    auto* client = findClient(id);
+    return client != nullptr && frame != nullptr && enqueue(*client, frame);
+}
+
+void BridgeServer::setFormat(ClientId id, Format format)
+{
+    if (auto* client = findClient(id))
+        client->format = format;
+}
+
+void BridgeServer::setSubscription(ClientId id, Subscription subscription)
+{
+    if (auto* client = findClient(id))
+        client->subscription = std::move(subscription);
+}
+
+const BridgeServer::Subscription* BridgeServer::getSubscription(ClientId id) const
+{
+    const auto* client = findClient(id);
+    return client != nullptr ? &client->subscription : nullptr;
+}
+
+void BridgeServer::disconnect(ClientId id, const std::string& reason)
+{
+    if (auto* client = findClient(id))
+        if (client->closeReason.empty())
+            client->closeReason = reason.empty() ? std::string("closed by server") : reason;
+}
+
+BridgeServer::Client* BridgeServer::findClient(ClientId id) const
+{
+    for (const auto& client : clients)
+        if (client->id == id)
+            return client.get();
+
+    return nullptr;
+}
+
+int BridgeServer::getNumClients() const
+{
+    return (int)clients.size();
+}
+
+BridgeServer::Stats BridgeServer::getStats() const
+{
+    return stats;
+}
+
+//==============================================================================
+BridgeServer::Frame BridgeServer::makeFrame(std::vector<uint8_t> bytes)
+{
+    return std::make_shared<const std::vector<uint8_t>>(std::move(bytes));
+}
+
+BridgeServer::Frame BridgeServer::makeJsonFrame(const std::string& json)
+{
+    std::vector<uint8_t> bytes;
+    bytes.reserve(4 + json.size());
+
+    const uint32_t length = (uint32_t)json.size();
+    bytes.push_back((uint8_t)(length >> 24));
+    bytes.push_back((uint8_t)(length >> 16));
+    bytes.push_back((uint8_t)(length >> 8));
+    bytes.push_back((uint8_t)length);
+    bytes.insert(bytes.end(), json.begin(), json.end());
+
+    return makeFrame(std::move(bytes));
+}
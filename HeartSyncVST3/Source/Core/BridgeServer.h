@@ -0,0 +1,161 @@
+#pragma once
+
+#include "BridgeProtocol.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Bridge side of the socket protocol: one listener, many plugin instances.
+ *
+ * Accepts any number of clients on the bridge socket (the legacy bridge kept
+ * a single client handle, so every other plugin instance sat in reconnect
+ * backoff). Incoming messages are reassembled per client and handed to
+ * onMessage; what to answer is up to the owner (see Tools/BridgeSim).
+ *
+ * Outgoing data is fan-out: publish() serialises a message at most once per
+ * wire format (JSON or binary, chosen per client after the handshake) and
+ * queues the same immutable Frame on every client whose Subscription wants
+ * that message type and device. Each client has a bounded send queue; a
+ * client that lets it grow past Options::maxQueuedBytes is a slow consumer
+ * and is evicted rather than allowed to hold memory or delay the others.
+ *
+ * Single-threaded: start(), poll(), publish(), send() and the callbacks all
+ * run on the thread that drives poll(). Sockets are nonblocking; queued
+ * frames go out with one sendmsg() per client per poll() iteration.
+ */
+class BridgeServer
+{
+public:
+    using ClientId = uint32_t;
+
+    /** A complete message (length prefix included), shared by every queue it is on. */
+    using Frame = std::shared_ptr<const std::vector<uint8_t>>;
+
+    enum class Format
+    {
+        Json,      // protocol v1, or clients that did not ask for binary frames
+        Binary     // BridgeProtocol frames for the hot message types
+    };
+
+    enum MessageType : uint32_t
+    {
+        HeartRate      = 1u << 0,
+        RrIntervals    = 1u << 1,
+        Ecg            = 1u << 2,
+        DeviceStatus   = 1u << 3,   // connected / disconnected
+        Advertisements = 1u << 4,   // device_found while scanning
+        Heartbeat      = 1u << 5,
+        Control        = 1u << 6,   // permission, errors
+        AllTypes       = 0xFFFFFFFFu
+    };
+
+    /** Device-specific types (everything except Heartbeat and Control) also pass the device filter. */
+    struct Subscription
+    {
+        uint32_t types{AllTypes};
+        std::vector<std::string> devices;    // empty: every device
+
+        bool wants(uint32_t type, const std::string& deviceId) const;
+    };
+
+    struct Options
+    {
+        std::string socketPath;
+        int maxClients{64};
+        size_t maxQueuedBytes{1u << 20};     // per client
+    };
+
+    struct Stats
+    {
+        uint64_t accepted{0};
+        uint64_t evicted{0};        // slow consumers dropped
+        uint64_t published{0};      // publish() calls
+        uint64_t encoded{0};        // serialisations (at most one per format per publish)
+        uint64_t queued{0};         // frames placed on client queues
+        uint64_t bytesSent{0};
+        int clients{0};
+    };
+
+    BridgeServer();
+    ~BridgeServer();
+
+    BridgeServer(const BridgeServer&) = delete;
+    BridgeServer& operator=(const BridgeServer&) = delete;
+
+    /**
+     * Creates the socket directory (0700) if needed and listens. Fails if
+     * another bridge already answers on the path; a stale socket left by a
+     * crashed one is replaced.
+     */
+    bool start(const Options& options, std::string& error);
+    void stop();
+
+    /** Accepts, reads and writes for up to timeoutMs; callbacks run from here. */
+    void poll(int timeoutMs);
+
+    using Encoder = std::function<Frame(Format)>;
+
+    /**
+     * Queues one message on every subscribed client. encode is called at
+     * most once per format and only if some client needs that format; it
+     * may return nullptr to skip that format. Returns the number of clients
+     * the message was queued for.
+     */
+    int publish(uint32_t type, const std::string& deviceId, const Encoder& encode);
+
+    /** Queues a frame for one client (replies, acknowledgements). */
+    bool send(ClientId client, Frame frame);
+
+    void setFormat(ClientId client, Format format);
+    void setSubscription(ClientId client, Subscription subscription);
+    const Subscription* getSubscription(ClientId client) const;
+
+    /** Closes a client at the end of the current poll(); onClientDisconnected reports reason. */
+    void disconnect(ClientId client, const std::string& reason);
+
+    int getNumClients() const;
+    Stats getStats() const;
+
+    static Frame makeFrame(std::vector<uint8_t> bytes);
+    static Frame makeJsonFrame(const std::string& json);
+
+    std::function<void(ClientId)> onClientConnected;
+    std::function<void(ClientId, const std::string& reason)> onClientDisconnected;
+    std::function<void(ClientId, const uint8_t* payload, size_t size)> onMessage;
+
+    static constexpr int MAX_WRITE_BATCH = 64;
+
+private:
+    struct Client
+    {
+        ClientId id{0};
+        int fd{-1};
+        Format format{Format::Json};
+        Subscription subscription;
+        BridgeProtocol::StreamDecoder decoder;
+        std::deque<Frame> queue;
+        size_t queuedBytes{0};
+        size_t sendOffset{0};                // bytes of queue.front() already written
+        std::string closeReason;             // non-empty: closed at the end of poll()
+    };
+
+    Client* findClient(ClientId id) const;
+    void acceptClients();
+    void readClient(Client& client);
+    void flushClient(Client& client);
+    bool enqueue(Client& client, const Frame& frame);
+    void reapClients();
+
+    Options options;
+    int listenFd{-1};
+    uint64_t boundDevice{0}, boundInode{0};  // the socket file this server created; stop() removes only that
+    ClientId nextClientId{1};
+    std::vector<std::unique_ptr<Client>> clients;
+    Stats stats;
+};
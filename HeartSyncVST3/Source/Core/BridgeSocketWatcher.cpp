@@ -0,0 +1,174 @@
+#include "BridgeSocketWatcher.h"
+
+#include <algorithm>
+
+#if defined(__linux__)
+ #include <sys/inotify.h>
+ #include <sys/stat.h>
+ #include <unistd.h>
+ #define HEARTSYNC_WATCH_INOTIFY 1
+#elif defined(__APPLE__)
+ #include <sys/event.h>
+ #include <sys/stat.h>
+ #include <fcntl.h>
+ #include <unistd.h>
+ #define HEARTSYNC_WATCH_KQUEUE 1
+#endif
+
+// Elsewhere (Windows) the watcher is inert: getFd() stays -1 and the caller keeps polling
+#if HEARTSYNC_WATCH_INOTIFY || HEARTSYNC_WATCH_KQUEUE
+namespace
+{
+    bool isDirectory(const std::string& path)
+    {
+        struct stat info;
+        return ::stat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+    }
+
+    /** The socket's directory, or its nearest existing ancestor. */
+    std::string watchableDirectory(const std::string& socketPath)
+    {
+        std::string directory = socketPath;
+
+        for (;;)
+        {
+            const auto slash = directory.find_last_of('/');
+            if (slash == std::string::npos)
+                return {};
+
+            directory.resize(slash == 0 ? 1 : slash);
+            if (isDirectory(directory))
+                return directory;
+
+            if (directory == "/")
+                return {};
+        }
+    }
+}
+#endif
+
+BridgeSocketWatcher::BridgeSocketWatcher()
+{
+#if HEARTSYNC_WATCH_INOTIFY
+    fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#elif HEARTSYNC_WATCH_KQUEUE
+    fd = ::kqueue();
+    if (fd >= 0)
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+#endif
+}
+
+BridgeSocketWatcher::~BridgeSocketWatcher()
+{
+    clear();
+
+#if HEARTSYNC_WATCH_INOTIFY || HEARTSYNC_WATCH_KQUEUE
+    if (fd >= 0)
+        ::close(fd);
+#endif
+}
+
+void BridgeSocketWatcher::watch(const std::vector<std::string>& socketPaths)
+{
+#if HEARTSYNC_WATCH_INOTIFY || HEARTSYNC_WATCH_KQUEUE
+    if (fd < 0)
+        return;
+
+    std::vector<std::string> wanted;
+    for (const auto& path : socketPaths)
+    {
+        auto directory = watchableDirectory(path);
+        if (! directory.empty() && std::find(wanted.begin(), wanted.end(), directory) == wanted.end())
+            wanted.push_back(std::move(directory));
+
+        if ((int)wanted.size() == MAX_WATCHES)
+            break;
+    }
+
+    if (wanted == directories)
+        return;
+
+    clear();
+
+    for (const auto& directory : wanted)
+    {
+#if HEARTSYNC_WATCH_INOTIFY
+        const int watchDescriptor = ::inotify_add_watch(fd, directory.c_str(),
+                                                        IN_CREATE | IN_MOVED_TO | IN_DELETE | IN_ATTRIB | IN_ONLYDIR);
+        if (watchDescriptor >= 0)
+            watches.push_back(watchDescriptor);
+#elif HEARTSYNC_WATCH_KQUEUE
+        const int directoryFd = ::open(directory.c_str(), O_EVTONLY | O_DIRECTORY | O_CLOEXEC);
+        if (directoryFd < 0)
+            continue;
+
+        struct kevent change;
+        EV_SET(&change, directoryFd, EVFILT_VNODE, EV_ADD | EV_CLEAR,
+               NOTE_WRITE | NOTE_ATTRIB | NOTE_DELETE | NOTE_RENAME, 0, nullptr);
+
+        if (::kevent(fd, &change, 1, nullptr, 0, nullptr) == 0)
+            watches.push_back(directoryFd);
+        else
+            ::close(directoryFd);
+#endif
+    }
+
+    directories = std::move(wanted);
+#else
+    (void)socketPaths;
+#endif
+}
+
+bool BridgeSocketWatcher::drain()
+{
+    bool changed = false;
+
+#if HEARTSYNC_WATCH_INOTIFY
+    alignas(struct inotify_event) char buffer[4096];
+    ssize_t length;
+    while (fd >= 0 && (length = ::read(fd, buffer, sizeof(buffer))) > 0)
+    {
+        changed = true;
+
+        for (ssize_t offset = 0; offset < length;)
+        {
+            const auto* event = reinterpret_cast<const struct inotify_event*>(buffer + offset);
+
+            // A removed directory drops its watch; the next watch() adds it back
+            if (event->mask & IN_IGNORED)
+                directories.clear();
+
+            offset += (ssize_t)(sizeof(struct inotify_event) + event->len);
+        }
+    }
+#elif HEARTSYNC_WATCH_KQUEUE
+    struct kevent events[16];
+    const struct timespec noWait{0, 0};
+    int count;
+    while (fd >= 0 && (count = ::kevent(fd, nullptr, 0, events, 16, &noWait)) > 0)
+    {
+        changed = true;
+
+        for (int i = 0; i < count; ++i)
+            if (events[i].fflags & (NOTE_DELETE | NOTE_RENAME))
+                directories.clear();
+    }
+#endif
+
+    return changed;
+}
+
+void BridgeSocketWatcher::clear()
+{
+#if HEARTSYNC_WATCH_INOTIFY
+    for (const int watchDescriptor : watches)
+        ::inotify_rm_watch(fd, watchDescriptor);
+#elif HEARTSYNC_WATCH_KQUEUE
+    // Closing a directory fd also removes its kevent registration
+    for (const int directoryFd : watches)
+        ::close(directoryFd);
+#endif
+
+    watches.clear();
+    directories.clear();
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Notices when a bridge socket may have appeared, without polling paths.
+ *
+ * Watches the directories that would contain the candidate socket paths
+ * (inotify on Linux, kqueue on macOS). A directory that does not exist yet
+ * is watched through its nearest existing ancestor, so a bridge that creates
+ * its whole directory tree on first launch is still noticed; the next
+ * watch() call then moves the watch down to the real directory.
+ *
+ * getFd() is a descriptor to include in a poll() set: it becomes readable
+ * when an entry is created, renamed into or removed from a watched
+ * directory. drain() consumes the notifications. Everything runs on the
+ * caller's thread; on platforms without a watch API getFd() returns -1 and
+ * callers keep their timed retries.
+ */
+class BridgeSocketWatcher
+{
+public:
+    BridgeSocketWatcher();
+    ~BridgeSocketWatcher();
+
+    BridgeSocketWatcher(const BridgeSocketWatcher&) = delete;
+    BridgeSocketWatcher& operator=(const BridgeSocketWatcher&) = delete;
+
+    /** Watches the parent directories of socketPaths; cheap when the set is unchanged. */
+    void watch(const std::vector<std::string>& socketPaths);
+
+    /** Readable when a watched directory changed; -1 when watching is unsupported. */
+    int getFd() const { return fd; }
+
+    /** Consumes pending notifications. True if any watched directory changed. */
+    bool drain();
+
+    int getNumWatches() const { return (int)watches.size(); }
+
+    static constexpr int MAX_WATCHES = 32;
+
+private:
+    void clear();
+
+    int fd{-1};
+    std::vector<std::string> directories;   // resolved, in watch order
+    std::vector<int> watches;               // inotify watch descriptors or kqueue directory fds
+};
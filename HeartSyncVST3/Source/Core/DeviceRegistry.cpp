@@ -0,0 +1,184 @@
+#include "DeviceRegistry.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+
+namespace
+{
+    int hexValue(char c)
+    {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    bool parseHex(const std::string& text, size_t begin, size_t end, uint64_t& result)
+    {
+        result = 0;
+        for (size_t i = begin; i < end; ++i)
+        {
+            const int digit = hexValue(text[i]);
+            if (digit < 0)
+                return false;
+
+            result = (result << 4) | (uint64_t)digit;
+        }
+
+        return true;
+    }
+}
+
+bool BleUuid::parse(const std::string& text, BleUuid& result)
+{
+    size_t begin = 0, end = text.size();
+    while (begin < end && std::isspace((unsigned char)text[begin])) ++begin;
+    while (end > begin && std::isspace((unsigned char)text[end - 1])) --end;
+
+    if (end - begin > 2 && text[begin] == '0' && (text[begin + 1] == 'x' || text[begin + 1] == 'X'))
+        begin += 2;
+
+    const size_t length = end - begin;
+    uint64_t value = 0;
+
+    if (length == 4 || length == 8)
+    {
+        if (! parseHex(text, begin, end, value))
+            return false;
+
+        result = fromShort((uint32_t)value);
+        return true;
+    }
+
+    // 8-4-4-4-12
+    if (length != 36 || text[begin + 8] != '-' || text[begin + 13] != '-'
+        || text[begin + 18] != '-' || text[begin + 23] != '-')
+        return false;
+
+    uint64_t a, b, c, d, e;
+    if (! parseHex(text, begin, begin + 8, a) || ! parseHex(text, begin + 9, begin + 13, b)
+        || ! parseHex(text, begin + 14, begin + 18, c) || ! parseHex(text, begin + 19, begin + 23, d)
+        || ! parseHex(text, begin + 24, end, e))
+        return false;
+
+    result = { (a << 32) | (b << 16) | c, (d << 48) | e };
+    return true;
+}
+
+//==============================================================================
+DeviceRegistry::DeviceRegistry()
+    : registryId([]
+      {
+          static std::atomic<uint64_t> nextId{1};
+          return nextId.fetch_add(1, std::memory_order_relaxed);
+      }())
+{
+}
+
+bool DeviceRegistry::report(const std::string& identifier, const std::string& name, int signalStrength,
+                            const std::vector<std::string>& services)
+{
+    std::vector<BleUuid> parsed;
+    parsed.reserve(services.size());
+    for (const auto& service : services)
+    {
+        BleUuid uuid;
+        if (BleUuid::parse(service, uuid))
+            parsed.push_back(uuid);
+    }
+
+    const std::lock_guard<std::mutex> guard(lock);
+
+    auto found = indexById.find(identifier);
+    if (found == indexById.end())
+    {
+        found = indexById.emplace(identifier, devices.size()).first;
+        devices.emplace_back();
+        devices.back().identifier = identifier;
+    }
+
+    auto& device = devices[found->second];
+    device.lastSeen = std::chrono::steady_clock::now();
+
+    // A new device (version 0) always counts as a change
+    if (device.version != 0 && device.name == name && device.signalStrength == signalStrength
+        && device.services == parsed)
+        return false;
+
+    device.name = name;
+    device.signalStrength = signalStrength;
+    device.hasHeartRateService = std::find(parsed.begin(), parsed.end(), BleServices::heartRate) != parsed.end();
+    device.services = std::move(parsed);
+    device.version = ++version;
+    return true;
+}
+
+void DeviceRegistry::setConnected(const std::string& identifier)
+{
+    const std::lock_guard<std::mutex> guard(lock);
+
+    for (auto& device : devices)
+    {
+        const bool connected = ! identifier.empty() && device.identifier == identifier;
+        if (device.isConnected != connected)
+        {
+            device.isConnected = connected;
+            device.version = ++version;
+        }
+    }
+}
+
+void DeviceRegistry::clear()
+{
+    const std::lock_guard<std::mutex> guard(lock);
+    devices.clear();
+    indexById.clear();
+    clearedAtVersion = ++version;
+}
+
+uint64_t DeviceRegistry::getVersion() const
+{
+    const std::lock_guard<std::mutex> guard(lock);
+    return version;
+}
+
+size_t DeviceRegistry::getNumDevices() const
+{
+    const std::lock_guard<std::mutex> guard(lock);
+    return devices.size();
+}
+
+std::vector<DeviceRegistry::Device> DeviceRegistry::getDevices() const
+{
+    const std::lock_guard<std::mutex> guard(lock);
+    return devices;
+}
+
+bool DeviceRegistry::findDevice(const std::string& identifier, Device& result) const
+{
+    const std::lock_guard<std::mutex> guard(lock);
+
+    const auto found = indexById.find(identifier);
+    if (found == indexById.end())
+        return false;
+
+    result = devices[found->second];
+    return true;
+}
+
+void DeviceRegistry::getChangesSince(const Cursor& cursor, Changes& changes) const
+{
+    changes.changed.clear();
+
+    const std::lock_guard<std::mutex> guard(lock);
+
+    changes.reset = cursor.registryId != registryId || cursor.version < clearedAtVersion || cursor.version > version;
+    const uint64_t since = changes.reset ? 0 : cursor.version;
+
+    for (const auto& device : devices)
+        if (device.version > since)
+            changes.changed.push_back(device);
+
+    changes.cursor = { registryId, version };
+}
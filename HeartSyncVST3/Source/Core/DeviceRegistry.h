@@ -0,0 +1,107 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief A Bluetooth UUID as a 128-bit integer.
+ *
+ * 16- and 32-bit short forms are expanded onto the Bluetooth base UUID
+ * (0000xxxx-0000-1000-8000-00805F9B34FB), so "180D", "0x180d" and the full
+ * 128-bit spelling of the Heart Rate service compare equal.
+ */
+struct BleUuid
+{
+    uint64_t high{0};
+    uint64_t low{0};
+
+    static constexpr uint64_t BASE_HIGH = 0x0000000000001000ull;   // 0000xxxx-0000-1000
+    static constexpr uint64_t BASE_LOW = 0x800000805F9B34FBull;    // 8000-00805F9B34FB
+
+    static constexpr BleUuid fromShort(uint32_t shortUuid) { return { BASE_HIGH | ((uint64_t)shortUuid << 32), BASE_LOW }; }
+
+    /** Accepts 4 or 8 hex digits (optionally 0x-prefixed) or the dashed 128-bit form; false if malformed. */
+    static bool parse(const std::string& text, BleUuid& result);
+
+    bool operator==(const BleUuid& other) const { return high == other.high && low == other.low; }
+    bool operator!=(const BleUuid& other) const { return ! (*this == other); }
+};
+
+namespace BleServices
+{
+    constexpr BleUuid heartRate = BleUuid::fromShort(0x180D);
+}
+
+//==============================================================================
+/**
+ * @brief Devices seen during a scan, keyed by identifier, with change versions.
+ *
+ * Every visible change (new device, name, signal strength, services,
+ * connection state) bumps the registry's version and stamps the device
+ * with it; re-reporting identical data does not. Readers keep a Cursor
+ * and ask only for what changed since, so a UI never has to copy or
+ * compare the whole list. Devices keep their first-seen order.
+ *
+ * Thread-safe: writers (the bridge client or native BLE callbacks) and
+ * readers (the editor) may be on different threads.
+ */
+class DeviceRegistry
+{
+public:
+    struct Device
+    {
+        std::string identifier;
+        std::string name;
+        int signalStrength{0};
+        bool isConnected{false};
+        std::chrono::steady_clock::time_point lastSeen;
+        std::vector<BleUuid> services;     // parsed once, on report()
+        bool hasHeartRateService{false};
+        uint64_t version{0};               // registry version of this device's last visible change
+    };
+
+    /** Where a reader is up to. A default cursor asks for everything. */
+    struct Cursor
+    {
+        uint64_t registryId{0};
+        uint64_t version{0};
+    };
+
+    struct Changes
+    {
+        Cursor cursor;                     // pass back next time
+        bool reset{false};                 // discard everything shown; changed holds the full list
+        std::vector<Device> changed;       // in first-seen order
+    };
+
+    DeviceRegistry();
+
+    /** Adds or updates a device; returns true if anything visible changed. Unparseable services are ignored. */
+    bool report(const std::string& identifier, const std::string& name, int signalStrength,
+                const std::vector<std::string>& services);
+
+    /** Marks identifier connected and every other device disconnected (empty: none connected). */
+    void setConnected(const std::string& identifier);
+
+    void clear();
+
+    uint64_t getVersion() const;
+    size_t getNumDevices() const;
+    std::vector<Device> getDevices() const;
+    bool findDevice(const std::string& identifier, Device& result) const;
+
+    /** Fills changes with the devices that changed after cursor; reset if the reader must start over. */
+    void getChangesSince(const Cursor& cursor, Changes& changes) const;
+
+private:
+    mutable std::mutex lock;
+    const uint64_t registryId;
+    uint64_t version{0};
+    uint64_t clearedAtVersion{0};
+    std::vector<Device> devices;
+    std::unordered_map<std::string, size_t> indexById;
+};
@@ -0,0 +1,66 @@
+#include "EcgRingBuffer.h"
+
+#include <algorithm>
+
+int EcgRingBuffer::write(const float* source, int numSamples)
+{
+    const auto write = writeIndex.load(std::memory_order_relaxed);
+    const auto read = readIndex.load(std::memory_order_acquire);
+    const auto space = CAPACITY - (write - read);
+    const auto count = (uint64_t)std::max(0, numSamples) < space ? (uint64_t)std::max(0, numSamples) : space;
+
+    for (uint64_t i = 0; i < count; ++i)
+        samples[(size_t)((write + i) & (CAPACITY - 1))] = source[i];
+
+    writeIndex.store(write + count, std::memory_order_release);
+
+    // Whatever arrives after a drop no longer follows on from what was stored
+    if (count < (uint64_t)numSamples)
+    {
+        droppedSamples.fetch_add((uint64_t)numSamples - count, std::memory_order_relaxed);
+        markDiscontinuity();
+    }
+
+    return (int)count;
+}
+
+void EcgRingBuffer::markDiscontinuity()
+{
+    discontinuityIndex.store(writeIndex.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+int EcgRingBuffer::read(float* dest, int maxSamples, bool& discontinuity)
+{
+    discontinuity = false;
+
+    const auto read = readIndex.load(std::memory_order_relaxed);
+    const auto write = writeIndex.load(std::memory_order_acquire);
+    auto available = std::min<uint64_t>(write - read, (uint64_t)std::max(0, maxSamples));
+
+    // Only the most recent discontinuity is kept; older ones are already behind the reader
+    const auto marker = discontinuityIndex.load(std::memory_order_acquire);
+    if (marker != UINT64_MAX && marker != lastReportedDiscontinuity)
+    {
+        if (marker <= read)
+        {
+            discontinuity = true;
+            lastReportedDiscontinuity = marker;
+        }
+        else if (marker < read + available)
+        {
+            available = marker - read;
+        }
+    }
+
+    for (uint64_t i = 0; i < available; ++i)
+        dest[i] = samples[(size_t)((read + i) & (CAPACITY - 1))];
+
+    readIndex.store(read + available, std::memory_order_release);
+    return (int)available;
+}
+
+void EcgRingBuffer::discardPending()
+{
+    readIndex.store(writeIndex.load(std::memory_order_acquire), std::memory_order_release);
+    lastReportedDiscontinuity = discontinuityIndex.load(std::memory_order_acquire);
+}
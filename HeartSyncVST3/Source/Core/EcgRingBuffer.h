@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Single-producer/single-consumer store for raw ECG samples.
+ *
+ * Sized for several minutes of a 130 Hz chest-strap stream (65536 samples,
+ * about 8 minutes) so the analysis worker can fall far behind without losing
+ * data. Samples are addressed by an absolute index that starts at 0 on
+ * reset; the producer also marks stream discontinuities (dropped frames,
+ * sample-rate changes) so the consumer can restart its filters there.
+ *
+ * Threading: write() and markDiscontinuity() from the socket thread, read()
+ * from the analysis thread. No locks, no allocation.
+ */
+class EcgRingBuffer
+{
+public:
+    static constexpr uint64_t CAPACITY = 1u << 16;
+
+    EcgRingBuffer() = default;
+
+    /** Producer: appends samples. Returns how many fitted (the rest are dropped). */
+    int write(const float* samples, int numSamples);
+
+    /** Producer: the next written sample does not follow on from the previous one. */
+    void markDiscontinuity();
+
+    /**
+     * Consumer: copies up to maxSamples of unread samples into dest and
+     * returns the count. discontinuity is set when the first copied sample
+     * starts a new segment; reads never span a discontinuity.
+     */
+    int read(float* dest, int maxSamples, bool& discontinuity);
+
+    uint64_t getDroppedSampleCount() const { return droppedSamples.load(std::memory_order_relaxed); }
+
+    /** Consumer: discards everything that is unread. */
+    void discardPending();
+
+private:
+    std::array<float, CAPACITY> samples{};
+    std::atomic<uint64_t> writeIndex{0};
+    std::atomic<uint64_t> readIndex{0};
+    std::atomic<uint64_t> discontinuityIndex{UINT64_MAX};
+    std::atomic<uint64_t> droppedSamples{0};
+    uint64_t lastReportedDiscontinuity{UINT64_MAX};
+};
@@ -0,0 +1,78 @@
+#include "HeartRateZones.h"
+
+#include <algorithm>
+#include <cmath>
+
+void HeartRateZoneTracker::setConfig(const Config& newConfig)
+{
+    config = newConfig;
+    config.hysteresisBpm = std::max(0.0f, config.hysteresisBpm);
+
+    // Keep boundaries strictly ascending whatever the user typed
+    float floor = 0.0f;
+    for (size_t i = 0; i < boundaryBpm.size(); ++i)
+    {
+        boundaryBpm[i] = std::max(toBpm(config.boundaries[i]), floor);
+        floor = boundaryBpm[i] + 0.1f;
+    }
+}
+
+void HeartRateZoneTracker::reset()
+{
+    zone = -1;
+    previousHeartRate = 0.0f;
+}
+
+bool HeartRateZoneTracker::update(float heartRate, float& crossingFraction)
+{
+    crossingFraction = 0.0f;
+
+    if (heartRate <= 0.0f)
+        return false;
+
+    if (zone < 0)
+    {
+        zone = (int)(std::upper_bound(boundaryBpm.begin(), boundaryBpm.end(), heartRate) - boundaryBpm.begin());
+        previousHeartRate = heartRate;
+        return true;
+    }
+
+    const float halfBand = 0.5f * config.hysteresisBpm;
+    const int startZone = zone;
+    float decidingThreshold = heartRate;
+
+    while (zone < NUM_ZONES - 1 && heartRate >= boundaryBpm[(size_t)zone] + halfBand)
+    {
+        decidingThreshold = boundaryBpm[(size_t)zone] + halfBand;
+        ++zone;
+    }
+
+    while (zone > 0 && heartRate < boundaryBpm[(size_t)zone - 1] - halfBand)
+    {
+        decidingThreshold = boundaryBpm[(size_t)zone - 1] - halfBand;
+        --zone;
+    }
+
+    const float step = heartRate - previousHeartRate;
+    if (zone != startZone && std::abs(step) > 1.0e-6f)
+        crossingFraction = std::clamp((decidingThreshold - previousHeartRate) / step, 0.0f, 1.0f);
+
+    previousHeartRate = heartRate;
+    return zone != startZone;
+}
+
+float HeartRateZoneTracker::toBpm(float boundary) const
+{
+    switch (config.mode)
+    {
+        case Mode::PercentOfMax:
+            return config.maxHeartRate * boundary / 100.0f;
+
+        case Mode::PercentOfReserve:
+            return config.restingHeartRate + (config.maxHeartRate - config.restingHeartRate) * boundary / 100.0f;
+
+        case Mode::AbsoluteBpm:
+        default:
+            return boundary;
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+/**
+ * @brief Heart-rate training-zone classifier with hysteresis.
+ *
+ * Zone boundaries are given either in absolute BPM, as a percentage of the
+ * maximum heart rate, or as a percentage of heart-rate reserve (Karvonen:
+ * rest + pct * (max - rest)). A zone change only happens once the heart rate
+ * has crossed a boundary by half the hysteresis band, so values hovering at
+ * a boundary do not chatter between zones.
+ *
+ * update() also reports where between the previous and current value the
+ * deciding boundary was crossed, which the processor turns into a
+ * sample-accurate MIDI event offset. Single-threaded (audio thread).
+ */
+class HeartRateZoneTracker
+{
+public:
+    static constexpr int NUM_ZONES = 5;
+
+    enum class Mode
+    {
+        AbsoluteBpm = 0,
+        PercentOfMax = 1,
+        PercentOfReserve = 2
+    };
+
+    struct Config
+    {
+        Mode mode{Mode::PercentOfMax};
+        float maxHeartRate{190.0f};
+        float restingHeartRate{60.0f};
+        std::array<float, NUM_ZONES - 1> boundaries{{60.0f, 70.0f, 80.0f, 90.0f}};
+        float hysteresisBpm{3.0f};
+    };
+
+    HeartRateZoneTracker() = default;
+
+    void setConfig(const Config& newConfig);
+    void reset();
+
+    /**
+     * Classifies a new heart-rate value. Returns true when the zone changed;
+     * crossingFraction is then in [0, 1], the position of the crossing
+     * between the previous and the current value.
+     */
+    bool update(float heartRate, float& crossingFraction);
+
+    /** Current zone index (0-based), or -1 before the first valid value. */
+    int getZone() const { return zone; }
+
+    /** Boundary between zone index and index + 1, in BPM. */
+    float getBoundaryBpm(int index) const { return boundaryBpm[(size_t)index]; }
+
+private:
+    float toBpm(float boundary) const;
+
+    Config config;
+    std::array<float, NUM_ZONES - 1> boundaryBpm{};
+    int zone{-1};
+    float previousHeartRate{0.0f};
+};
@@ -1,28 +1,127 @@
 #include "HeartSyncBLEClient.h"
 
-#if JUCE_MAC
+#if HEARTSYNC_HAS_BRIDGE_CLIENT
 
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <arpa/inet.h>
 #include <cerrno>
+#include <cmath>
 #include <cstring>
 
 static constexpr uint32_t MAX_MESSAGE_SIZE = 65536; // 64KB
 static constexpr double HEARTBEAT_TIMEOUT = 5.0;     // seconds
+static constexpr int CONNECT_TIMEOUT_MS = 500;        // local socket: a listening bridge answers at once
+
+#ifdef MSG_NOSIGNAL
+static constexpr int SEND_FLAGS = MSG_NOSIGNAL;      // Linux: EPIPE instead of SIGPIPE
+#else
+static constexpr int SEND_FLAGS = 0;                 // macOS: SO_NOSIGPIPE is set per socket
+#endif
+
+namespace
+{
+    void setNonBlocking(int fd)
+    {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+
+#if JUCE_LINUX
+    constexpr double BRIDGE_LAUNCH_COOLDOWN_MS = 10000.0;   // the bridge's start-up, with margin
+    std::atomic<double> lastBridgeLaunchMs{ -BRIDGE_LAUNCH_COOLDOWN_MS };   // shared by every instance in the process
+
+    /** Per-user defaults, XDG runtime dir first; without one (cron, some CI runners) a per-uid directory in /tmp. */
+    juce::StringArray getLinuxSocketPaths()
+    {
+        juce::StringArray paths;
+
+        const auto runtimeDir = juce::SystemStats::getEnvironmentVariable("XDG_RUNTIME_DIR", {});
+        if (runtimeDir.isNotEmpty())
+            paths.add(juce::File(runtimeDir).getChildFile("heartsync/bridge.sock").getFullPathName());
+
+        paths.add("/tmp/heartsync-" + juce::String((int)::getuid()) + "/bridge.sock");
+        return paths;
+    }
+
+    /** True if something accepts connections at path. A local connect() answers at once, so this never waits. */
+    bool isListening(const juce::String& path)
+    {
+        const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0)
+            return false;
+
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, path.toRawUTF8(), sizeof(addr.sun_path) - 1);
+
+        const bool listening = ::connect(fd, (struct sockaddr*)&addr, sizeof(addr)) == 0;
+        ::close(fd);
+        return listening;
+    }
+
+    /** The executable a shell would run for name (a path, or looked up on PATH), or an empty File. */
+    juce::File findExecutable(const juce::String& name)
+    {
+        const auto isExecutable = [](const juce::File& file)
+        {
+            return file.existsAsFile() && ::access(file.getFullPathName().toRawUTF8(), X_OK) == 0;
+        };
+
+        if (name.containsChar('/'))
+        {
+            const juce::File file(name);
+            return isExecutable(file) ? file : juce::File();
+        }
+
+        for (const auto& directory : juce::StringArray::fromTokens(juce::SystemStats::getEnvironmentVariable("PATH", {}), ":", {}))
+        {
+            const auto file = juce::File(directory).getChildFile(name);
+            if (directory.startsWithChar('/') && isExecutable(file))
+                return file;
+        }
+
+        return {};
+    }
+#endif
+}
 
 HeartSyncBLEClient::HeartSyncBLEClient()
     : juce::Thread("HeartSyncBLEClient")
 {
+    ecgScratch.resize((size_t)BridgeProtocol::MAX_ECG_SAMPLES);
+    pendingEvents.reserve((size_t)MAX_PENDING_EVENTS);
+    deliveredEvents.reserve((size_t)MAX_PENDING_EVENTS);
+
+    if (::pipe(wakePipe) == 0)
+    {
+        setNonBlocking(wakePipe[0]);
+        setNonBlocking(wakePipe[1]);
+    }
+
     startThread();
 }
 
 HeartSyncBLEClient::~HeartSyncBLEClient()
 {
+    cancelPendingUpdate();
     disconnect();
+    signalThreadShouldExit();
+    wakeEventLoop();
     stopThread(5000);
+    discardOutgoing();
+
+    for (auto& fd : wakePipe)
+    {
+        if (fd >= 0)
+            ::close(fd);
+        fd = -1;
+    }
 }
 
 void HeartSyncBLEClient::connectToBridge()
@@ -31,19 +130,15 @@ void HeartSyncBLEClient::connectToBridge()
     lastLoggedFailureAttempt = -1;
     shouldReconnect = true;
         dispatchLog("Attempting to connect to HeartSync Bridge...");
-    notify();
+    wakeEventLoop();
 }
 
 void HeartSyncBLEClient::disconnect()
 {
+    // The event loop owns the socket and closes it when it sees the flag
     shouldReconnect = false;
     connected = false;
-
-    if (socketFd >= 0)
-    {
-        ::close(socketFd);
-        socketFd = -1;
-    }
+    wakeEventLoop();
 }
 
 juce::Array<HeartSyncBLEClient::DeviceInfo> HeartSyncBLEClient::getDevicesSnapshot()
@@ -52,39 +147,48 @@ juce::Array<HeartSyncBLEClient::DeviceInfo> HeartSyncBLEClient::getDevicesSnapsh
     return devices;
 }
 
-void HeartSyncBLEClient::startScan(bool enable)
+uint32_t HeartSyncBLEClient::startScan(bool enable)
 {
     juce::var command = juce::var(new juce::DynamicObject());
     command.getDynamicObject()->setProperty("type", "scan");
     command.getDynamicObject()->setProperty("on", enable);
-    sendCommand(command);
+    return sendCommand(command);
 }
 
-void HeartSyncBLEClient::connectToDevice(const juce::String& deviceId)
+uint32_t HeartSyncBLEClient::connectToDevice(const juce::String& deviceId)
 {
     {
         const juce::ScopedLock lock(deviceStateLock);
         if (deviceConnected && currentDeviceId == deviceId)
-            return;
+            return 0;
 
         if (deviceConnected && currentDeviceId != deviceId)
-        {
             disconnectDevice();
-            juce::Thread::sleep(100);
-        }
     }
 
+    // The queue keeps order, so the bridge has dropped the old device and
+    // stopped scanning before it sees the connect; nothing needs to wait
+    startScan(false);
+
     juce::var command = juce::var(new juce::DynamicObject());
     command.getDynamicObject()->setProperty("type", "connect");
     command.getDynamicObject()->setProperty("id", deviceId);
-    sendCommand(command);
+    return sendCommand(command);
 }
 
-void HeartSyncBLEClient::disconnectDevice()
+uint32_t HeartSyncBLEClient::disconnectDevice()
 {
     juce::var command = juce::var(new juce::DynamicObject());
     command.getDynamicObject()->setProperty("type", "disconnect");
-    sendCommand(command);
+    return sendCommand(command);
+}
+
+uint32_t HeartSyncBLEClient::setEcgStreaming(bool enable)
+{
+    juce::var command = juce::var(new juce::DynamicObject());
+    command.getDynamicObject()->setProperty("type", "ecg");
+    command.getDynamicObject()->setProperty("on", enable);
+    return sendCommand(command);
 }
 
 juce::String HeartSyncBLEClient::getCurrentDeviceId() const
@@ -95,6 +199,69 @@ juce::String HeartSyncBLEClient::getCurrentDeviceId() const
 
 void HeartSyncBLEClient::launchBridge()
 {
+#if JUCE_LINUX
+    // Unlike `open -a`, starting a daemon here is not single-instance: only
+    // launch when no bridge is listening, and once per cooldown per process
+    auto socketPaths = getLinuxSocketPaths();
+    const auto envSocket = juce::SystemStats::getEnvironmentVariable("HEARTSYNC_BRIDGE_SOCKET", {});
+    if (envSocket.isNotEmpty())
+        socketPaths.insert(0, juce::File(envSocket).getFullPathName());
+
+    for (const auto& path : socketPaths)
+    {
+        if (isListening(path))
+        {
+            dispatchLog("Bridge already listening at " + path + "; not launching another");
+            return;
+        }
+    }
+
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    double lastLaunchMs = lastBridgeLaunchMs.load();
+    if (nowMs - lastLaunchMs < BRIDGE_LAUNCH_COOLDOWN_MS || ! lastBridgeLaunchMs.compare_exchange_strong(lastLaunchMs, nowMs))
+    {
+        dispatchLog("Bridge launch already in progress");
+        return;
+    }
+
+    // No app bundle on Linux: HEARTSYNC_BRIDGE_COMMAND, or heartsync-bridge from ~/.local/bin or PATH
+    auto command = juce::SystemStats::getEnvironmentVariable("HEARTSYNC_BRIDGE_COMMAND", {}).trim();
+    juce::File executable;
+
+    if (command.isNotEmpty())
+    {
+        executable = findExecutable(juce::StringArray::fromTokens(command, true)[0].unquoted());
+    }
+    else
+    {
+        const auto localBridge = juce::File::getSpecialLocation(juce::File::userHomeDirectory)
+                                     .getChildFile(".local/bin/heartsync-bridge");
+        executable = findExecutable(localBridge.existsAsFile() ? localBridge.getFullPathName() : juce::String("heartsync-bridge"));
+        command = executable.getFullPathName().quoted();
+    }
+
+    if (executable == juce::File())
+    {
+        lastBridgeLaunchMs.store(-BRIDGE_LAUNCH_COOLDOWN_MS);   // nothing started; let a later attempt retry
+        dispatchLog("HeartSync bridge not found (" + (command.isNotEmpty() ? command : juce::String("heartsync-bridge"))
+                    + "); install heartsync-bridge or set HEARTSYNC_BRIDGE_COMMAND.");
+        postEvent(PendingEvent::Type::Error, "Bridge not found. Install heartsync-bridge or set HEARTSYNC_BRIDGE_COMMAND.");
+        return;
+    }
+
+    // Backgrounded through sh so the bridge outlives the ChildProcess handle
+    juce::ChildProcess process;
+    if (process.start(juce::StringArray{ "/bin/sh", "-c", command + " >/dev/null 2>&1 &" }, 0))
+    {
+        process.waitForProcessToFinish(1000);
+        dispatchLog("Launched bridge: " + command);
+        return;
+    }
+
+    lastBridgeLaunchMs.store(-BRIDGE_LAUNCH_COOLDOWN_MS);
+    dispatchLog("Could not start the HeartSync bridge (" + command + ")");
+    postEvent(PendingEvent::Type::Error, "Could not start the HeartSync bridge.");
+#else
     juce::String bridgePaths[] = {
         juce::File::getSpecialLocation(juce::File::userHomeDirectory)
             .getChildFile("Applications/HeartSync Bridge.app").getFullPathName(),
@@ -122,16 +289,11 @@ void HeartSyncBLEClient::launchBridge()
     }
 
     dispatchLog("HeartSync Bridge.app not found; install to ~/Applications or /Applications.");
-    if (onError)
-    {
-        juce::MessageManager::callAsync([this]() {
-            if (onError)
-                onError("Bridge app not found. Install HeartSync Bridge to ~/Applications.");
-        });
-    }
+    postEvent(PendingEvent::Type::Error, "Bridge app not found. Install HeartSync Bridge to ~/Applications.");
+#endif
 }
 
-bool HeartSyncBLEClient::connectToSocket()
+void HeartSyncBLEClient::buildSocketCandidates()
 {
     juce::StringArray candidatePaths;
     const auto addCandidate = [&candidatePaths](const juce::String& path)
@@ -144,6 +306,20 @@ bool HeartSyncBLEClient::connectToSocket()
     if (envSocket.isNotEmpty())
         addCandidate(juce::File(envSocket).getFullPathName());
 
+    if (! lastSocketPathLoaded)
+    {
+        lastSocketPath = getLastSocketPathFile().loadFileAsString().trim();
+        lastSocketPathLoaded = true;
+    }
+
+    // The path that worked last time goes ahead of the platform defaults
+    if (lastSocketPath.startsWithChar('/'))
+        addCandidate(lastSocketPath);
+
+#if JUCE_LINUX
+    for (const auto& path : getLinuxSocketPaths())
+        addCandidate(path);
+#else
     const auto homeDir = juce::File::getSpecialLocation(juce::File::userHomeDirectory);
     const auto appData = juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory);
     const auto commonData = juce::File::getSpecialLocation(juce::File::commonApplicationDataDirectory);
@@ -191,7 +367,22 @@ bool HeartSyncBLEClient::connectToSocket()
         addCandidate(commonData.getChildFile("HeartSync/bridge.sock").getFullPathName());
         addCandidate(commonData.getChildFile("HeartSyncBridge/bridge.sock").getFullPathName());
     }
+#endif
+
+    socketCandidates = candidatePaths;
+
+    std::vector<std::string> watchPaths;
+    for (const auto& path : socketCandidates)
+        watchPaths.push_back(path.toStdString());
+    socketWatcher.watch(watchPaths);
+}
 
+bool HeartSyncBLEClient::connectToSocket()
+{
+    if (socketCandidates.isEmpty() || (reconnectAttempts > 0 && reconnectAttempts % CANDIDATE_REFRESH_ATTEMPTS == 0))
+        buildSocketCandidates();
+
+    const auto candidatePaths = socketCandidates;   // a copy: a successful connect reorders the cache
     juce::String lastError;
 
     for (const auto& socketPath : candidatePaths)
@@ -199,8 +390,11 @@ bool HeartSyncBLEClient::connectToSocket()
         if (socketPath.isEmpty())
             continue;
 
-        juce::File socketFile(socketPath);
-        dispatchLog("Attempting bridge socket at " + socketPath + (socketFile.exists() ? " (exists)" : " (missing)"));
+        // A missing path cannot connect; the directory watch reports when it appears
+        if (! juce::File(socketPath).exists())
+            continue;
+
+        dispatchLog("Attempting bridge socket at " + socketPath);
 
         socketFd = socket(AF_UNIX, SOCK_STREAM, 0);
         if (socketFd < 0)
@@ -209,7 +403,13 @@ bool HeartSyncBLEClient::connectToSocket()
             continue;
         }
 
-        fcntl(socketFd, F_SETFL, O_NONBLOCK);
+        setNonBlocking(socketFd);
+
+#ifdef SO_NOSIGPIPE
+        // macOS has no MSG_NOSIGNAL; a bridge that dies mid-write must not kill the host
+        const int noSigPipe = 1;
+        setsockopt(socketFd, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
 
         struct sockaddr_un addr;
         memset(&addr, 0, sizeof(addr));
@@ -226,21 +426,34 @@ bool HeartSyncBLEClient::connectToSocket()
             continue;
         }
 
-        fd_set writefds;
-        FD_ZERO(&writefds);
-        FD_SET(socketFd, &writefds);
+        // Wait for the connect to complete, but let shutdown interrupt it
+        struct pollfd fds[2] = { { socketFd, POLLOUT, 0 }, { wakePipe[0], POLLIN, 0 } };
+        for (;;)
+        {
+            result = ::poll(fds, 2, CONNECT_TIMEOUT_MS);
+
+            if (result < 0 && errno == EINTR)
+                continue;
 
-        struct timeval timeout;
-        timeout.tv_sec = 2;
-        timeout.tv_usec = 0;
+            if (result > 0 && fds[0].revents == 0 && !threadShouldExit())
+            {
+                drainWakePipe(); // queued commands; nothing to send yet
+                continue;
+            }
 
-        result = select(socketFd + 1, nullptr, &writefds, nullptr, &timeout);
+            break;
+        }
 
-        if (result <= 0)
+        if (result <= 0 || fds[0].revents == 0)
         {
-            lastError = (result == 0 ? "connect timeout" : "select(): " + juce::String(strerror(errno)));
+            lastError = (result == 0 ? "connect timeout"
+                         : result < 0 ? "poll(): " + juce::String(strerror(errno)) : juce::String("shutting down"));
             ::close(socketFd);
             socketFd = -1;
+
+            if (threadShouldExit())
+                break;
+
             continue;
         }
 
@@ -256,8 +469,8 @@ bool HeartSyncBLEClient::connectToSocket()
             continue;
         }
 
-        fcntl(socketFd, F_SETFL, 0);
         dispatchLog("Bridge socket connected at " + socketPath);
+        rememberSocketPath(socketPath);
         return true;
     }
 
@@ -269,30 +482,69 @@ bool HeartSyncBLEClient::connectToSocket()
 
     if (candidatePaths.isEmpty())
         dispatchLog("Bridge socket paths unavailable");
-    else
-        dispatchLog("Unable to connect to bridge socket: " + (lastError.isNotEmpty() ? lastError : juce::String("unknown error")));
+    else if (lastError.isNotEmpty())
+        dispatchLog("Unable to connect to bridge socket: " + lastError);
 
     return false;
 }
 
+void HeartSyncBLEClient::rememberSocketPath(const juce::String& path)
+{
+    if (path == lastSocketPath)
+        return;
+
+    lastSocketPath = path;
+    socketCandidates.removeString(path);
+    socketCandidates.insert(0, path);
+
+    auto file = getLastSocketPathFile();
+    if (file.getParentDirectory().createDirectory().wasOk())
+        file.replaceWithText(path);
+}
+
+juce::File HeartSyncBLEClient::getLastSocketPathFile()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("HeartSync/last-bridge-socket");
+}
+
 void HeartSyncBLEClient::dispatchLog(const juce::String& message)
 {
     if (! onLog)
         return;
 
-    auto callback = onLog;
-    juce::MessageManager::callAsync([callback, message]() mutable {
-        if (callback)
-            callback(message);
-    });
+    {
+        const juce::ScopedLock lock(pendingLock);
+        ++dispatchStats.posted;
+
+        // Scanning can log faster than the UI drains; keep the newest lines
+        if (pendingLogs.size() >= MAX_PENDING_LOGS)
+        {
+            pendingLogs.remove(0);
+            ++dispatchStats.dropped;
+        }
+
+        pendingLogs.add(message);
+    }
+
+    triggerAsyncUpdate();
 }
 
-void HeartSyncBLEClient::sendCommand(const juce::var& command)
+uint32_t HeartSyncBLEClient::sendCommand(const juce::var& command)
 {
     if (!connected || socketFd < 0 || !command.isObject())
-        return;
+        return 0;
 
     const juce::String type = command.getProperty("type", juce::String()).toString();
+
+    // Backpressure: a bridge that stops reading must not make the queue grow without bound
+    if (queuedCommandCount.fetch_add(1) >= MAX_QUEUED_COMMANDS)
+    {
+        queuedCommandCount.fetch_sub(1);
+        dispatchLog("Bridge command queue full, dropping " + type);
+        return 0;
+    }
+
     if (type.isNotEmpty())
     {
         juce::String detail;
@@ -303,32 +555,22 @@ void HeartSyncBLEClient::sendCommand(const juce::var& command)
         dispatchLog("Sending bridge command: " + type + detail);
     }
 
-    const juce::String jsonString = juce::JSON::toString(command, false);
-    juce::MemoryOutputStream jsonData;
-    jsonData.write(jsonString.toRawUTF8(), (size_t)jsonString.getNumBytesAsUTF8());
-
-    const char* payload = static_cast<const char*>(jsonData.getData());
-    size_t payloadSize = jsonData.getDataSize();
-
-    if (payloadSize > MAX_MESSAGE_SIZE)
-        return;
+    uint32_t requestId = nextRequestId.fetch_add(1);
+    if (requestId == 0)
+        requestId = nextRequestId.fetch_add(1);
 
-    uint32_t length = htonl(static_cast<uint32_t>(payloadSize));
-    ssize_t sent = ::send(socketFd, &length, 4, 0);
+    command.getDynamicObject()->setProperty("request_id", (juce::int64)requestId);
 
-    if (sent != 4)
-    {
-        connected = false;
-        return;
-    }
+    // The command object changes hands here; the event loop serialises it
+    auto* node = new OutgoingCommand();
+    node->command = command;
+    node->requestId = requestId;
 
-    sent = ::send(socketFd, payload, payloadSize, 0);
+    node->next = incomingCommands.load(std::memory_order_relaxed);
+    while (!incomingCommands.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {}
 
-    if (sent != static_cast<ssize_t>(payloadSize))
-    {
-        connected = false;
-        return;
-    }
+    wakeEventLoop();
+    return requestId;
 }
 
 void HeartSyncBLEClient::run()
@@ -339,75 +581,307 @@ void HeartSyncBLEClient::run()
             attemptReconnect();
 
         if (connected && socketFd >= 0)
+            runEventLoop();
+        else if (!shouldReconnect)
+            wait(-1); // connectToBridge() or shutdown wakes us
+    }
+
+    if (socketFd >= 0)
+        closeConnection(false);
+}
+
+void HeartSyncBLEClient::runEventLoop()
+{
+    streamDecoder.reset();
+    bool lost = false;
+
+    while (!threadShouldExit() && connected)
+    {
+        // Liveness is a deadline, checked even when the bridge goes completely silent
+        const double now = juce::Time::getMillisecondCounterHiRes() / 1000.0;
+        const double deadline = lastHeartbeatTime + HEARTBEAT_TIMEOUT;
+        if (now >= deadline)
         {
-            uint32_t lengthPrefix = 0;
-            ssize_t bytesRead = ::recv(socketFd, &lengthPrefix, 4, 0);
+            dispatchLog("Bridge heartbeat timed out");
+            lost = true;
+            break;
+        }
 
-            if (bytesRead != 4)
-            {
-                connected = false;
-                if (socketFd >= 0)
-                {
-                    ::close(socketFd);
-                    socketFd = -1;
-                }
-                if (onBridgeDisconnected)
-                {
-                    juce::MessageManager::callAsync([this]() {
-                        if (onBridgeDisconnected)
-                            onBridgeDisconnected();
-                    });
-                }
+        struct pollfd fds[2] = {
+            { socketFd, (short)(POLLIN | (hasPendingOutput() ? POLLOUT : 0)), 0 },
+            { wakePipe[0], POLLIN, 0 }
+        };
+
+        const int timeoutMs = juce::jmax(1, (int)std::ceil((deadline - now) * 1000.0));
+        const int ready = ::poll(fds, 2, timeoutMs);
+
+        if (ready < 0)
+        {
+            if (errno == EINTR)
                 continue;
-            }
 
-            uint32_t messageLength = ntohl(lengthPrefix);
-            if (messageLength > MAX_MESSAGE_SIZE)
+            dispatchLog("Bridge poll failed: " + juce::String(strerror(errno)));
+            lost = true;
+            break;
+        }
+
+        if (fds[1].revents & POLLIN)
+            drainWakePipe();
+
+        if (fds[0].revents & POLLIN)
+        {
+            if (!readFromSocket())
             {
-                connected = false;
-                if (socketFd >= 0)
-                {
-                    ::close(socketFd);
-                    socketFd = -1;
-                }
-                continue;
+                lost = true;
+                break;
             }
+        }
+        else if (fds[0].revents & (POLLERR | POLLHUP | POLLNVAL))
+        {
+            lost = true;
+            break;
+        }
+
+        if (connected && !flushOutgoing())
+        {
+            lost = true;
+            break;
+        }
+    }
+
+    closeConnection(lost);
+}
+
+bool HeartSyncBLEClient::readFromSocket()
+{
+    // Drain everything the socket has; messages may straddle reads
+    for (;;)
+    {
+        size_t space = 0;
+        auto* dest = streamDecoder.prepareWrite(space);
+        const ssize_t bytesRead = ::recv(socketFd, dest, space, 0);
+
+        if (bytesRead == 0)
+            return false; // bridge closed the connection
+
+        if (bytesRead < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
 
-            juce::MemoryBlock messageData(messageLength);
-            char* buffer = static_cast<char*>(messageData.getData());
-            size_t totalRead = 0;
+        streamDecoder.commitWrite((size_t)bytesRead);
 
-            while (totalRead < messageLength)
+        const uint8_t* payload = nullptr;
+        size_t size = 0;
+        for (;;)
+        {
+            const auto result = streamDecoder.next(payload, size);
+            if (result == BridgeProtocol::StreamDecoder::Result::NeedMore)
+                break;
+
+            if (result == BridgeProtocol::StreamDecoder::Result::Oversized)
             {
-                bytesRead = ::recv(socketFd, buffer + totalRead, messageLength - totalRead, 0);
-                if (bytesRead <= 0)
-                {
-                    connected = false;
-                    if (socketFd >= 0)
-                    {
-                        ::close(socketFd);
-                        socketFd = -1;
-                    }
-                    break;
-                }
-                totalRead += (size_t)bytesRead;
+                dispatchLog("Bridge sent an oversized message; reconnecting");
+                return false;
             }
 
-            if (totalRead == messageLength)
+            handlePayload(payload, size);
+        }
+    }
+}
+
+void HeartSyncBLEClient::handlePayload(const uint8_t* payload, size_t size)
+{
+    if (BridgeProtocol::isBinaryFrame(payload, size))
+    {
+        processBinaryFrame(payload, size);
+        return;
+    }
+
+    const auto jsonString = juce::String::fromUTF8(reinterpret_cast<const char*>(payload), static_cast<int>(size));
+    const auto parsed = juce::JSON::parse(jsonString);
+    if (parsed.isObject())
+        processMessage(parsed);
+}
+
+bool HeartSyncBLEClient::hasPendingOutput() const
+{
+    return !sendQueue.empty() || incomingCommands.load(std::memory_order_acquire) != nullptr;
+}
+
+void HeartSyncBLEClient::collectQueuedCommands()
+{
+    auto* node = incomingCommands.exchange(nullptr, std::memory_order_acquire);
+
+    // The stack holds the newest command first
+    OutgoingCommand* ordered = nullptr;
+    while (node != nullptr)
+    {
+        auto* next = node->next;
+        node->next = ordered;
+        ordered = node;
+        node = next;
+    }
+
+    while (ordered != nullptr)
+    {
+        std::unique_ptr<OutgoingCommand> command(ordered);
+        ordered = ordered->next;
+
+        const juce::String jsonString = juce::JSON::toString(command->command, false);
+        const size_t payloadSize = jsonString.getNumBytesAsUTF8();
+
+        if (payloadSize > MAX_MESSAGE_SIZE)
+        {
+            queuedCommandCount.fetch_sub(1);
+            continue;
+        }
+
+        command->frame.setSize(4 + payloadSize);
+        const uint32_t length = htonl(static_cast<uint32_t>(payloadSize));
+        command->frame.copyFrom(&length, 0, 4);
+        command->frame.copyFrom(jsonString.toRawUTF8(), 4, payloadSize);
+
+        rememberPendingRequest(command->requestId, command->command.getProperty("type", juce::String()).toString());
+        command->command = juce::var();
+        sendQueue.push_back(std::move(command));
+    }
+}
+
+bool HeartSyncBLEClient::flushOutgoing()
+{
+    collectQueuedCommands();
+
+    while (!sendQueue.empty())
+    {
+        // Everything pending goes out in one system call
+        struct iovec vectors[MAX_WRITE_BATCH];
+        int numVectors = 0;
+
+        for (const auto& command : sendQueue)
+        {
+            if (numVectors == MAX_WRITE_BATCH)
+                break;
+
+            const size_t offset = numVectors == 0 ? sendOffset : 0;
+            vectors[numVectors].iov_base = static_cast<char*>(command->frame.getData()) + offset;
+            vectors[numVectors].iov_len = command->frame.getSize() - offset;
+            ++numVectors;
+        }
+
+        struct msghdr message;
+        memset(&message, 0, sizeof(message));
+        message.msg_iov = vectors;
+        message.msg_iovlen = numVectors;
+
+        ssize_t written = ::sendmsg(socketFd, &message, SEND_FLAGS);
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            // Socket buffer full: the rest goes out when poll() reports POLLOUT
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+
+        // A short write can end anywhere, including inside a length prefix
+        while (written > 0)
+        {
+            const size_t remaining = sendQueue.front()->frame.getSize() - sendOffset;
+            if ((size_t)written < remaining)
             {
-                juce::String jsonString = juce::String::fromUTF8(buffer, static_cast<int>(messageLength));
-                juce::var parsed = juce::JSON::parse(jsonString);
-                if (parsed.isObject())
-                    processMessage(parsed);
+                sendOffset += (size_t)written;
+                break;
             }
 
-            checkHeartbeat();
+            written -= (ssize_t)remaining;
+            sendQueue.pop_front();
+            sendOffset = 0;
+            queuedCommandCount.fetch_sub(1);
         }
-        else
+    }
+
+    return true;
+}
+
+void HeartSyncBLEClient::discardOutgoing()
+{
+    auto* node = incomingCommands.exchange(nullptr, std::memory_order_acquire);
+    while (node != nullptr)
+    {
+        std::unique_ptr<OutgoingCommand> command(node);
+        node = node->next;
+        queuedCommandCount.fetch_sub(1);
+    }
+
+    queuedCommandCount.fetch_sub((int)sendQueue.size());
+    sendQueue.clear();
+    sendOffset = 0;
+}
+
+void HeartSyncBLEClient::rememberPendingRequest(uint32_t requestId, const juce::String& type)
+{
+    // A small ring: bridges that never acknowledge just overwrite old entries
+    pendingRequests[(size_t)nextPendingRequest] = { requestId, type };
+    nextPendingRequest = (nextPendingRequest + 1) % MAX_PENDING_REQUESTS;
+}
+
+juce::String HeartSyncBLEClient::takePendingRequest(uint32_t requestId)
+{
+    for (auto& request : pendingRequests)
+    {
+        if (request.requestId == requestId && requestId != 0)
         {
-            wait(100);
+            request.requestId = 0;
+            return request.type;
         }
     }
+
+    return {};
+}
+
+void HeartSyncBLEClient::closeConnection(bool notifyListeners)
+{
+    connected = false;
+
+    if (socketFd >= 0)
+    {
+        ::close(socketFd);
+        socketFd = -1;
+    }
+
+    discardOutgoing();
+    streamDecoder.reset();
+    detachSharedRing();
+    bridgeClock.reset();   // a restarted bridge may use a different clock
+
+    if (notifyListeners && !threadShouldExit())
+    {
+        disconnectedAtMs = juce::Time::getMillisecondCounterHiRes();
+        postEvent(PendingEvent::Type::BridgeDisconnected);
+    }
+}
+
+void HeartSyncBLEClient::wakeEventLoop()
+{
+    notify();
+
+    if (wakePipe[1] >= 0)
+    {
+        const char byte = 0;
+        const auto written = ::write(wakePipe[1], &byte, 1); // a full pipe already means "wake up"
+        juce::ignoreUnused(written);
+    }
+}
+
+void HeartSyncBLEClient::drainWakePipe()
+{
+    char scratch[64];
+    while (::read(wakePipe[0], scratch, sizeof(scratch)) > 0) {}
 }
 
 void HeartSyncBLEClient::attemptReconnect()
@@ -421,38 +895,55 @@ void HeartSyncBLEClient::attemptReconnect()
     double jitter = 0.9 + (random.nextDouble() * 0.2);
     int delay = static_cast<int>(baseDelay * jitter);
 
-    wait(delay);
+    if (socketCandidates.isEmpty())
+        buildSocketCandidates();
+
+    // Backoff only bounds the wait; the socket appearing ends it immediately
+    bool socketAppeared = waitForBridgeSocket(delay);
 
     if (threadShouldExit())
         return;
 
-    if (reconnectAttempts == 2)
+    if (reconnectAttempts == 2 && !socketAppeared)
     {
         dispatchLog("Bridge helper not responding, attempting to launch helper app...");
         launchBridge();
-        wait(2000);
+        socketAppeared = waitForBridgeSocket(2000);
+    }
+
+    bool socketConnected = connectToSocket();
+
+    // The socket file exists from bind(); the bridge may not be listening yet
+    for (int retry = 0; !socketConnected && socketAppeared && retry < WATCH_CONNECT_RETRIES && !threadShouldExit(); ++retry)
+    {
+        wait(20);
+        socketConnected = connectToSocket();
     }
 
-    if (connectToSocket())
+    if (socketConnected)
     {
+        // Commands that raced the previous disconnect must not precede the handshake
+        discardOutgoing();
         connected = true;
         reconnectAttempts = 0;
+        ecgSequenceValid = false;
+        protocolVersion = 0;
+        detachSharedRing();
         lastLoggedFailureAttempt = -1;
         lastHeartbeatTime = juce::Time::getMillisecondCounterHiRes() / 1000.0;
         dispatchLog("Bridge helper socket connected");
+        recordReconnect(socketAppeared);
 
-        if (onBridgeConnected)
-        {
-            juce::MessageManager::callAsync([this]() {
-                if (onBridgeConnected)
-                    onBridgeConnected();
-            });
-        }
+        postEvent(PendingEvent::Type::BridgeConnected);
 
         juce::var handshake = juce::var(new juce::DynamicObject());
         handshake.getDynamicObject()->setProperty("type", "handshake");
-        handshake.getDynamicObject()->setProperty("version", 1);
+        handshake.getDynamicObject()->setProperty("version", BridgeProtocol::PROTOCOL_VERSION);
         handshake.getDynamicObject()->setProperty("client", "HeartSync VST3");
+
+        juce::Array<juce::var> binaryFrames { "hr", "rr", "ecg", "heartbeat" };
+        handshake.getDynamicObject()->setProperty("binary_frames", binaryFrames);
+        handshake.getDynamicObject()->setProperty("shared_memory", (int)BiometricSharedRing::LAYOUT_VERSION);
         sendCommand(handshake);
 
         juce::var statusRequest = juce::var(new juce::DynamicObject());
@@ -473,19 +964,434 @@ void HeartSyncBLEClient::attemptReconnect()
     }
 }
 
-void HeartSyncBLEClient::checkHeartbeat()
+bool HeartSyncBLEClient::waitForBridgeSocket(int timeoutMs)
 {
-    double now = juce::Time::getMillisecondCounterHiRes() / 1000.0;
+    if (wakePipe[0] < 0)
+    {
+        wait(timeoutMs);
+        return false;
+    }
+
+    struct pollfd fds[2] = { { wakePipe[0], POLLIN, 0 }, { socketWatcher.getFd(), POLLIN, 0 } };
+    const nfds_t numFds = socketWatcher.getFd() >= 0 ? 2 : 1;
+    const double deadline = juce::Time::getMillisecondCounterHiRes() + timeoutMs;
 
-    if ((now - lastHeartbeatTime) > HEARTBEAT_TIMEOUT)
+    for (;;)
     {
-        connected = false;
-        if (socketFd >= 0)
+        const int remaining = juce::jmax(0, (int)std::ceil(deadline - juce::Time::getMillisecondCounterHiRes()));
+        const int ready = ::poll(fds, numFds, remaining);
+
+        if (ready < 0 && errno == EINTR)
+            continue;
+
+        if (ready <= 0)
+            return false;
+
+        // Something changed in a socket directory: re-arm the watch (a new
+        // directory may now exist) and report only if a candidate is there
+        if (numFds > 1 && (fds[1].revents & POLLIN) && socketWatcher.drain())
         {
-            ::close(socketFd);
-            socketFd = -1;
+            buildSocketCandidates();
+
+            for (const auto& path : socketCandidates)
+                if (juce::File(path).exists())
+                    return true;
+        }
+
+        // connectToBridge(), a queued command or shutdown: try now, as before
+        if (fds[0].revents & POLLIN)
+        {
+            drainWakePipe();
+            return false;
+        }
+    }
+}
+
+void HeartSyncBLEClient::recordReconnect(bool viaWatch)
+{
+    if (disconnectedAtMs <= 0.0)
+        return;
+
+    const double elapsedMs = juce::Time::getMillisecondCounterHiRes() - disconnectedAtMs;
+    disconnectedAtMs = 0.0;
+
+    {
+        const juce::ScopedLock lock(pendingLock);
+        ++reconnectStats.reconnects;
+        if (viaWatch)
+            ++reconnectStats.viaWatch;
+        reconnectStats.lastMs = elapsedMs;
+        reconnectStats.maxMs = juce::jmax(reconnectStats.maxMs, elapsedMs);
+        reconnectStats.totalMs += elapsedMs;
+    }
+
+    dispatchLog("Bridge reconnected after " + juce::String(elapsedMs, 1) + " ms"
+                + (viaWatch ? " (socket watch)" : " (retry timer)"));
+}
+
+HeartSyncBLEClient::ReconnectStats HeartSyncBLEClient::getReconnectStats() const
+{
+    const juce::ScopedLock lock(pendingLock);
+    return reconnectStats;
+}
+
+void HeartSyncBLEClient::processBinaryFrame(const uint8_t* payload, size_t size)
+{
+    BridgeProtocol::FrameHeader header;
+    if (! BridgeProtocol::decodeHeader(payload, size, header))
+        return;
+
+    switch (header.type)
+    {
+        case BridgeProtocol::FrameType::Ecg:
+        {
+            BridgeProtocol::EcgFrame frame;
+            if (! BridgeProtocol::decodeEcgFrame(payload, size, frame, ecgScratch.data(), (int)ecgScratch.size()))
+            {
+                dispatchLog("Bridge: malformed ECG frame dropped");
+                ecgSequenceValid = false;
+                return;
+            }
+
+            const bool discontinuity = ! ecgSequenceValid || frame.sequence != expectedEcgSequence;
+            expectedEcgSequence = frame.sequence + 1;
+            ecgSequenceValid = true;
+
+            if (onEcgSamples)
+                onEcgSamples(ecgScratch.data(), frame.numSamples, frame.sampleRateHz,
+                             discontinuity, juce::Time::getMillisecondCounterHiRes());
+            break;
+        }
+
+        case BridgeProtocol::FrameType::HeartRate:
+        case BridgeProtocol::FrameType::RrIntervals:
+        {
+            if (! BridgeProtocol::decodeHeartRateFrame(payload, size, heartRateFrame))
+                return;
+
+            if (activeSharedRing.load(std::memory_order_relaxed) != nullptr)
+                return; // the ring is the heart-rate source now
+
+            const double receivedMs = juce::Time::getMillisecondCounterHiRes();
+            const double sourceMs = bridgeClock.toHostMs(heartRateFrame.bridgeTimestamp, receivedMs);
+
+            if (header.type == BridgeProtocol::FrameType::HeartRate)
+            {
+                receiveLatency.record(receivedMs - sourceMs);
+                dispatchHeartRate(heartRateFrame.bpm, heartRateFrame.rrIntervalsMs.data(),
+                                  heartRateFrame.numRrIntervals, sourceMs);
+            }
+            else if (heartRateFrame.numRrIntervals > 0)
+            {
+                postHeartRate(PendingEvent::Type::RrIntervals, 0.0f, heartRateFrame.rrIntervalsMs.data(),
+                              heartRateFrame.numRrIntervals, sourceMs);
+            }
+            break;
+        }
+
+        case BridgeProtocol::FrameType::Heartbeat:
+        {
+            const double receivedMs = juce::Time::getMillisecondCounterHiRes();
+            lastHeartbeatTime = receivedMs / 1000.0;
+
+            // Heartbeats keep the clock offset fresh while no heart rate is flowing
+            double bridgeTimestamp = 0.0;
+            if (BridgeProtocol::decodeHeartbeatFrame(payload, size, bridgeTimestamp))
+                bridgeClock.observe(bridgeTimestamp, receivedMs);
+            break;
+        }
+
+        default:
+            break; // newer bridge, unknown frame type
+    }
+}
+
+void HeartSyncBLEClient::dispatchHeartRate(float bpm, const float* rrIntervalsMs, int numRrIntervals, double sourceMs)
+{
+    if (activeSharedRing.load(std::memory_order_relaxed) != nullptr)
+        return;
+
+    postHeartRate(PendingEvent::Type::HeartRate, bpm, rrIntervalsMs, numRrIntervals, sourceMs);
+}
+
+//==============================================================================
+void HeartSyncBLEClient::BridgeClockMapper::observe(double bridgeSeconds, double receivedMs)
+{
+    if (bridgeSeconds <= 0.0)
+        return;
+
+    const double offsetMs = receivedMs - bridgeSeconds * 1000.0;
+
+    if (! valid || receivedMs - windowStartMs >= WINDOW_MS)
+    {
+        previousMinMs = valid ? currentMinMs : offsetMs;
+        currentMinMs = offsetMs;
+        windowStartMs = receivedMs;
+        valid = true;
+        return;
+    }
+
+    currentMinMs = juce::jmin(currentMinMs, offsetMs);
+}
+
+double HeartSyncBLEClient::BridgeClockMapper::toHostMs(double bridgeSeconds, double receivedMs)
+{
+    observe(bridgeSeconds, receivedMs);
+
+    double sourceMs = receivedMs;
+    if (valid && bridgeSeconds > 0.0)
+        sourceMs = bridgeSeconds * 1000.0 + juce::jmin(currentMinMs, previousMinMs);
+
+    // Consumers (jitter buffer, analysis) expect time to move forward
+    sourceMs = juce::jlimit(juce::jmin(lastSourceMs, receivedMs), receivedMs, sourceMs);
+    lastSourceMs = sourceMs;
+    return sourceMs;
+}
+
+void HeartSyncBLEClient::resetLatencyStats()
+{
+    receiveLatency.reset();
+    dispatchLatency.reset();
+}
+
+//==============================================================================
+void HeartSyncBLEClient::postHeartRate(PendingEvent::Type type, float bpm, const float* rrIntervalsMs,
+                                       int numRrIntervals, double timestampMs)
+{
+    PendingEvent event;
+    event.type = type;
+    event.bpm = bpm;
+    event.timestampMs = timestampMs;
+    event.numRrIntervals = juce::jlimit(0, BridgeProtocol::MAX_RR_PER_FRAME, numRrIntervals);
+    std::copy(rrIntervalsMs, rrIntervalsMs + event.numRrIntervals, event.rrIntervalsMs.begin());
+    queueEvent(std::move(event));
+}
+
+void HeartSyncBLEClient::postEvent(PendingEvent::Type type, const juce::String& text,
+                                   uint32_t requestId, bool ok)
+{
+    PendingEvent event;
+    event.type = type;
+    event.text = text;
+    event.requestId = requestId;
+    event.ok = ok;
+    queueEvent(std::move(event));
+}
+
+void HeartSyncBLEClient::queueEvent(PendingEvent&& event)
+{
+    {
+        const juce::ScopedLock lock(pendingLock);
+        ++dispatchStats.posted;
+
+        // Only reachable if the message thread stalls for a long time; the newest state wins
+        if ((int)pendingEvents.size() >= MAX_PENDING_EVENTS)
+        {
+            pendingEvents.erase(pendingEvents.begin());
+            ++dispatchStats.dropped;
+        }
+
+        pendingEvents.push_back(std::move(event));
+    }
+
+    triggerAsyncUpdate();
+}
+
+void HeartSyncBLEClient::postDevice(const DeviceInfo& device)
+{
+    {
+        const juce::ScopedLock lock(pendingLock);
+        ++dispatchStats.posted;
+
+        // Repeated advertisements from one device collapse into its latest RSSI/name
+        for (auto& pending : pendingDevices)
+        {
+            if (pending.id == device.id)
+            {
+                pending = device;
+                ++dispatchStats.coalesced;
+                return;
+            }
+        }
+
+        if (pendingDevices.size() >= MAX_PENDING_DEVICES)
+        {
+            ++dispatchStats.dropped; // still recorded in getDevicesSnapshot()
+            return;
+        }
+
+        pendingDevices.add(device);
+    }
+
+    triggerAsyncUpdate();
+}
+
+void HeartSyncBLEClient::postPermission(const juce::String& state)
+{
+    {
+        const juce::ScopedLock lock(pendingLock);
+        ++dispatchStats.posted;
+
+        if (pendingPermission.isNotEmpty())
+            ++dispatchStats.coalesced;
+
+        pendingPermission = state;
+    }
+
+    triggerAsyncUpdate();
+}
+
+void HeartSyncBLEClient::handleAsyncUpdate()
+{
+    juce::String permission;
+    bool ringChanged = false;
+    const BiometricSharedRing* ring = nullptr;
+
+    {
+        const juce::ScopedLock lock(pendingLock);
+        std::swap(pendingEvents, deliveredEvents);
+        pendingDevices.swapWith(deliveredDevices);
+        pendingLogs.swapWith(deliveredLogs);
+        std::swap(pendingPermission, permission);
+        std::swap(sharedRingChangePending, ringChanged);
+        ring = pendingSharedRing;
+        ++dispatchStats.batches;
+        dispatchStats.delivered += deliveredEvents.size() + (size_t)deliveredDevices.size()
+                                 + (size_t)deliveredLogs.size() + (permission.isNotEmpty() ? 1 : 0)
+                                 + (ringChanged ? 1 : 0);
+    }
+
+    if (onLog)
+        for (const auto& line : deliveredLogs)
+            onLog(line);
+
+    if (permission.isNotEmpty() && onPermissionChanged)
+        onPermissionChanged(permission);
+
+    if (ringChanged && onSharedRingChanged)
+        onSharedRingChanged(ring);
+
+    if (onDeviceFound)
+        for (const auto& device : deliveredDevices)
+            onDeviceFound(device);
+
+    const double dispatchedMs = juce::Time::getMillisecondCounterHiRes();
+
+    // Heart rate and connection events keep their relative order
+    for (const auto& event : deliveredEvents)
+    {
+        switch (event.type)
+        {
+            case PendingEvent::Type::HeartRate:
+                dispatchLatency.record(dispatchedMs - event.timestampMs);
+                if (onHeartRate)
+                    onHeartRate(event.bpm, juce::Array<float>(event.rrIntervalsMs.data(), event.numRrIntervals), event.timestampMs);
+                break;
+
+            case PendingEvent::Type::RrIntervals:
+                if (onRrIntervals)
+                    onRrIntervals(juce::Array<float>(event.rrIntervalsMs.data(), event.numRrIntervals), event.timestampMs);
+                break;
+
+            case PendingEvent::Type::BridgeConnected:
+                if (onBridgeConnected)
+                    onBridgeConnected();
+                break;
+
+            case PendingEvent::Type::BridgeDisconnected:
+                if (onBridgeDisconnected)
+                    onBridgeDisconnected();
+                break;
+
+            case PendingEvent::Type::DeviceConnected:
+                if (onConnected)
+                    onConnected(event.text);
+                break;
+
+            case PendingEvent::Type::DeviceDisconnected:
+                if (onDisconnected)
+                    onDisconnected(event.text);
+                break;
+
+            case PendingEvent::Type::Error:
+                if (onError)
+                    onError(event.text);
+                break;
+
+            case PendingEvent::Type::CommandAcknowledged:
+                if (onCommandAcknowledged)
+                    onCommandAcknowledged(event.requestId, event.ok, event.text);
+                break;
         }
     }
+
+    deliveredEvents.clear();
+    deliveredDevices.clearQuick();
+    deliveredLogs.clearQuick();
+}
+
+HeartSyncBLEClient::DispatchStats HeartSyncBLEClient::getDispatchStats() const
+{
+    const juce::ScopedLock lock(pendingLock);
+    return dispatchStats;
+}
+
+void HeartSyncBLEClient::attachSharedRing(const juce::var& offer)
+{
+    const juce::String name = offer.getProperty("name", juce::String()).toString();
+    std::unique_ptr<BiometricSharedRing> ring;
+    std::string error;
+
+    if (name.isEmpty())
+        error = "offer without a name";
+    else if ((int)sharedRings.size() >= MAX_SHARED_RINGS)
+        error = "mapping limit reached";
+    else
+        ring = BiometricSharedRing::open(name.toStdString(), error);
+
+    juce::var reply = juce::var(new juce::DynamicObject());
+    reply.getDynamicObject()->setProperty("type", "shm");
+    reply.getDynamicObject()->setProperty("name", name);
+    reply.getDynamicObject()->setProperty("on", ring != nullptr);
+
+    if (ring == nullptr)
+    {
+        // Sandboxed hosts may not be allowed to map the bridge's memory; the socket still works
+        dispatchLog("Bridge shared memory unavailable (" + juce::String(error) + "), using the socket");
+        sendCommand(reply);
+        return;
+    }
+
+    dispatchLog("Bridge shared memory attached: " + name + " (" + juce::String((int)ring->getCapacity()) + " records)");
+    sharedRings.push_back(std::move(ring));
+    publishSharedRing(sharedRings.back().get());
+
+    // The bridge moves heart-rate data to the ring once it has our answer
+    sendCommand(reply);
+}
+
+void HeartSyncBLEClient::detachSharedRing()
+{
+    if (activeSharedRing.load(std::memory_order_relaxed) != nullptr)
+        publishSharedRing(nullptr);
+}
+
+void HeartSyncBLEClient::publishSharedRing(const BiometricSharedRing* ring)
+{
+    activeSharedRing.store(ring, std::memory_order_release);
+
+    {
+        const juce::ScopedLock lock(pendingLock);
+        ++dispatchStats.posted;
+
+        if (sharedRingChangePending)
+            ++dispatchStats.coalesced;
+
+        pendingSharedRing = ring;
+        sharedRingChangePending = true;
+    }
+
+    triggerAsyncUpdate();
 }
 
 void HeartSyncBLEClient::processMessage(const juce::var& message)
@@ -498,24 +1404,41 @@ void HeartSyncBLEClient::processMessage(const juce::var& message)
 
     if (type == "bridge_heartbeat")
     {
-        lastHeartbeatTime = juce::Time::getMillisecondCounterHiRes() / 1000.0;
+        const double receivedMs = juce::Time::getMillisecondCounterHiRes();
+        lastHeartbeatTime = receivedMs / 1000.0;
+        bridgeClock.observe((double)message.getProperty("timestamp", 0.0), receivedMs);
     }
     else if (type == "ready")
     {
-        // bridge ready notification only used for logging
+        // Answer to our handshake: the version the bridge will speak
+        const int version = juce::jlimit(1, BridgeProtocol::PROTOCOL_VERSION,
+                                         (int)message.getProperty("version", 1));
+        protocolVersion = version;
+        dispatchLog("Bridge protocol v" + juce::String(version)
+                    + (version >= BridgeProtocol::FIRST_BINARY_VERSION ? " (binary frames)" : " (JSON)"));
+    }
+    else if (type == "shm_offer")
+    {
+        attachSharedRing(message);
+    }
+    else if (type == "ack")
+    {
+        const auto requestId = (uint32_t)(juce::int64)message.getProperty("request_id", 0);
+        const bool ok = message.getProperty("ok", true);
+        const juce::String error = message.getProperty("error", juce::String()).toString();
+        const juce::String commandType = takePendingRequest(requestId);
+
+        if (!ok)
+            dispatchLog("Bridge rejected " + (commandType.isNotEmpty() ? commandType : juce::String("command"))
+                        + " #" + juce::String(requestId) + (error.isNotEmpty() ? ": " + error : juce::String()));
+
+        postEvent(PendingEvent::Type::CommandAcknowledged, error, requestId, ok);
     }
     else if (type == "permission")
     {
         juce::String state = message.getProperty("state", "unknown").toString();
         currentPermissionState = state;
-
-        if (onPermissionChanged)
-        {
-            juce::MessageManager::callAsync([this, state]() {
-                if (onPermissionChanged)
-                    onPermissionChanged(state);
-            });
-        }
+        postPermission(state);
     }
     else if (type == "device_found")
     {
@@ -564,42 +1487,29 @@ void HeartSyncBLEClient::processMessage(const juce::var& message)
                 devices.add(device);
         }
 
-        if (onDeviceFound)
-        {
-            juce::MessageManager::callAsync([this, device]() {
-                if (onDeviceFound)
-                    onDeviceFound(device);
-            });
-        }
+        postDevice(device);
     }
     else if (type == "hr_data")
     {
         const float bpm = (float)message.getProperty("bpm", 0);
-        juce::Array<float> rrIntervals;
+        const double receivedMs = juce::Time::getMillisecondCounterHiRes();
+        const double sourceMs = bridgeClock.toHostMs((double)message.getProperty("timestamp", 0.0), receivedMs);
+        std::array<float, BridgeProtocol::MAX_RR_PER_FRAME> rrIntervals{};
+        int numRrIntervals = 0;
 
-        if (message.hasProperty("rr"))
+        if (auto* arr = message.getProperty("rr", juce::var()).getArray())
         {
-            auto rrVar = message.getProperty("rr", juce::var());
-            if (rrVar.isArray())
+            for (const auto& v : *arr)
             {
-                if (auto* arr = rrVar.getArray())
-                {
-                    for (const auto& v : *arr)
-                    {
-                        if (v.isInt() || v.isInt64() || v.isDouble())
-                            rrIntervals.add((float)v);
-                    }
-                }
+                if ((v.isInt() || v.isInt64() || v.isDouble()) && numRrIntervals < (int)rrIntervals.size())
+                    rrIntervals[(size_t)numRrIntervals++] = (float)v;
             }
         }
 
-        if (onHeartRate)
-        {
-            juce::MessageManager::callAsync([this, bpm, rrIntervals]() {
-                if (onHeartRate)
-                    onHeartRate(bpm, rrIntervals);
-            });
-        }
+        if (message.hasProperty("timestamp"))
+            receiveLatency.record(receivedMs - sourceMs);
+
+        dispatchHeartRate(bpm, rrIntervals.data(), numRrIntervals, sourceMs);
     }
     else if (type == "connected")
     {
@@ -611,13 +1521,7 @@ void HeartSyncBLEClient::processMessage(const juce::var& message)
             currentDeviceId = deviceId;
         }
 
-        if (onConnected)
-        {
-            juce::MessageManager::callAsync([this, deviceId]() {
-                if (onConnected)
-                    onConnected(deviceId);
-            });
-        }
+        postEvent(PendingEvent::Type::DeviceConnected, deviceId);
     }
     else if (type == "disconnected")
     {
@@ -629,25 +1533,12 @@ void HeartSyncBLEClient::processMessage(const juce::var& message)
             currentDeviceId.clear();
         }
 
-        if (onDisconnected)
-        {
-            juce::MessageManager::callAsync([this, reason]() {
-                if (onDisconnected)
-                    onDisconnected(reason);
-            });
-        }
+        postEvent(PendingEvent::Type::DeviceDisconnected, reason);
     }
     else if (type == "error")
     {
         juce::String errorMsg = message.getProperty("message", "Unknown error").toString();
-
-        if (onError)
-        {
-            juce::MessageManager::callAsync([this, errorMsg]() {
-                if (onError)
-                    onError(errorMsg);
-            });
-        }
+        postEvent(PendingEvent::Type::Error, errorMsg);
     }
 }
 
@@ -656,13 +1547,7 @@ void HeartSyncBLEClient::processMessage(const juce::var& message)
 void HeartSyncBLEClient::__debugInjectPermission(const juce::String& state)
 {
     currentPermissionState = state;
-    if (onPermissionChanged)
-    {
-        juce::MessageManager::callAsync([this, state]() {
-            if (onPermissionChanged)
-                onPermissionChanged(state);
-        });
-    }
+    postPermission(state);
 }
 
 void HeartSyncBLEClient::__debugInjectDevice(const juce::String& id, const juce::String& name, int rssi)
@@ -672,13 +1557,7 @@ void HeartSyncBLEClient::__debugInjectDevice(const juce::String& id, const juce:
         const juce::ScopedLock lock(deviceListLock);
         devices.add(device);
     }
-    if (onDeviceFound)
-    {
-        juce::MessageManager::callAsync([this, device]() {
-            if (onDeviceFound)
-                onDeviceFound(device);
-        });
-    }
+    postDevice(device);
 }
 
 void HeartSyncBLEClient::__debugInjectConnected(const juce::String& id)
@@ -688,13 +1567,7 @@ void HeartSyncBLEClient::__debugInjectConnected(const juce::String& id)
         deviceConnected = true;
         currentDeviceId = id;
     }
-    if (onConnected)
-    {
-        juce::MessageManager::callAsync([this, id]() {
-            if (onConnected)
-                onConnected(id);
-        });
-    }
+    postEvent(PendingEvent::Type::DeviceConnected, id);
 }
 
 void HeartSyncBLEClient::__debugInjectDisconnected(const juce::String& reason)
@@ -704,24 +1577,12 @@ void HeartSyncBLEClient::__debugInjectDisconnected(const juce::String& reason)
         deviceConnected = false;
         currentDeviceId.clear();
     }
-    if (onDisconnected)
-    {
-        juce::MessageManager::callAsync([this, reason]() {
-            if (onDisconnected)
-                onDisconnected(reason);
-        });
-    }
+    postEvent(PendingEvent::Type::DeviceDisconnected, reason);
 }
 
 void HeartSyncBLEClient::__debugInjectHr(int bpm)
 {
-    if (onHeartRate)
-    {
-        juce::MessageManager::callAsync([this, bpm]() {
-            if (onHeartRate)
-                onHeartRate((float)bpm, {});
-        });
-    }
+    postHeartRate(PendingEvent::Type::HeartRate, (float)bpm, nullptr, 0, juce::Time::getMillisecondCounterHiRes());
 }
 #endif
 
@@ -732,16 +1593,20 @@ HeartSyncBLEClient::~HeartSyncBLEClient() = default;
 void HeartSyncBLEClient::connectToBridge() {}
 void HeartSyncBLEClient::disconnect() {}
 void HeartSyncBLEClient::launchBridge() {}
-void HeartSyncBLEClient::startScan(bool) {}
-void HeartSyncBLEClient::connectToDevice(const juce::String&) {}
-void HeartSyncBLEClient::disconnectDevice() {}
+uint32_t HeartSyncBLEClient::startScan(bool) { return 0; }
+uint32_t HeartSyncBLEClient::connectToDevice(const juce::String&) { return 0; }
+uint32_t HeartSyncBLEClient::disconnectDevice() { return 0; }
+uint32_t HeartSyncBLEClient::setEcgStreaming(bool) { return 0; }
 juce::Array<HeartSyncBLEClient::DeviceInfo> HeartSyncBLEClient::getDevicesSnapshot() { return {}; }
 juce::String HeartSyncBLEClient::getCurrentDeviceId() const { return {}; }
 void HeartSyncBLEClient::run() {}
-void HeartSyncBLEClient::sendCommand(const juce::var&) {}
+uint32_t HeartSyncBLEClient::sendCommand(const juce::var&) { return 0; }
 void HeartSyncBLEClient::processMessage(const juce::var&) {}
 bool HeartSyncBLEClient::connectToSocket() { return false; }
 void HeartSyncBLEClient::attemptReconnect() {}
-void HeartSyncBLEClient::checkHeartbeat() {}
+void HeartSyncBLEClient::handleAsyncUpdate() {}
+HeartSyncBLEClient::DispatchStats HeartSyncBLEClient::getDispatchStats() const { return {}; }
+HeartSyncBLEClient::ReconnectStats HeartSyncBLEClient::getReconnectStats() const { return {}; }
+void HeartSyncBLEClient::resetLatencyStats() {}
 
-#endif // JUCE_MAC
+#endif // HEARTSYNC_HAS_BRIDGE_CLIENT
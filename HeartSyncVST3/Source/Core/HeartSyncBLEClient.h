@@ -6,16 +6,38 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <functional>
 #include <vector>
+#include <array>
 #include <atomic>
+#include <deque>
+#include <memory>
+#include "BridgeProtocol.h"
+#include "BiometricSharedRing.h"
+#include "BridgeSocketWatcher.h"
+#include "LatencyHistogram.h"
+
+/** The bridge client is built on macOS and Linux; elsewhere its methods are stubs. */
+#if JUCE_MAC || JUCE_LINUX
+ #define HEARTSYNC_HAS_BRIDGE_CLIENT 1
+#else
+ #define HEARTSYNC_HAS_BRIDGE_CLIENT 0
+#endif
 
 /**
  * @brief UDS client for communicating with the HeartSync Bridge helper.
  *
- * Connects to ~/Library/Application Support/HeartSync/bridge.sock using a
- * length-prefixed JSON protocol. The helper owns all CoreBluetooth access so
- * the plugin can run inside sandboxed hosts without additional entitlements.
+ * Connects to ~/Library/Application Support/HeartSync/bridge.sock on macOS
+ * or $XDG_RUNTIME_DIR/heartsync/bridge.sock on Linux (HEARTSYNC_BRIDGE_SOCKET
+ * overrides both) using the length-prefixed protocol in BridgeProtocol.h.
+ * The helper owns all CoreBluetooth access so the plugin can run inside
+ * sandboxed hosts without additional entitlements.
+ *
+ * Socket I/O runs on one background thread; commands may be sent from any
+ * thread and callbacks are delivered in batches on the message thread.
+ * Heart rate arrives through the shared ring from getSharedRing() when the
+ * bridge offers one (see BiometricSharedRing.h), otherwise over the socket.
  */
-class HeartSyncBLEClient : private juce::Thread
+class HeartSyncBLEClient : private juce::Thread,
+                           private juce::AsyncUpdater
 {
 public:
     struct DeviceInfo
@@ -62,7 +84,7 @@ public:
 
     using PermissionCallback = std::function<void(const juce::String& state)>;
     using DeviceFoundCallback = std::function<void(const DeviceInfo&)>;
-    using HeartRateCallback = std::function<void(float bpm, juce::Array<float> rr)>;
+    using HeartRateCallback = std::function<void(float bpm, juce::Array<float> rr, double timestampMs)>;
     using StatusCallback = std::function<void(const juce::String& status)>;
     using ErrorCallback = std::function<void(const juce::String& error)>;
 
@@ -72,22 +94,79 @@ public:
     void connectToBridge();
     void disconnect();
     bool isConnected() const { return connected.load(); }
+    int getProtocolVersion() const { return protocolVersion.load(); } // 0 until the bridge answered the handshake
+
+    struct DispatchStats
+    {
+        uint64_t posted{0};      // events queued for the message thread
+        uint64_t delivered{0};   // callbacks invoked (after coalescing)
+        uint64_t coalesced{0};   // replaced by a newer value before delivery
+        uint64_t dropped{0};     // discarded because a bounded queue was full
+        uint64_t batches{0};     // message-thread wake-ups
+    };
+
+    DispatchStats getDispatchStats() const;
+
+    /** Time from losing the bridge to having it back (socket connected again). */
+    struct ReconnectStats
+    {
+        uint64_t reconnects{0};
+        uint64_t viaWatch{0};        // woken by the socket directory watch rather than the retry timer
+        double lastMs{0.0};
+        double maxMs{0.0};
+        double totalMs{0.0};
+    };
+
+    ReconnectStats getReconnectStats() const;
+
+    /**
+     * Age of each heart-rate sample, measured from its source timestamp, when
+     * the socket thread decoded it and when its callback ran on the message
+     * thread. Histograms are lock-free; read them from any thread.
+     */
+    const LatencyHistogram& getReceiveLatency() const { return receiveLatency; }
+    const LatencyHistogram& getDispatchLatency() const { return dispatchLatency; }
+    void resetLatencyStats();
+
+    /**
+     * The attached shared-memory ring, or nullptr while biometrics come over
+     * the socket. Any thread; a returned ring stays mapped until the client
+     * is destroyed, even after the bridge goes away.
+     */
+    const BiometricSharedRing* getSharedRing() const { return activeSharedRing.load(std::memory_order_acquire); }
     void launchBridge();
     void resetReconnectAttempts() { reconnectAttempts = 0; }
 
-    void startScan(bool enable);
-    void connectToDevice(const juce::String& deviceId);
-    void disconnectDevice();
+    // Commands return the request id matched by onCommandAcknowledged, or 0
+    // when nothing was queued (not connected, or the queue is full)
+    uint32_t startScan(bool enable);
+    uint32_t connectToDevice(const juce::String& deviceId);
+    uint32_t disconnectDevice();
+    uint32_t setEcgStreaming(bool enable);
     juce::Array<DeviceInfo> getDevicesSnapshot();
     bool isDeviceConnected() const { return deviceConnected.load(); }
     juce::String getCurrentDeviceId() const;
 
     std::function<void(const juce::String&)> onPermissionChanged;
     std::function<void(const DeviceInfo&)> onDeviceFound;
-    std::function<void(float, juce::Array<float>)> onHeartRate;
+    // timestampMs is the sample's source time on the juce::Time::getMillisecondCounterHiRes()
+    // clock: the bridge timestamp mapped through the clock-offset estimate, or the
+    // receive time when the bridge sent none. Never decreases, never exceeds receive time.
+    std::function<void(float, juce::Array<float>, double)> onHeartRate;
+    // RR intervals sent without a heart-rate value (binary RrIntervals frames)
+    std::function<void(juce::Array<float>, double)> onRrIntervals;
+    // Raw ECG in microvolts. Called directly on the socket thread (not via the
+    // message thread) so a 130 Hz stream never queues up on the message loop;
+    // handlers must not block. discontinuity is set after lost frames.
+    std::function<void(const float* samples, int numSamples, double sampleRateHz,
+                       bool discontinuity, double timestampMs)> onEcgSamples;
+    // Called on the message thread when the shared-memory ring is attached or dropped (nullptr)
+    std::function<void(const BiometricSharedRing*)> onSharedRingChanged;
     std::function<void(const juce::String&)> onConnected;
     std::function<void(const juce::String&)> onDisconnected;
     std::function<void(const juce::String&)> onError;
+    // Bridge acknowledgement of a command (message thread); error is empty when ok
+    std::function<void(uint32_t requestId, bool ok, const juce::String& error)> onCommandAcknowledged;
     std::function<void()> onBridgeConnected;
     std::function<void()> onBridgeDisconnected;
     std::function<void(const juce::String&)> onLog;
@@ -101,17 +180,69 @@ public:
 #endif
 
 private:
+    struct PendingEvent
+    {
+        enum class Type
+        {
+            HeartRate,
+            RrIntervals,
+            BridgeConnected,
+            BridgeDisconnected,
+            DeviceConnected,
+            DeviceDisconnected,
+            Error,
+            CommandAcknowledged
+        };
+
+        Type type{Type::HeartRate};
+        float bpm{0.0f};
+        double timestampMs{0.0};
+        int numRrIntervals{0};
+        std::array<float, BridgeProtocol::MAX_RR_PER_FRAME> rrIntervalsMs{};
+        juce::String text;              // device id, reason or error
+        uint32_t requestId{0};
+        bool ok{true};
+    };
+
     void run() override;
-    void sendCommand(const juce::var& command);
+    void handleAsyncUpdate() override;
+    void postHeartRate(PendingEvent::Type type, float bpm, const float* rrIntervalsMs, int numRrIntervals, double timestampMs);
+    void postEvent(PendingEvent::Type type, const juce::String& text = {}, uint32_t requestId = 0, bool ok = true);
+    void queueEvent(PendingEvent&& event);
+    void postDevice(const DeviceInfo& device);
+    void postPermission(const juce::String& state);
+    void runEventLoop();
+    bool readFromSocket();
+    void handlePayload(const uint8_t* payload, size_t size);
+    bool hasPendingOutput() const;
+    void collectQueuedCommands();
+    bool flushOutgoing();
+    void discardOutgoing();
+    void rememberPendingRequest(uint32_t requestId, const juce::String& type);
+    juce::String takePendingRequest(uint32_t requestId);
+    void closeConnection(bool notifyListeners);
+    void wakeEventLoop();
+    void drainWakePipe();
+    uint32_t sendCommand(const juce::var& command);
     void processMessage(const juce::var& message);
+    void processBinaryFrame(const uint8_t* payload, size_t size);
+    void dispatchHeartRate(float bpm, const float* rrIntervalsMs, int numRrIntervals, double sourceMs);
+    void attachSharedRing(const juce::var& offer);
+    void detachSharedRing();
+    void publishSharedRing(const BiometricSharedRing* ring);
     bool connectToSocket();
     void attemptReconnect();
-    void checkHeartbeat();
+    void buildSocketCandidates();
+    bool waitForBridgeSocket(int timeoutMs);
+    void rememberSocketPath(const juce::String& path);
+    void recordReconnect(bool viaWatch);
+    static juce::File getLastSocketPathFile();
     void dispatchLog(const juce::String& message);
 
     int socketFd{-1};
     std::atomic<bool> connected{false};
     std::atomic<bool> shouldReconnect{false};
+    std::atomic<int> protocolVersion{0};
 
     std::atomic<bool> deviceConnected{false};
     juce::String currentDeviceId;
@@ -120,6 +251,67 @@ private:
     juce::CriticalSection deviceListLock;
     juce::Array<DeviceInfo> devices;
 
+    int wakePipe[2]{-1, -1};
+
+    // Outbound commands. Producers push onto a lock-free stack; the event loop
+    // takes the whole stack at once, restores FIFO order and serialises.
+    struct OutgoingCommand
+    {
+        juce::var command;
+        uint32_t requestId{0};
+        juce::MemoryBlock frame;
+        OutgoingCommand* next{nullptr};
+    };
+
+    struct PendingRequest
+    {
+        uint32_t requestId{0};
+        juce::String type;
+    };
+
+    static constexpr int MAX_QUEUED_COMMANDS = 256;
+    static constexpr int MAX_WRITE_BATCH = 64;
+    static constexpr int MAX_PENDING_REQUESTS = 32;
+
+    std::atomic<OutgoingCommand*> incomingCommands{nullptr};
+    std::atomic<int> queuedCommandCount{0};
+    std::atomic<uint32_t> nextRequestId{1};
+    std::deque<std::unique_ptr<OutgoingCommand>> sendQueue;   // event loop only
+    size_t sendOffset{0};                                     // bytes of sendQueue.front() already written
+    std::array<PendingRequest, MAX_PENDING_REQUESTS> pendingRequests;
+    int nextPendingRequest{0};
+
+    // Receive path (socket thread only); buffers are sized once so decoding never allocates
+    BridgeProtocol::StreamDecoder streamDecoder;
+    BridgeProtocol::HeartRateFrame heartRateFrame;
+    std::vector<float> ecgScratch;
+    uint32_t expectedEcgSequence{0};
+    bool ecgSequenceValid{false};
+
+    // Mappings are only released in the destructor: readers on other threads
+    // may still hold a ring after the bridge has gone away
+    std::vector<std::unique_ptr<BiometricSharedRing>> sharedRings;
+    std::atomic<const BiometricSharedRing*> activeSharedRing{nullptr};
+    static constexpr int MAX_SHARED_RINGS = 8;
+
+    // Message-thread delivery (see handleAsyncUpdate)
+    static constexpr int MAX_PENDING_EVENTS = 128;
+    static constexpr int MAX_PENDING_DEVICES = 64;
+    static constexpr int MAX_PENDING_LOGS = 64;
+
+    mutable juce::CriticalSection pendingLock;
+    std::vector<PendingEvent> pendingEvents;
+    juce::Array<DeviceInfo> pendingDevices;
+    juce::StringArray pendingLogs;
+    juce::String pendingPermission;
+    const BiometricSharedRing* pendingSharedRing{nullptr};
+    bool sharedRingChangePending{false};
+    DispatchStats dispatchStats;
+
+    std::vector<PendingEvent> deliveredEvents;   // message thread only; swapped with the pending queues
+    juce::Array<DeviceInfo> deliveredDevices;
+    juce::StringArray deliveredLogs;
+
     juce::String currentPermissionState{"unknown"};
     double lastHeartbeatTime{0.0};
 
@@ -127,5 +319,42 @@ private:
     int lastLoggedFailureAttempt{-1};
     static constexpr int MAX_RECONNECT_ATTEMPTS = 10;
 
+    // Socket discovery (socket thread only)
+    static constexpr int CANDIDATE_REFRESH_ATTEMPTS = 20;   // rescan for new containers/dirs this often
+    static constexpr int WATCH_CONNECT_RETRIES = 5;         // bind() precedes listen(); allow a moment
+    juce::StringArray socketCandidates;
+    juce::String lastSocketPath;
+    bool lastSocketPathLoaded{false};
+    BridgeSocketWatcher socketWatcher;
+    double disconnectedAtMs{0.0};                           // 0 while connected or never connected
+
+    ReconnectStats reconnectStats;                          // guarded by pendingLock
+
+    /**
+     * Maps bridge timestamps (any clock, in seconds) onto the host's
+     * millisecond counter. The offset is the smallest receive-minus-send
+     * difference over the last two windows: the least-delayed message bounds
+     * the clock offset, and rolling windows follow drift and clock steps.
+     * Socket thread only.
+     */
+    struct BridgeClockMapper
+    {
+        void observe(double bridgeSeconds, double receivedMs);
+        double toHostMs(double bridgeSeconds, double receivedMs);
+        void reset() { *this = {}; }
+
+        static constexpr double WINDOW_MS = 10000.0;
+
+        double currentMinMs{0.0};
+        double previousMinMs{0.0};
+        double windowStartMs{0.0};
+        double lastSourceMs{0.0};
+        bool valid{false};
+    };
+
+    BridgeClockMapper bridgeClock;
+    LatencyHistogram receiveLatency;
+    LatencyHistogram dispatchLatency;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HeartSyncBLEClient)
 };
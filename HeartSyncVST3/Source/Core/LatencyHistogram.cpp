@@ -0,0 +1,107 @@
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+void LatencyHistogram::record(double latencyMs)
+{
+    latencyMs = std::max(0.0, latencyMs);
+
+    buckets[(size_t)bucketFor(latencyMs)].fetch_add(1, std::memory_order_relaxed);
+
+    const auto micros = (uint64_t)std::llround(std::min(latencyMs, 1.0e9) * 1000.0);
+    totalMicros.fetch_add(micros, std::memory_order_relaxed);
+
+    auto currentMax = maxMicros.load(std::memory_order_relaxed);
+    while (micros > currentMax
+           && ! maxMicros.compare_exchange_weak(currentMax, micros, std::memory_order_relaxed))
+    {
+    }
+}
+
+LatencyHistogram::Summary LatencyHistogram::getSummary() const
+{
+    std::array<uint64_t, NUM_BUCKETS> counts;
+    uint64_t total = 0;
+
+    for (int i = 0; i < NUM_BUCKETS; ++i)
+    {
+        counts[(size_t)i] = buckets[(size_t)i].load(std::memory_order_relaxed);
+        total += counts[(size_t)i];
+    }
+
+    Summary summary;
+    if (total == 0)
+        return summary;
+
+    summary.count = total;
+    summary.meanMs = (double)totalMicros.load(std::memory_order_relaxed) / 1000.0 / (double)total;
+    summary.maxMs = (double)maxMicros.load(std::memory_order_relaxed) / 1000.0;
+    summary.p50Ms = percentileFrom(counts, total, 50.0);
+    summary.p95Ms = percentileFrom(counts, total, 95.0);
+    summary.p99Ms = percentileFrom(counts, total, 99.0);
+    return summary;
+}
+
+double LatencyHistogram::getPercentile(double percentile) const
+{
+    std::array<uint64_t, NUM_BUCKETS> counts;
+    uint64_t total = 0;
+
+    for (int i = 0; i < NUM_BUCKETS; ++i)
+    {
+        counts[(size_t)i] = buckets[(size_t)i].load(std::memory_order_relaxed);
+        total += counts[(size_t)i];
+    }
+
+    return total > 0 ? percentileFrom(counts, total, percentile) : 0.0;
+}
+
+void LatencyHistogram::reset()
+{
+    for (auto& bucket : buckets)
+        bucket.store(0, std::memory_order_relaxed);
+
+    totalMicros.store(0, std::memory_order_relaxed);
+    maxMicros.store(0, std::memory_order_relaxed);
+}
+
+//==============================================================================
+int LatencyHistogram::bucketFor(double latencyMs)
+{
+    if (latencyMs < MIN_MS)
+        return 0;
+
+    const int bucket = 1 + (int)std::floor(std::log2(latencyMs / MIN_MS) * BUCKETS_PER_OCTAVE);
+    return std::min(bucket, NUM_BUCKETS - 1);
+}
+
+double LatencyHistogram::bucketMidpointMs(int bucket)
+{
+    if (bucket == 0)
+        return MIN_MS * 0.5;
+
+    // Geometric centre of [MIN * 2^((b-1)/4), MIN * 2^(b/4))
+    return MIN_MS * std::exp2(((double)bucket - 0.5) / BUCKETS_PER_OCTAVE);
+}
+
+double LatencyHistogram::percentileFrom(const std::array<uint64_t, NUM_BUCKETS>& counts,
+                                        uint64_t total, double percentile) const
+{
+    const double clamped = std::min(100.0, std::max(0.0, percentile));
+    const auto rank = std::max<uint64_t>(1, (uint64_t)std::ceil(clamped / 100.0 * (double)total));
+
+    uint64_t seen = 0;
+    for (int i = 0; i < NUM_BUCKETS; ++i)
+    {
+        seen += counts[(size_t)i];
+        if (seen >= rank)
+        {
+            // The bucket centre can overshoot the largest sample actually seen
+            const double maxMs = (double)maxMicros.load(std::memory_order_relaxed) / 1000.0;
+            return maxMs > 0.0 ? std::min(bucketMidpointMs(i), maxMs) : bucketMidpointMs(i);
+        }
+    }
+
+    return bucketMidpointMs(NUM_BUCKETS - 1);
+}
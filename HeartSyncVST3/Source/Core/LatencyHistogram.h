@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Lock-free latency histogram for the biometric delivery path.
+ *
+ * Buckets are log-spaced at four per octave from 10 µs to a little over two
+ * minutes, so any percentile is reported to within about 9% whatever the
+ * range. record() is lock-free (relaxed atomic increments, no allocation)
+ * and may be called from any number of threads, including the audio
+ * thread; getSummary() can run concurrently and sees a slightly torn but
+ * never corrupt snapshot.
+ */
+class LatencyHistogram
+{
+public:
+    struct Summary
+    {
+        uint64_t count{0};
+        double meanMs{0.0};
+        double p50Ms{0.0};
+        double p95Ms{0.0};
+        double p99Ms{0.0};
+        double maxMs{0.0};
+    };
+
+    LatencyHistogram() = default;
+
+    /** Negative values (clock estimate noise) count as zero. */
+    void record(double latencyMs);
+
+    Summary getSummary() const;
+
+    /** percentile in [0, 100]; 0 when nothing has been recorded. */
+    double getPercentile(double percentile) const;
+
+    /** Not atomic with respect to concurrent record() calls; a few samples may survive. */
+    void reset();
+
+    static constexpr int BUCKETS_PER_OCTAVE = 4;
+    static constexpr int NUM_BUCKETS = 96;
+    static constexpr double MIN_MS = 0.01;     // bucket 0 holds everything below this
+
+private:
+    static int bucketFor(double latencyMs);
+    static double bucketMidpointMs(int bucket);
+    double percentileFrom(const std::array<uint64_t, NUM_BUCKETS>& counts, uint64_t total, double percentile) const;
+
+    std::array<std::atomic<uint64_t>, NUM_BUCKETS> buckets{};
+    std::atomic<uint64_t> totalMicros{0};
+    std::atomic<uint64_t> maxMicros{0};
+};
@@ -0,0 +1,74 @@
+#include "LogMessageQueue.h"
+
+#include <chrono>
+
+LogMessageQueue::LogMessageQueue(size_t capacity)
+{
+    size_t rounded = 2;
+    while (rounded < capacity)
+        rounded <<= 1;
+
+    cells = std::make_unique<Cell[]>(rounded);
+    mask = rounded - 1;
+
+    for (size_t i = 0; i < rounded; ++i)
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+bool LogMessageQueue::push(Severity severity, std::string text)
+{
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+
+    for (;;)
+    {
+        cell = &cells[pos & mask];
+        const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto diff = (std::ptrdiff_t)sequence - (std::ptrdiff_t)pos;
+
+        if (diff == 0)
+        {
+            // The cell is free for this lap; claim it
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+        {
+            // The consumer has not freed this cell yet: the queue is full
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        else
+        {
+            // Another producer claimed it first
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->message.severity = severity;
+    cell->message.text = std::move(text);
+    cell->message.timeMs = (int64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+size_t LogMessageQueue::drain(std::vector<Message>& batch, size_t maxMessages)
+{
+    size_t drained = 0;
+
+    while (drained < maxMessages)
+    {
+        Cell& cell = cells[dequeuePos & mask];
+        if (cell.sequence.load(std::memory_order_acquire) != dequeuePos + 1)
+            break;   // empty, or the producer that claimed this cell is still writing
+
+        batch.push_back(std::move(cell.message));
+        cell.sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+        ++dequeuePos;
+        ++drained;
+    }
+
+    return drained;
+}
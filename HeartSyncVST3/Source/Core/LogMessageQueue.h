@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Bounded lock-free queue of log lines, many producers to one consumer.
+ *
+ * The processor logs from the message thread, host threads and the bridge
+ * client; the editor drains whatever has accumulated once per UI tick and
+ * hands the batch to its terminal view, instead of bouncing every line
+ * through MessageManager::callAsync.
+ *
+ * Cells carry their own sequence numbers (Vyukov's bounded queue), so
+ * push() never blocks and never waits for a slow consumer: when the queue
+ * is full the new line is dropped and counted. Lines queued while no
+ * editor is open are kept until one drains them or the queue fills.
+ */
+class LogMessageQueue
+{
+public:
+    enum class Severity
+    {
+        Debug,
+        Info,
+        Warning,
+        Error
+    };
+
+    struct Message
+    {
+        Severity severity{Severity::Info};
+        std::string text;
+        int64_t timeMs{0};      // wall clock, milliseconds since the Unix epoch
+    };
+
+    explicit LogMessageQueue(size_t capacity = DEFAULT_CAPACITY);
+
+    /** Any thread. Returns false (and counts the line as dropped) when full. */
+    bool push(Severity severity, std::string text);
+
+    /** Consumer only. Appends up to maxMessages lines to batch, oldest first; returns how many. */
+    size_t drain(std::vector<Message>& batch, size_t maxMessages = SIZE_MAX);
+
+    uint64_t getNumDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+    static constexpr size_t DEFAULT_CAPACITY = 512;
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence{0};
+        Message message;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+    alignas(64) std::atomic<size_t> enqueuePos{0};
+    alignas(64) size_t dequeuePos{0};
+    std::atomic<uint64_t> dropped{0};
+};
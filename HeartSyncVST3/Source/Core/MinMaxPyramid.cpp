@@ -0,0 +1,125 @@
+#include "MinMaxPyramid.h"
+
+#include <algorithm>
+
+void MinMaxPyramid::Range::include(float lo, float hi)
+{
+    if (! valid)
+    {
+        min = lo;
+        max = hi;
+        valid = true;
+        return;
+    }
+
+    min = std::min(min, lo);
+    max = std::max(max, hi);
+}
+
+//==============================================================================
+MinMaxPyramid::MinMaxPyramid(size_t capacityToUse)
+    : levels(1), capacity(std::max<size_t>(capacityToUse, 2))
+{
+}
+
+void MinMaxPyramid::append(float value)
+{
+    if (levels.front().size() >= capacity)
+    {
+        // Keep the newest half; rebuilding is O(n) once per capacity / 2 appends
+        std::vector<float> kept(levels.front().end() - (std::ptrdiff_t)(capacity / 2), levels.front().end());
+        discarded += levels.front().size() - kept.size();
+        levels.assign(1, {});
+        levels.front().reserve(capacity);
+
+        for (const float sample : kept)
+            append(sample);
+    }
+
+    levels.front().push_back(value);
+
+    // Summarise every block this sample completed, bottom up
+    for (size_t level = 0; (levels[level].size() / (level == 0 ? 1 : 2)) % 2 == 0; ++level)
+        summarise(level);
+}
+
+void MinMaxPyramid::summarise(size_t level)
+{
+    if (levels.size() == level + 1)
+        levels.emplace_back();
+
+    const auto& below = levels[level];
+    auto& above = levels[level + 1];
+
+    if (level == 0)
+    {
+        const size_t last = below.size() - 1;
+        above.push_back(std::min(below[last - 1], below[last]));
+        above.push_back(std::max(below[last - 1], below[last]));
+    }
+    else
+    {
+        const size_t last = below.size() - 2;   // min of the newest block; max follows
+        above.push_back(std::min(below[last - 2], below[last]));
+        above.push_back(std::max(below[last - 1], below[last + 1]));
+    }
+}
+
+void MinMaxPyramid::clear()
+{
+    levels.assign(1, {});
+    discarded = 0;
+}
+
+//==============================================================================
+MinMaxPyramid::Range MinMaxPyramid::getRange(size_t begin, size_t end) const
+{
+    Range range;
+    end = std::min(end, size());
+
+    // Bottom-up over the implicit tree: peel off unpaired blocks at each
+    // level, then move to the parent level. Every block visited above level 0
+    // lies inside [begin, end), so it is complete and already summarised.
+    size_t level = 0;
+    while (begin < end)
+    {
+        auto take = [&](size_t block)
+        {
+            if (level == 0)
+                range.include(levels[0][block], levels[0][block]);
+            else
+                range.include(levels[level][2 * block], levels[level][2 * block + 1]);
+        };
+
+        if (level + 1 >= levels.size())
+        {
+            for (; begin < end; ++begin)
+                take(begin);
+            break;
+        }
+
+        if (begin & 1)
+            take(begin++);
+        if (end & 1)
+            take(--end);
+
+        begin >>= 1;
+        end >>= 1;
+        ++level;
+    }
+
+    return range;
+}
+
+void MinMaxPyramid::getColumns(size_t firstColumn, size_t numColumns, size_t samplesPerColumn,
+                               std::vector<Range>& out) const
+{
+    out.resize(numColumns);
+    samplesPerColumn = std::max<size_t>(samplesPerColumn, 1);
+
+    for (size_t c = 0; c < numColumns; ++c)
+    {
+        const size_t begin = (firstColumn + c) * samplesPerColumn;
+        out[c] = begin < size() ? getRange(begin, begin + samplesPerColumn) : Range{};
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Append-only sample history with a min/max pyramid for decimated drawing.
+ *
+ * Level 0 holds the samples; level k holds the min and max of each complete
+ * block of 2^k samples. Appending is O(1) amortized (a block is summarised
+ * when its last sample arrives), getRange() over any span is O(log n) and
+ * getColumns() summarises a whole plot, one entry per pixel column, in
+ * O(columns * log samplesPerColumn) however long the history is.
+ *
+ * Memory is bounded: once capacity samples are stored, the oldest half is
+ * discarded and the pyramid rebuilt, so indices restart at the retained
+ * samples (check getNumDiscarded() to keep a timeline continuous).
+ *
+ * Not thread-safe; owned by one thread (the message thread for the editor).
+ */
+class MinMaxPyramid
+{
+public:
+    struct Range
+    {
+        float min{0.0f};
+        float max{0.0f};
+        bool valid{false};
+
+        void include(float lo, float hi);
+    };
+
+    explicit MinMaxPyramid(size_t capacity = DEFAULT_CAPACITY);
+
+    void append(float value);
+    void clear();
+
+    size_t size() const { return levels.front().size(); }
+    bool isEmpty() const { return levels.front().empty(); }
+    float valueAt(size_t index) const { return levels.front()[index]; }
+    float back() const { return levels.front().back(); }
+
+    /** Samples dropped by capacity trimming since construction or clear(). */
+    size_t getNumDiscarded() const { return discarded; }
+
+    /** Min and max of samples [begin, end). */
+    Range getRange(size_t begin, size_t end) const;
+
+    /**
+     * Fills out with numColumns ranges; column c covers samples
+     * [(firstColumn + c) * samplesPerColumn, (firstColumn + c + 1) * samplesPerColumn),
+     * clipped to the stored samples (columns past the end are invalid).
+     * Columns are aligned to absolute sample positions, so they do not
+     * shimmer as the history grows.
+     */
+    void getColumns(size_t firstColumn, size_t numColumns, size_t samplesPerColumn, std::vector<Range>& out) const;
+
+    static constexpr size_t DEFAULT_CAPACITY = size_t(1) << 18;   // over 7 hours at 10 samples/s
+
+private:
+    void summarise(size_t level);
+
+    // levels[0]: samples; levels[k > 0]: interleaved min, max per 2^k block
+    std::vector<std::vector<float>> levels;
+    size_t capacity;
+    size_t discarded{0};
+};
@@ -0,0 +1,88 @@
+#include "PoincareStats.h"
+
+#include <algorithm>
+#include <cmath>
+
+void PoincareStats::add(const Pair& pair)
+{
+    const double x = pair.rrMs, y = pair.nextRrMs;
+
+    if (count == WINDOW)
+    {
+        const auto& oldest = pairs[next];
+        const double ox = oldest.rrMs, oy = oldest.nextRrMs;
+        sumX -= ox;
+        sumY -= oy;
+        sumDiff -= oy - ox;
+        sumDiffSq -= (oy - ox) * (oy - ox);
+        sumSum -= ox + oy;
+        sumSumSq -= (ox + oy) * (ox + oy);
+    }
+    else
+    {
+        ++count;
+    }
+
+    pairs[next] = pair;
+    next = (next + 1) % WINDOW;
+
+    sumX += x;
+    sumY += y;
+    sumDiff += y - x;
+    sumDiffSq += (y - x) * (y - x);
+    sumSum += x + y;
+    sumSumSq += (x + y) * (x + y);
+
+    if (++sinceRebuild >= WINDOW)
+        rebuildSums();
+}
+
+void PoincareStats::clear()
+{
+    next = 0;
+    count = 0;
+    rebuildSums();
+}
+
+const PoincareStats::Pair& PoincareStats::getPair(size_t index) const
+{
+    return pairs[(next + WINDOW - count + index) % WINDOW];
+}
+
+PoincareStats::Result PoincareStats::getResult() const
+{
+    Result result;
+    if (count < MIN_PAIRS)
+        return result;
+
+    const double n = (double)count;
+    const auto sampleVariance = [n](double sum, double sumSq)
+    {
+        return std::max(0.0, (sumSq - sum * sum / n) / (n - 1.0));
+    };
+
+    result.meanRrMs = sumX / n;
+    result.meanNextRrMs = sumY / n;
+    result.sd1Ms = std::sqrt(sampleVariance(sumDiff, sumDiffSq) / 2.0);
+    result.sd2Ms = std::sqrt(sampleVariance(sumSum, sumSumSq) / 2.0);
+    result.valid = true;
+    return result;
+}
+
+void PoincareStats::rebuildSums()
+{
+    sumX = sumY = sumDiff = sumDiffSq = sumSum = sumSumSq = 0.0;
+    sinceRebuild = 0;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto& pair = getPair(i);
+        const double x = pair.rrMs, y = pair.nextRrMs;
+        sumX += x;
+        sumY += y;
+        sumDiff += y - x;
+        sumDiffSq += (y - x) * (y - x);
+        sumSum += x + y;
+        sumSumSq += (x + y) * (x + y);
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+/**
+ * @brief SD1 / SD2 of a Poincaré plot over the last WINDOW beat pairs.
+ *
+ * A pair is (RRn, RRn+1). SD1 is the spread across the identity line
+ * (short-term variability), SD2 the spread along it (long-term). Both come
+ * from running sums of the pair differences and sums, so add() is O(1);
+ * the sums are rebuilt from the held pairs once per WINDOW additions to
+ * keep rounding from accumulating.
+ *
+ * Not thread-safe; owned by one thread (the message thread for the editor).
+ */
+class PoincareStats
+{
+public:
+    struct Pair
+    {
+        float rrMs{0.0f};
+        float nextRrMs{0.0f};
+    };
+
+    struct Result
+    {
+        double meanRrMs{0.0};       // of the first members
+        double meanNextRrMs{0.0};   // of the second members
+        double sd1Ms{0.0};
+        double sd2Ms{0.0};
+        bool valid{false};          // at least MIN_PAIRS pairs held
+    };
+
+    void add(const Pair& pair);
+    void clear();
+
+    size_t size() const { return count; }
+
+    /** Held pairs oldest first, index < size(). */
+    const Pair& getPair(size_t index) const;
+
+    Result getResult() const;
+
+    static constexpr size_t WINDOW = 256;
+    static constexpr size_t MIN_PAIRS = 3;
+
+private:
+    void rebuildSums();
+
+    std::array<Pair, WINDOW> pairs{};
+    size_t next{0};
+    size_t count{0};
+    size_t sinceRebuild{0};
+
+    double sumX{0.0}, sumY{0.0};
+    double sumDiff{0.0}, sumDiffSq{0.0};   // y - x
+    double sumSum{0.0}, sumSumSq{0.0};     // x + y
+};
@@ -0,0 +1,330 @@
+#include "RPeakDetector.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr double pi = 3.141592653589793;
+
+    constexpr double highPassHz = 5.0;
+    constexpr double lowPassHz = 15.0;
+    constexpr double integratorSeconds = 0.150;
+    constexpr double refractorySeconds = 0.200;
+    constexpr double tWaveSeconds = 0.360;
+    constexpr double learningSeconds = 2.0;
+    constexpr double searchBackFactor = 1.66;
+
+    // RBJ cookbook Butterworth sections (Q = 1/sqrt(2))
+    void designSection(double& b0, double& b1, double& b2, double& a1, double& a2,
+                       double cutoffHz, double sampleRate, bool highPass)
+    {
+        const double w0 = 2.0 * pi * std::min(cutoffHz, 0.45 * sampleRate) / sampleRate;
+        const double cosW0 = std::cos(w0);
+        const double alpha = std::sin(w0) / (2.0 * 0.7071067811865476);
+        const double a0 = 1.0 + alpha;
+
+        if (highPass)
+        {
+            b0 = (1.0 + cosW0) / 2.0 / a0;
+            b1 = -(1.0 + cosW0) / a0;
+        }
+        else
+        {
+            b0 = (1.0 - cosW0) / 2.0 / a0;
+            b1 = (1.0 - cosW0) / a0;
+        }
+
+        b2 = b0;
+        a1 = -2.0 * cosW0 / a0;
+        a2 = (1.0 - alpha) / a0;
+    }
+}
+
+RPeakDetector::RPeakDetector()
+{
+    prepare(sampleRate);
+}
+
+void RPeakDetector::prepare(double sampleRateHz)
+{
+    sampleRate = std::clamp(sampleRateHz, 50.0, 2000.0);
+    integratorWidth = std::max(1, (int)std::lround(integratorSeconds * sampleRate));
+    refractorySamples = std::max(1, (int)std::lround(refractorySeconds * sampleRate));
+    tWaveSamples = std::max(refractorySamples, (int)std::lround(tWaveSeconds * sampleRate));
+    learningSamples = std::max(1, (int)std::lround(learningSeconds * sampleRate));
+
+    designSection(highPass.b0, highPass.b1, highPass.b2, highPass.a1, highPass.a2, highPassHz, sampleRate, true);
+    designSection(lowPass.b0, lowPass.b1, lowPass.b2, lowPass.a1, lowPass.a2, lowPassHz, sampleRate, false);
+
+    reset();
+}
+
+void RPeakDetector::reset()
+{
+    highPass.z1 = highPass.z2 = 0.0;
+    lowPass.z1 = lowPass.z2 = 0.0;
+    bandBuffer.fill(0.0f);
+    squared.fill(0.0f);
+    integratorWindow.fill(0.0f);
+    integratorSum = 0.0;
+    integratorPosition = 0;
+    bandHistory.fill(0.0f);
+    slopeHistory.fill(0.0f);
+    sampleIndex = 0;
+
+    candidate = {};
+    candidateActive = false;
+    candidateRising = false;
+    previousIntegrator = 0.0f;
+
+    learning = true;
+    learningMax = 0.0f;
+    learningSum = 0.0;
+    signalLevel = noiseLevel = threshold1 = threshold2 = 0.0f;
+
+    hasLastBeat = false;
+    lastBeat = {};
+    recentRr.fill(0.0);
+    recentRrCount = 0;
+    recentRrPosition = 0;
+    pendingCount = 0;
+}
+
+void RPeakDetector::process(const float* samples, int numSamples)
+{
+    while (numSamples > 0)
+    {
+        const int blockSize = std::min(numSamples, BLOCK_SIZE);
+        processBlock(samples, blockSize);
+        samples += blockSize;
+        numSamples -= blockSize;
+    }
+}
+
+void RPeakDetector::processBlock(const float* samples, int numSamples)
+{
+    constexpr int taps = DERIVATIVE_TAPS - 1;
+    float* band = bandBuffer.data();
+
+    // Band-pass: recursive, so this stage stays scalar
+    for (int i = 0; i < numSamples; ++i)
+        band[taps + i] = lowPass.process(highPass.process(samples[i]));
+
+    // Five-point derivative and squaring over the contiguous block
+    const float derivativeScale = (float)(sampleRate / 8.0);
+    float* sq = squared.data();
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float d = derivativeScale * (2.0f * band[i + 4] + band[i + 3] - band[i + 1] - 2.0f * band[i]);
+        sq[i] = d * d;
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto slot = (size_t)((sampleIndex + i) & (HISTORY_SIZE - 1));
+        bandHistory[slot] = band[taps + i];
+        slopeHistory[slot] = sq[i];
+    }
+
+    // Moving-window integrator feeding the peak picker
+    const double inverseWidth = 1.0 / integratorWidth;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        integratorSum += sq[i] - integratorWindow[(size_t)integratorPosition];
+        integratorWindow[(size_t)integratorPosition] = sq[i];
+        integratorPosition = (integratorPosition + 1) % integratorWidth;
+
+        handleIntegratorSample(sampleIndex + i, (float)std::max(0.0, integratorSum * inverseWidth));
+    }
+
+    // Carry the derivative's history into the next block
+    std::copy(band + numSamples, band + numSamples + taps, band);
+    sampleIndex += numSamples;
+}
+
+void RPeakDetector::handleIntegratorSample(int64_t index, float value)
+{
+    if (learning)
+    {
+        learningMax = std::max(learningMax, value);
+        learningSum += value;
+
+        if (index + 1 >= learningSamples)
+        {
+            signalLevel = learningMax / 3.0f;
+            noiseLevel = (float)(0.5 * learningSum / learningSamples);
+            updateThresholds();
+            learning = false;
+        }
+
+        previousIntegrator = value;
+        return;
+    }
+
+    if (! candidateActive || value > candidate.value)
+    {
+        candidateRising = candidateActive || value > previousIntegrator;
+        candidate.index = index;
+        candidate.value = value;
+        candidateActive = true;
+    }
+    else if (index - candidate.index >= refractorySamples)
+    {
+        // Only genuine local maxima count; a window that started on a falling edge does not
+        if (candidateRising)
+            classifyPeak(locatePeak(candidate.index, candidate.value));
+
+        candidateActive = false;
+    }
+
+    checkSearchBack(index);
+    previousIntegrator = value;
+}
+
+RPeakDetector::Peak RPeakDetector::locatePeak(int64_t index, float value) const
+{
+    // The R wave sits inside the integrator window ending at the integrator peak
+    const int64_t earliest = std::max<int64_t>(0, std::max<int64_t>(sampleIndex - HISTORY_SIZE + 1, index - integratorWidth - (DERIVATIVE_TAPS / 2)));
+    const auto at = [this](const std::array<float, HISTORY_SIZE>& history, int64_t i)
+    {
+        return history[(size_t)(i & (HISTORY_SIZE - 1))];
+    };
+
+    int64_t best = index;
+    float bestMagnitude = -1.0f;
+    float steepest = 0.0f;
+    for (int64_t i = earliest; i <= index; ++i)
+    {
+        const float magnitude = std::abs(at(bandHistory, i));
+        if (magnitude > bestMagnitude)
+        {
+            bestMagnitude = magnitude;
+            best = i;
+        }
+        steepest = std::max(steepest, at(slopeHistory, i));
+    }
+
+    double offset = 0.0;
+    if (best > earliest && best < index)
+    {
+        const double a = std::abs(at(bandHistory, best - 1));
+        const double b = bestMagnitude;
+        const double c = std::abs(at(bandHistory, best + 1));
+        const double denominator = a - 2.0 * b + c;
+        if (denominator < 0.0)
+            offset = std::clamp(0.5 * (a - c) / denominator, -0.5, 0.5);
+    }
+
+    Peak peak;
+    peak.index = index;
+    peak.value = value;
+    peak.slope = std::sqrt(steepest);
+    peak.beatTime = ((double)best + offset) / sampleRate;
+    peak.amplitude = at(bandHistory, best);
+    return peak;
+}
+
+void RPeakDetector::classifyPeak(const Peak& peak)
+{
+    if (hasLastBeat && peak.index - lastBeat.index < refractorySamples)
+        return;
+
+    bool isBeat = peak.value > threshold1;
+
+    // A steep-enough peak shortly after a beat is a beat; a shallow one is the T wave
+    if (isBeat && hasLastBeat && peak.index - lastBeat.index < tWaveSamples && peak.slope < 0.5f * lastBeat.slope)
+        isBeat = false;
+
+    if (isBeat)
+    {
+        signalLevel = 0.125f * peak.value + 0.875f * signalLevel;
+        acceptBeat(peak, false);
+    }
+    else
+    {
+        noiseLevel = 0.125f * peak.value + 0.875f * noiseLevel;
+
+        if (pendingCount == MAX_PENDING_PEAKS)
+        {
+            std::copy(pendingPeaks.begin() + 1, pendingPeaks.end(), pendingPeaks.begin());
+            --pendingCount;
+        }
+        pendingPeaks[(size_t)pendingCount++] = peak;
+    }
+
+    updateThresholds();
+}
+
+void RPeakDetector::acceptBeat(const Peak& peak, bool fromSearchBack)
+{
+    Beat beat;
+    beat.timeSeconds = peak.beatTime;
+    beat.amplitude = peak.amplitude;
+    beat.fromSearchBack = fromSearchBack;
+
+    if (hasLastBeat)
+    {
+        beat.rrMs = (peak.beatTime - lastBeat.beatTime) * 1000.0;
+        recentRr[(size_t)recentRrPosition] = beat.rrMs;
+        recentRrPosition = (recentRrPosition + 1) % RR_AVERAGE_COUNT;
+        recentRrCount = std::min(recentRrCount + 1, RR_AVERAGE_COUNT);
+    }
+
+    lastBeat = peak;
+    hasLastBeat = true;
+    pendingCount = 0;
+
+    if (onBeat)
+        onBeat(beat);
+}
+
+void RPeakDetector::checkSearchBack(int64_t index)
+{
+    if (! hasLastBeat || recentRrCount == 0 || pendingCount == 0)
+        return;
+
+    double averageRrMs = 0.0;
+    for (int i = 0; i < recentRrCount; ++i)
+        averageRrMs += recentRr[(size_t)i];
+    averageRrMs /= recentRrCount;
+
+    const double limit = searchBackFactor * averageRrMs * 0.001 * sampleRate;
+    if ((double)(index - lastBeat.index) <= limit)
+        return;
+
+    int best = -1;
+    for (int i = 0; i < pendingCount; ++i)
+    {
+        const auto& peak = pendingPeaks[(size_t)i];
+        if (peak.value > threshold2 && peak.index - lastBeat.index >= refractorySamples
+            && (best < 0 || peak.value > pendingPeaks[(size_t)best].value))
+            best = i;
+    }
+
+    if (best < 0)
+    {
+        pendingCount = 0; // nothing qualifies; don't rescan the same peaks every sample
+        return;
+    }
+
+    // Peaks after the recovered beat stay candidates for the next search-back
+    std::array<Peak, MAX_PENDING_PEAKS> later{};
+    int laterCount = 0;
+    for (int i = best + 1; i < pendingCount; ++i)
+        later[(size_t)laterCount++] = pendingPeaks[(size_t)i];
+
+    const auto recovered = pendingPeaks[(size_t)best];
+    signalLevel = 0.25f * recovered.value + 0.75f * signalLevel;
+    acceptBeat(recovered, true);
+    updateThresholds();
+
+    std::copy(later.begin(), later.begin() + laterCount, pendingPeaks.begin());
+    pendingCount = laterCount;
+}
+
+void RPeakDetector::updateThresholds()
+{
+    threshold1 = noiseLevel + 0.25f * (signalLevel - noiseLevel);
+    threshold2 = 0.5f * threshold1;
+}
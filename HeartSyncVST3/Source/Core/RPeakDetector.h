@@ -0,0 +1,127 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+
+/**
+ * @brief Streaming Pan–Tompkins QRS detector for raw ECG.
+ *
+ * Signal chain: 5–15 Hz band-pass (two biquads), five-point derivative,
+ * squaring and a 150 ms moving-window integrator. Peaks of the integrated
+ * signal are classified against adaptive signal/noise thresholds with a
+ * 200 ms refractory period, T-wave rejection (slope test within 360 ms) and
+ * search-back when no beat was found for 1.66 average RR intervals.
+ *
+ * Each detected beat is located on the band-passed signal and refined with
+ * parabolic interpolation, so beat times have sub-sample precision. The
+ * filters' group delay is constant and cancels out of RR intervals.
+ *
+ * Samples are processed in fixed blocks; the FIR stages (derivative,
+ * squaring) run as plain loops over contiguous block buffers so the
+ * compiler can vectorise them. Single-threaded (analysis worker).
+ */
+class RPeakDetector
+{
+public:
+    struct Beat
+    {
+        double timeSeconds{0.0};   // sample clock, seconds since reset()
+        double rrMs{0.0};          // 0 for the first beat after a reset
+        float amplitude{0.0f};     // band-passed R amplitude (input units)
+        bool fromSearchBack{false};
+    };
+
+    RPeakDetector();
+
+    void prepare(double sampleRateHz);
+    void reset();
+
+    /** Runs the detector over numSamples samples; onBeat fires for each beat. */
+    void process(const float* samples, int numSamples);
+
+    double getSampleRate() const { return sampleRate; }
+
+    std::function<void(const Beat&)> onBeat;
+
+private:
+    static constexpr int BLOCK_SIZE = 64;
+    static constexpr int DERIVATIVE_TAPS = 5;
+    static constexpr int HISTORY_SIZE = 4096;   // band-passed/slope history, power of two
+    static constexpr int MAX_PENDING_PEAKS = 16;
+    static constexpr int RR_AVERAGE_COUNT = 8;
+
+    struct Biquad
+    {
+        double b0{1.0}, b1{0.0}, b2{0.0}, a1{0.0}, a2{0.0};
+        double z1{0.0}, z2{0.0};
+
+        float process(float x)
+        {
+            const double y = b0 * x + z1;
+            z1 = b1 * x - a1 * y + z2;
+            z2 = b2 * x - a2 * y;
+            return (float)y;
+        }
+    };
+
+    struct Peak
+    {
+        int64_t index{0};        // sample index of the integrator peak
+        float value{0.0f};       // integrator value
+        float slope{0.0f};       // steepest derivative in the QRS window
+        double beatTime{0.0};    // refined R time, seconds
+        float amplitude{0.0f};
+    };
+
+    void processBlock(const float* samples, int numSamples);
+    void handleIntegratorSample(int64_t index, float value);
+    void classifyPeak(const Peak& peak);
+    void acceptBeat(const Peak& peak, bool fromSearchBack);
+    void checkSearchBack(int64_t index);
+    Peak locatePeak(int64_t index, float value) const;
+    void updateThresholds();
+
+    double sampleRate{130.0};
+    int integratorWidth{20};
+    int refractorySamples{26};
+    int tWaveSamples{47};
+    int learningSamples{260};
+
+    // Filter state
+    Biquad highPass, lowPass;
+    std::array<float, BLOCK_SIZE + DERIVATIVE_TAPS - 1> bandBuffer{};   // leading taps carry history
+    std::array<float, BLOCK_SIZE> squared{};
+    std::array<float, HISTORY_SIZE> integratorWindow{};
+    double integratorSum{0.0};
+    int integratorPosition{0};
+
+    // History for beat localisation (indexed by sample index & (HISTORY_SIZE - 1))
+    std::array<float, HISTORY_SIZE> bandHistory{};
+    std::array<float, HISTORY_SIZE> slopeHistory{};
+    int64_t sampleIndex{0};
+
+    // Peak picking
+    Peak candidate;
+    bool candidateActive{false};
+    bool candidateRising{false};
+    float previousIntegrator{0.0f};
+
+    // Adaptive thresholds
+    bool learning{true};
+    float learningMax{0.0f};
+    double learningSum{0.0};
+    float signalLevel{0.0f};
+    float noiseLevel{0.0f};
+    float threshold1{0.0f};
+    float threshold2{0.0f};
+
+    // Beats
+    bool hasLastBeat{false};
+    Peak lastBeat;
+    std::array<double, RR_AVERAGE_COUNT> recentRr{};
+    int recentRrCount{0};
+    int recentRrPosition{0};
+    std::array<Peak, MAX_PENDING_PEAKS> pendingPeaks{};  // noise peaks since the last beat
+    int pendingCount{0};
+};
@@ -0,0 +1,188 @@
+#include "RespirationEstimator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr double twoPi = 6.283185307179586;
+    constexpr double gridStep = 1.0 / RespirationEstimator::SAMPLE_RATE_HZ;
+    constexpr double binSpacingHz = (RespirationEstimator::MAX_FREQUENCY_HZ - RespirationEstimator::MIN_FREQUENCY_HZ)
+                                    / (RespirationEstimator::NUM_BINS - 1);
+
+    constexpr double minIntervalSeconds = 0.3;   // 200 BPM
+    constexpr double maxIntervalSeconds = 2.0;   // 30 BPM
+    constexpr double ectopicTolerance = 0.3;     // relative jump treated as an artefact
+    constexpr double trendTimeConstant = 15.0;   // seconds; removes drift below ~0.01 Hz
+    constexpr double minimumBandPower = 1.0e-10; // s^2, below this there is no RSA to track
+    constexpr int peakNeighbourhood = 3;         // bins either side counted as the peak lobe
+}
+
+RespirationEstimator::RespirationEstimator()
+{
+    for (int k = 0; k < NUM_BINS; ++k)
+    {
+        const double omega = twoPi * binFrequency(k) / SAMPLE_RATE_HZ;
+        rotators[(size_t)k] = std::polar(1.0, -omega);
+        windowShift[(size_t)k] = std::polar(1.0, omega * WINDOW_SIZE);
+    }
+
+    reset();
+}
+
+void RespirationEstimator::reset()
+{
+    beatTime = previousPointTime = 0.0;
+    previousInterval = acceptedInterval = 0.0;
+    beatCount = 0;
+    nextGridTime = 0.0;
+    trend = 0.0;
+    trendPrimed = false;
+    window.fill(0.0);
+    gridIndex = 0;
+    bins.fill({});
+    phasors.fill({ 1.0, 0.0 });
+    recomputeCursor = 0;
+    estimate = {};
+}
+
+bool RespirationEstimator::addInterval(float rrMs)
+{
+    const double interval = rrMs / 1000.0;
+    if (interval < minIntervalSeconds || interval > maxIntervalSeconds)
+        return false;
+
+    // The beat happened either way; only its tachogram value is replaced when it looks ectopic
+    double value = interval;
+    if (acceptedInterval > 0.0 && std::abs(interval - acceptedInterval) > ectopicTolerance * acceptedInterval)
+        value = acceptedInterval;
+    else
+        acceptedInterval = interval;
+
+    // Each interval is placed at its midpoint on the beat clock
+    beatTime += interval;
+    const double pointTime = beatTime - 0.5 * interval;
+
+    if (beatCount++ == 0)
+    {
+        previousPointTime = pointTime;
+        previousInterval = value;
+        nextGridTime = pointTime;
+        return false;
+    }
+
+    bool produced = false;
+    while (nextGridTime <= pointTime)
+    {
+        const double t = (nextGridTime - previousPointTime) / (pointTime - previousPointTime);
+        processGridSample(previousInterval + t * (value - previousInterval));
+        nextGridTime += gridStep;
+        produced = true;
+    }
+
+    previousPointTime = pointTime;
+    previousInterval = value;
+    return produced;
+}
+
+void RespirationEstimator::processGridSample(double value)
+{
+    if (! trendPrimed)
+    {
+        trend = value;
+        trendPrimed = true;
+    }
+
+    trend += (1.0 - std::exp(-gridStep / trendTimeConstant)) * (value - trend);
+    const double x = value - trend;
+
+    const auto slot = (size_t)(gridIndex % WINDOW_SIZE);
+    const double leaving = window[slot];
+    window[slot] = x;
+
+    for (size_t k = 0; k < (size_t)NUM_BINS; ++k)
+    {
+        // X[n] = X[n-1] + x[n] e^{-jwn} - x[n-N] e^{-jw(n-N)}
+        const auto phasor = phasors[k];
+        bins[k] += x * phasor - leaving * (phasor * windowShift[k]);
+        phasors[k] = phasor * rotators[k];
+    }
+
+    ++gridIndex;
+
+    recomputeBin(recomputeCursor);
+    recomputeCursor = (recomputeCursor + 1) % NUM_BINS;
+
+    if (gridIndex >= WINDOW_SIZE)
+        updateEstimate();
+}
+
+void RespirationEstimator::recomputeBin(int bin)
+{
+    const double omega = twoPi * binFrequency(bin) / SAMPLE_RATE_HZ;
+    const long long first = std::max(0LL, gridIndex - WINDOW_SIZE);
+
+    std::complex<double> sum;
+    for (long long i = first; i < gridIndex; ++i)
+        sum += window[(size_t)(i % WINDOW_SIZE)] * std::polar(1.0, -omega * (double)i);
+
+    bins[(size_t)bin] = sum;
+    phasors[(size_t)bin] = std::polar(1.0, -omega * (double)gridIndex);
+}
+
+void RespirationEstimator::updateEstimate()
+{
+    std::array<double, NUM_BINS> magnitude{};
+    double totalPower = 0.0;
+    int peak = 0;
+
+    for (int k = 0; k < NUM_BINS; ++k)
+    {
+        magnitude[(size_t)k] = std::abs(bins[(size_t)k]);
+        totalPower += magnitude[(size_t)k] * magnitude[(size_t)k];
+        if (magnitude[(size_t)k] > magnitude[(size_t)peak])
+            peak = k;
+    }
+
+    const double normalisedPower = totalPower / ((double)WINDOW_SIZE * WINDOW_SIZE * NUM_BINS);
+    if (normalisedPower < minimumBandPower)
+    {
+        estimate.valid = false;
+        return;
+    }
+
+    double lobePower = 0.0;
+    for (int k = std::max(0, peak - peakNeighbourhood); k <= std::min(NUM_BINS - 1, peak + peakNeighbourhood); ++k)
+        lobePower += magnitude[(size_t)k] * magnitude[(size_t)k];
+
+    // Parabolic refinement between neighbouring bins
+    double offset = 0.0;
+    if (peak > 0 && peak < NUM_BINS - 1)
+    {
+        const double a = magnitude[(size_t)peak - 1];
+        const double b = magnitude[(size_t)peak];
+        const double c = magnitude[(size_t)peak + 1];
+        const double denominator = a - 2.0 * b + c;
+        if (denominator < 0.0)
+            offset = std::clamp(0.5 * (a - c) / denominator, -0.5, 0.5);
+    }
+
+    const double frequency = binFrequency(peak) + offset * binSpacingHz;
+
+    // Phase of the RR oscillation at the newest sample; shift by half a cycle so
+    // that phase 0 is the RR minimum (heart-rate peak, around end of inhalation)
+    const double newest = (double)(gridIndex - 1);
+    const double omega = twoPi * binFrequency(peak) / SAMPLE_RATE_HZ;
+    const double cycles = (std::arg(bins[(size_t)peak]) + omega * newest) / twoPi + 0.5;
+
+    estimate.breathsPerMinute = (float)(frequency * 60.0);
+    estimate.confidence = (float)std::clamp(lobePower / totalPower, 0.0, 1.0);
+    estimate.phaseCycles = cycles - std::floor(cycles);
+    estimate.referenceTime = nextGridTime; // time of the sample being processed
+    estimate.valid = true;
+}
+
+double RespirationEstimator::binFrequency(int bin)
+{
+    return MIN_FREQUENCY_HZ + bin * binSpacingHz;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <complex>
+#include <cstddef>
+
+/**
+ * @brief Breathing-rate estimate from RR intervals (respiratory sinus arrhythmia).
+ *
+ * Beats are accumulated into a tachogram (each interval placed at its
+ * midpoint) that is linearly resampled onto an even 4 Hz grid. Each grid
+ * sample is detrended (slow exponential mean removed) and fed to a bank of
+ * sliding DFT bins spaced 0.01 Hz apart across 0.1–0.5 Hz (6–30
+ * breaths/min), each covering a fixed 32 s window. The
+ * strongest bin, refined by parabolic interpolation, gives the breathing
+ * rate; its phase gives the breath phase.
+ *
+ * Cost is bounded: one complex update per bin per grid sample, i.e.
+ * NUM_BINS * 4 updates per second regardless of heart rate. One bin is
+ * recomputed from its window every grid sample so round-off cannot
+ * accumulate. Single-threaded (analysis worker).
+ */
+class RespirationEstimator
+{
+public:
+    static constexpr double SAMPLE_RATE_HZ = 4.0;
+    static constexpr double MIN_FREQUENCY_HZ = 0.1;
+    static constexpr double MAX_FREQUENCY_HZ = 0.5;
+    static constexpr int NUM_BINS = 41;        // 0.01 Hz spacing
+    static constexpr int WINDOW_SIZE = 128;    // 32 s at 4 Hz
+
+    struct Estimate
+    {
+        float breathsPerMinute{0.0f};
+        float confidence{0.0f};     // peak share of in-band power, 0..1
+        double phaseCycles{0.0};    // breath phase at referenceTime, 0..1
+        double referenceTime{0.0};  // beat clock, seconds
+        bool valid{false};
+    };
+
+    RespirationEstimator();
+
+    void reset();
+
+    /**
+     * Adds one RR interval in milliseconds. Returns true when at least one
+     * new grid sample was produced (and the estimate may have changed).
+     */
+    bool addInterval(float rrMs);
+
+    /** Beat clock of the most recent beat, in seconds since reset(). */
+    double getBeatTime() const { return beatTime; }
+
+    const Estimate& getEstimate() const { return estimate; }
+
+    /** Grid samples produced since reset(); the newest WINDOW_SIZE of them stay readable. */
+    long long getNumGridSamples() const { return gridIndex; }
+
+    /** Detrended tachogram value (seconds) of a grid sample still in the window. */
+    double getGridSample(long long index) const { return window[(size_t)(index % WINDOW_SIZE)]; }
+
+private:
+    void processGridSample(double value);
+    void recomputeBin(int bin);
+    void updateEstimate();
+
+    static double binFrequency(int bin);
+
+    // Tachogram
+    double beatTime{0.0};
+    double previousPointTime{0.0};
+    double previousInterval{0.0};
+    double acceptedInterval{0.0};
+    int beatCount{0};
+    double nextGridTime{0.0};
+
+    // Detrending
+    double trend{0.0};
+    bool trendPrimed{false};
+
+    // Sliding DFT bank (absolute phase reference: X = sum x[i] e^{-jw i})
+    std::array<double, WINDOW_SIZE> window{};
+    long long gridIndex{0};
+    std::array<std::complex<double>, NUM_BINS> bins{};
+    std::array<std::complex<double>, NUM_BINS> rotators{};   // e^{-jw}
+    std::array<std::complex<double>, NUM_BINS> phasors{};    // e^{-jw n}
+    std::array<std::complex<double>, NUM_BINS> windowShift{}; // e^{+jw N}
+    int recomputeCursor{0};
+
+    Estimate estimate;
+};
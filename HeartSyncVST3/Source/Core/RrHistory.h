@@ -0,0 +1,39 @@
+#pragma once
+
+#include "SeqlockRing.h"
+
+/**
+ * @brief Versioned history of the beat-to-beat (RR) intervals the analysis
+ * worker accepted.
+ *
+ * Single writer (the analysis thread); readers are wait-free (see
+ * SeqlockRing). Consecutive entries are consecutive beats unless the later
+ * one is marked followsGap (the first beat after a reset or a change of
+ * sensor), so readers can pair neighbours, e.g. for a Poincaré plot.
+ */
+class RrHistory
+{
+public:
+    struct Entry
+    {
+        float rrMs{0.0f};
+        double beatMs{0.0};           // juce::Time::getMillisecondCounterHiRes() timebase
+        bool followsGap{false};       // not the successor of the previous entry
+    };
+
+    static constexpr size_t CAPACITY = 1024;  // about 15 minutes at 70 bpm
+
+    using Ring = SeqlockRing<Entry, CAPACITY>;
+    using Snapshot = Ring::Snapshot;
+
+    /** Writer only. */
+    void push(const Entry& entry) { ring.publish(entry); }
+
+    uint64_t getVersion() const { return ring.getVersion(); }
+
+    /** Entries newer than sinceVersion (0 for everything still held); reuse one Snapshot to avoid allocating. */
+    void read(Snapshot& snapshot, uint64_t sinceVersion = 0) const { ring.read(snapshot, sinceVersion); }
+
+private:
+    Ring ring;
+};
@@ -0,0 +1,114 @@
+#include "RrSpectrogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace
+{
+    constexpr double twoPi = 6.283185307179586;
+    constexpr float referenceDecayDb = 0.25f;     // per column, so the scale recovers after a burst
+    constexpr double powerFloor = 1.0e-20;
+
+    // Colour stops: background black through the theme's teal and gold to red
+    struct Stop
+    {
+        float position;
+        uint8_t r, g, b;
+    };
+
+    constexpr Stop stops[] = {
+        { 0.00f, 0x00, 0x00, 0x00 },
+        { 0.30f, 0x00, 0x3f, 0x3f },
+        { 0.60f, 0x00, 0xf5, 0xd4 },
+        { 0.85f, 0xff, 0xd9, 0x3d },
+        { 1.00f, 0xff, 0x6b, 0x6b },
+    };
+}
+
+RrSpectrogram::RrSpectrogram()
+{
+    for (int i = 0; i < WINDOW_SIZE; ++i)
+    {
+        hann[(size_t)i] = 0.5 - 0.5 * std::cos(twoPi * i / WINDOW_SIZE);
+        twiddles[(size_t)i] = std::polar(1.0, -twoPi * i / WINDOW_SIZE);
+    }
+
+    for (size_t i = 0; i < lut.size(); ++i)
+    {
+        const float t = (float)i / (float)(lut.size() - 1);
+        size_t s = 1;
+        while (s < std::size(stops) - 1 && t > stops[s].position)
+            ++s;
+
+        const auto& a = stops[s - 1];
+        const auto& b = stops[s];
+        const float f = std::clamp((t - a.position) / (b.position - a.position), 0.0f, 1.0f);
+        const auto mix = [f](uint8_t x, uint8_t y) { return (uint32_t)std::lround(x + f * (y - x)); };
+
+        lut[i] = 0xff000000u | (mix(a.r, b.r) << 16) | (mix(a.g, b.g) << 8) | mix(a.b, b.b);
+    }
+}
+
+void RrSpectrogram::addSample(double value)
+{
+    samples[samplePosition] = value;
+    samplePosition = (samplePosition + 1) % WINDOW_SIZE;
+    samplesHeld = std::min(samplesHeld + 1, WINDOW_SIZE);
+
+    if (++sinceColumn >= HOP_SIZE && samplesHeld >= MIN_SAMPLES)
+    {
+        sinceColumn = 0;
+        computeColumn();
+    }
+}
+
+void RrSpectrogram::restart()
+{
+    samples.fill(0.0);
+    samplePosition = 0;
+    samplesHeld = 0;
+    sinceColumn = 0;
+}
+
+uint32_t RrSpectrogram::colourFor(float level) const
+{
+    const auto index = (size_t)std::lround(std::clamp(level, 0.0f, 1.0f) * (float)(lut.size() - 1));
+    return lut[index];
+}
+
+void RrSpectrogram::computeColumn()
+{
+    // Oldest sample first; slots not yet filled since restart() are zero
+    std::array<double, WINDOW_SIZE> windowed;
+    for (size_t i = 0; i < (size_t)WINDOW_SIZE; ++i)
+        windowed[i] = samples[(samplePosition + i) % WINDOW_SIZE] * hann[i];
+
+    std::array<float, NUM_ROWS> powerDb;
+    float columnPeakDb = -1000.0f;
+
+    for (int k = 0; k < NUM_ROWS; ++k)
+    {
+        std::complex<double> sum;
+        size_t phase = 0;
+        for (size_t i = 0; i < (size_t)WINDOW_SIZE; ++i)
+        {
+            sum += windowed[i] * twiddles[phase];
+            phase = (phase + (size_t)k) % WINDOW_SIZE;
+        }
+
+        powerDb[(size_t)k] = (float)(10.0 * std::log10(std::norm(sum) + powerFloor));
+
+        // Row 0 holds the residual trend, which would otherwise set the scale
+        if (k > 0)
+            columnPeakDb = std::max(columnPeakDb, powerDb[(size_t)k]);
+    }
+
+    referenceDb = std::max(columnPeakDb, referenceDb - referenceDecayDb);
+
+    Column column;
+    for (int k = 0; k < NUM_ROWS; ++k)
+        column.pixels[(size_t)k] = colourFor((powerDb[(size_t)k] - (referenceDb - RANGE_DB)) / RANGE_DB);
+
+    ring.publish(column);
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "SeqlockRing.h"
+
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Scrolling spectrum of the RR tachogram, 0–0.5 Hz, as ready-to-blit
+ * pixel columns.
+ *
+ * The writer (the analysis worker) feeds the detrended 4 Hz tachogram
+ * RespirationEstimator already builds. Every HOP_SIZE samples a Hann-
+ * windowed DFT over the last WINDOW_SIZE samples gives NUM_ROWS power bins
+ * (1/64 Hz apart; only the rows up to 0.5 Hz are evaluated, which is
+ * cheaper than a full FFT of the window). Power is converted to dB against
+ * a slowly decaying session peak and mapped through a precomputed
+ * 256-entry colour table, so a column arrives at the UI as ARGB values and
+ * needs no further work there.
+ *
+ * Columns are published in a SeqlockRing: single writer, wait-free readers.
+ */
+class RrSpectrogram
+{
+public:
+    static constexpr double SAMPLE_RATE_HZ = 4.0;       // RespirationEstimator's grid
+    static constexpr int WINDOW_SIZE = 256;             // 64 s
+    static constexpr int HOP_SIZE = 8;                  // one column every 2 s
+    static constexpr int MIN_SAMPLES = WINDOW_SIZE / 2; // first column after 32 s, zero-padded
+    static constexpr int NUM_ROWS = 33;                 // 0 .. 0.5 Hz
+    static constexpr float RANGE_DB = 40.0f;            // below the reference peak, shown as black
+    static constexpr size_t CAPACITY = 512;             // about 17 minutes of columns
+
+    struct Column
+    {
+        std::array<uint32_t, NUM_ROWS> pixels{};        // 0xAARRGGBB; row 0 is 0 Hz
+    };
+
+    using Ring = SeqlockRing<Column, CAPACITY>;
+    using Snapshot = Ring::Snapshot;   // entries are columns, oldest first
+
+    RrSpectrogram();
+
+    /** Writer: one tachogram sample (seconds, detrended). */
+    void addSample(double value);
+
+    /** Writer: the tachogram restarted (reset or new sensor); columns resume once the window refills. */
+    void restart();
+
+    uint64_t getVersion() const { return ring.getVersion(); }
+
+    /** Columns newer than sinceVersion; reuse one Snapshot to avoid allocating. */
+    void read(Snapshot& snapshot, uint64_t sinceVersion = 0) const { ring.read(snapshot, sinceVersion); }
+
+    static double rowFrequency(int row) { return row * SAMPLE_RATE_HZ / WINDOW_SIZE; }
+
+    /** Colour for a level in [0, 1], as used for the columns. */
+    uint32_t colourFor(float level) const;
+
+private:
+    void computeColumn();
+
+    // Writer state
+    std::array<double, WINDOW_SIZE> samples{};
+    size_t samplePosition{0};                     // where the next sample goes
+    int samplesHeld{0};
+    int sinceColumn{0};
+    float referenceDb{-1000.0f};
+
+    std::array<double, WINDOW_SIZE> hann{};
+    std::array<std::complex<double>, WINDOW_SIZE> twiddles{};   // e^{-j 2 pi i / WINDOW_SIZE}
+    std::array<uint32_t, 256> lut{};
+
+    static_assert(NUM_ROWS - 1 == WINDOW_SIZE / 8, "rows must reach 0.5 Hz");
+
+    Ring ring;
+};
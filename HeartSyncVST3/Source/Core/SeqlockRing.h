@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Versioned ring of trivially copyable values: one writer, any number
+ * of wait-free readers.
+ *
+ * Values are numbered from 1; the ring's version is the number of the
+ * newest one. Each slot has a seqlock sequence (2 * index + 1 while the
+ * writer fills it, 2 * index + 2 once published) and holds the value as
+ * relaxed atomic words, so neither side takes a lock and a torn copy is
+ * detected rather than racing. read() copies straight out of the ring and
+ * drops (never retries) any value the writer laps while it is being
+ * copied: what it returns is always a contiguous, consistent run ending at
+ * the version it reports.
+ */
+template <typename T, size_t Capacity>
+class SeqlockRing
+{
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "values are copied word by word");
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+    static constexpr size_t CAPACITY = Capacity;
+
+    struct Snapshot
+    {
+        uint64_t version{0};          // number of the newest value in the ring; 0 when empty
+        uint64_t firstVersion{0};     // number of entries.front(); meaningless when entries is empty
+        uint64_t missed{0};           // values after the requested version that were overwritten
+        std::vector<T> entries;       // oldest first, versions firstVersion .. version
+    };
+
+    /** Writer only. */
+    void publish(const T& value)
+    {
+        const uint64_t index = writeIndex.load(std::memory_order_relaxed);
+        auto& slot = slots[(size_t)(index & (CAPACITY - 1))];
+
+        Words words{};
+        std::memcpy(words.data(), &value, sizeof(T));
+
+        slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t w = 0; w < NUM_WORDS; ++w)
+            slot.words[w].store(words[w], std::memory_order_relaxed);
+
+        slot.sequence.store(2 * index + 2, std::memory_order_release);
+        writeIndex.store(index + 1, std::memory_order_release);
+    }
+
+    /** Wait-free; cheap enough to poll before deciding whether to read(). */
+    uint64_t getVersion() const { return writeIndex.load(std::memory_order_acquire); }
+
+    /**
+     * Fills snapshot with the values newer than sinceVersion (0 for
+     * everything still held). snapshot.entries keeps its capacity between
+     * calls, so a consumer that reuses one Snapshot does not allocate once
+     * it has grown to CAPACITY.
+     */
+    void read(Snapshot& snapshot, uint64_t sinceVersion = 0) const
+    {
+        snapshot.entries.clear();
+        snapshot.missed = 0;
+
+        const uint64_t published = writeIndex.load(std::memory_order_acquire);
+        snapshot.version = published;
+        snapshot.firstVersion = published + 1;
+
+        sinceVersion = std::min(sinceVersion, published);
+        const uint64_t oldestHeld = published > CAPACITY ? published - CAPACITY : 0;
+
+        for (uint64_t index = std::max(sinceVersion, oldestHeld); index < published; ++index)
+        {
+            const auto& slot = slots[(size_t)(index & (CAPACITY - 1))];
+
+            const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+            Words words;
+            for (size_t w = 0; w < NUM_WORDS; ++w)
+                words[w] = slot.words[w].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const uint64_t after = slot.sequence.load(std::memory_order_relaxed);
+
+            if (before != 2 * index + 2 || after != before)
+            {
+                // Lapped mid-copy: this value and everything older is gone; keep the run contiguous
+                snapshot.entries.clear();
+                continue;
+            }
+
+            if (snapshot.entries.empty())
+                snapshot.firstVersion = index + 1;
+
+            snapshot.entries.emplace_back();
+            std::memcpy(&snapshot.entries.back(), words.data(), sizeof(T));
+        }
+
+        if (! snapshot.entries.empty())
+            snapshot.missed = snapshot.firstVersion - 1 - sinceVersion;
+        else
+            snapshot.missed = published - sinceVersion;
+    }
+
+private:
+    static constexpr size_t NUM_WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    using Words = std::array<uint64_t, NUM_WORDS>;
+
+    struct Slot
+    {
+        std::atomic<uint64_t> sequence{0};
+        std::array<std::atomic<uint64_t>, NUM_WORDS> words{};
+    };
+
+    std::array<Slot, CAPACITY> slots;
+    std::atomic<uint64_t> writeIndex{0};      // values published so far
+};
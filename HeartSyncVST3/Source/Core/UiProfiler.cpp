@@ -0,0 +1,152 @@
+#include "UiProfiler.h"
+
+#include <algorithm>
+#include <cmath>
+
+UiProfiler& UiProfiler::getInstance()
+{
+    static UiProfiler instance;
+    return instance;
+}
+
+void UiProfiler::addClient()
+{
+    // Start clean so a summary never mixes old windows with new ones
+    if (clients++ == 0)
+        clear();
+}
+
+void UiProfiler::removeClient()
+{
+    clients = std::max(0, clients - 1);
+}
+
+void UiProfiler::record(Section section, double durationMs)
+{
+    if (! isEnabled() || section == Section::NumSections)
+        return;
+
+    durationMs = std::max(0.0, durationMs);
+
+    auto& window = open[(size_t)section];
+    ++window.bins[(size_t)binFor(durationMs)];
+    ++window.count;
+    window.totalMs += durationMs;
+    window.maxMs = std::max(window.maxMs, durationMs);
+}
+
+bool UiProfiler::roll(double nowMs)
+{
+    if (windowStartMs <= 0.0)
+        windowStartMs = nowMs;
+
+    const double lengthMs = nowMs - windowStartMs;
+    if (lengthMs < WINDOW_MS)
+        return false;
+
+    closedSpanMs += lengthMs - (numClosed == NUM_WINDOWS ? closedLengthsMs[(size_t)nextClosed] : 0.0);
+    closedLengthsMs[(size_t)nextClosed] = lengthMs;
+
+    for (int s = 0; s < NUM_SECTIONS; ++s)
+    {
+        closed[(size_t)s][(size_t)nextClosed] = open[(size_t)s];
+        open[(size_t)s] = {};
+    }
+
+    nextClosed = (nextClosed + 1) % NUM_WINDOWS;
+    numClosed = std::min(numClosed + 1, NUM_WINDOWS);
+    windowStartMs = nowMs;
+    return true;
+}
+
+UiProfiler::Summary UiProfiler::getSummary(Section section) const
+{
+    Summary summary;
+    if (section == Section::NumSections)
+        return summary;
+
+    double totalMs = 0.0;
+    for (int w = 0; w < numClosed; ++w)
+    {
+        const auto& window = closed[(size_t)section][(size_t)w];
+        for (int b = 0; b < NUM_BINS; ++b)
+            summary.bins[(size_t)b] += window.bins[(size_t)b];
+
+        summary.count += window.count;
+        totalMs += window.totalMs;
+        summary.maxMs = std::max(summary.maxMs, window.maxMs);
+    }
+
+    if (summary.count == 0)
+        return summary;
+
+    summary.perSecond = closedSpanMs > 0.0 ? (double)summary.count * 1000.0 / closedSpanMs : 0.0;
+    summary.meanMs = totalMs / (double)summary.count;
+    summary.p50Ms = percentileFrom(summary.bins, summary.count, 50.0, summary.maxMs);
+    summary.p95Ms = percentileFrom(summary.bins, summary.count, 95.0, summary.maxMs);
+    return summary;
+}
+
+const char* UiProfiler::getName(Section section)
+{
+    switch (section)
+    {
+        case Section::Frame:            return "vblank";
+        case Section::Tick:             return "tick";
+        case Section::EditorPaint:      return "paint";
+        case Section::WaveGraphPaint:   return "graph";
+        case Section::TerminalPaint:    return "terminal";
+        case Section::DeviceDropdown:   return "devices";
+        case Section::BluetoothStatus:  return "bt status";
+        case Section::MessageQueue:     return "msg queue";
+        case Section::NumSections:      break;
+    }
+
+    return "";
+}
+
+//==============================================================================
+int UiProfiler::binFor(double durationMs)
+{
+    if (durationMs < FIRST_BIN_MS)
+        return 0;
+
+    const int bin = 1 + (int)std::floor(std::log2(durationMs / FIRST_BIN_MS));
+    return std::min(bin, NUM_BINS - 1);
+}
+
+double UiProfiler::percentileFrom(const std::array<uint32_t, NUM_BINS>& bins, uint64_t count,
+                                  double percentile, double maxMs)
+{
+    const double rank = percentile / 100.0 * (double)count;
+    double seen = 0.0;
+
+    for (int b = 0; b < NUM_BINS; ++b)
+    {
+        const double inBin = (double)bins[(size_t)b];
+        if (inBin > 0.0 && seen + inBin >= rank)
+        {
+            // Geometric interpolation across [lower, upper) of this bin
+            const double lower = b == 0 ? 0.0 : FIRST_BIN_MS * std::exp2(b - 1);
+            const double upper = FIRST_BIN_MS * std::exp2(b);
+            const double fraction = (rank - seen) / inBin;
+            const double value = lower > 0.0 ? lower * std::pow(upper / lower, fraction) : upper * fraction;
+            return std::min(value, maxMs);
+        }
+
+        seen += inBin;
+    }
+
+    return maxMs;
+}
+
+void UiProfiler::clear()
+{
+    open = {};
+    closed = {};
+    closedLengthsMs = {};
+    nextClosed = 0;
+    numClosed = 0;
+    windowStartMs = 0.0;
+    closedSpanMs = 0.0;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Message-thread timing for the editor: paint passes, UI clock work,
+ * message-queue delay.
+ *
+ * Code under test opens a Scope for one of a fixed set of sections. While
+ * the profiler is disabled (the default) a Scope reads one bool and does
+ * nothing else, so instrumentation can stay in hot paths in release builds.
+ * Enabled, each Scope costs two steady_clock reads and a bin increment.
+ *
+ * Durations go into octave-wide bins per one-second window; summaries cover
+ * the last NUM_WINDOWS closed windows, so the histograms roll rather than
+ * accumulate. Percentiles are interpolated inside a bin; max is exact.
+ *
+ * All UI work happens on the message thread, so there is one profiler for
+ * the process and it is not thread-safe: record only from the message thread.
+ */
+class UiProfiler
+{
+public:
+    enum class Section
+    {
+        Frame,              // interval between vblank callbacks
+        Tick,               // the editor's 100 ms status/graph update
+        EditorPaint,        // editor repaint pass, children included
+        WaveGraphPaint,
+        TerminalPaint,
+        DeviceDropdown,     // refreshDeviceDropdown()
+        BluetoothStatus,    // updateBluetoothStatus()
+        MessageQueue,       // callAsync post-to-run delay
+        NumSections
+    };
+
+    static constexpr int NUM_SECTIONS = (int)Section::NumSections;
+    static constexpr int NUM_BINS = 16;
+    static constexpr int NUM_WINDOWS = 10;
+    static constexpr double WINDOW_MS = 1000.0;
+    static constexpr double FIRST_BIN_MS = 0.0625;   // bin 0 is below this; bin b < FIRST_BIN_MS * 2^b
+
+    struct Summary
+    {
+        uint64_t count{0};
+        double perSecond{0.0};
+        double meanMs{0.0};
+        double p50Ms{0.0};
+        double p95Ms{0.0};
+        double maxMs{0.0};
+        std::array<uint32_t, NUM_BINS> bins{};
+    };
+
+    static UiProfiler& getInstance();
+
+    /** Enabled while at least one client (an editor showing the overlay) wants it. */
+    void addClient();
+    void removeClient();
+    bool isEnabled() const { return clients > 0; }
+
+    void record(Section section, double durationMs);
+
+    /** Closes the current window once WINDOW_MS has passed; returns true if it did. */
+    bool roll(double nowMs);
+
+    /** Over the closed windows (up to NUM_WINDOWS of them). */
+    Summary getSummary(Section section) const;
+
+    static const char* getName(Section section);
+
+    /** Times its own lifetime into a section; inert while the profiler is disabled. */
+    class Scope
+    {
+    public:
+        explicit Scope(Section sectionToTime)
+            : section(sectionToTime), active(getInstance().isEnabled())
+        {
+            if (active)
+                start = std::chrono::steady_clock::now();
+        }
+
+        ~Scope()
+        {
+            if (active)
+                getInstance().record(section, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Section section;
+        bool active;
+        std::chrono::steady_clock::time_point start;
+    };
+
+private:
+    UiProfiler() = default;
+
+    struct Window
+    {
+        std::array<uint32_t, NUM_BINS> bins{};
+        uint64_t count{0};
+        double totalMs{0.0};
+        double maxMs{0.0};
+    };
+
+    static int binFor(double durationMs);
+    static double percentileFrom(const std::array<uint32_t, NUM_BINS>& bins, uint64_t count, double percentile, double maxMs);
+    void clear();
+
+    int clients{0};
+    std::array<Window, NUM_SECTIONS> open{};
+    std::array<std::array<Window, NUM_WINDOWS>, NUM_SECTIONS> closed{};   // ring, oldest overwritten
+    int nextClosed{0};
+    int numClosed{0};
+    double windowStartMs{0.0};
+    double closedSpanMs{0.0};                                             // wall time the closed windows cover
+    std::array<double, NUM_WINDOWS> closedLengthsMs{};
+};
@@ -126,26 +126,17 @@ HeartSyncEditor::HeartSyncEditor(HeartSyncProcessor& p)
     statusLabel.setJustificationType(juce::Justification::centredLeft);
     addAndMakeVisible(statusLabel);
 
+    latencyLabel.setFont(HSTheme::mono(9.0f, false));
+    latencyLabel.setColour(juce::Label::textColourId, HSTheme::TEXT_SECONDARY);
+    latencyLabel.setJustificationType(juce::Justification::centredRight);
+    addAndMakeVisible(latencyLabel);
+
     terminalTitle.setText("DEVICE STATUS MONITOR", juce::dontSendNotification);
     terminalTitle.setFont(HSTheme::label());
     terminalTitle.setColour(juce::Label::textColourId, HSTheme::ACCENT_TEAL);
     terminalTitle.setJustificationType(juce::Justification::centredLeft);
     addAndMakeVisible(terminalTitle);
-    terminalOutput.setMultiLine(true);
-    terminalOutput.setReadOnly(true);
-    terminalOutput.setScrollbarsShown(true);
-    terminalOutput.setReturnKeyStartsNewLine(false);
-    terminalOutput.setCaretVisible(false);
-    terminalOutput.setPopupMenuEnabled(false); // custom menu handles copy options
-    terminalOutput.setFont(HSTheme::mono(10.0f, true));
-    terminalOutput.setColour(juce::TextEditor::backgroundColourId, juce::Colour(0xff001818));
-    terminalOutput.setColour(juce::TextEditor::textColourId, HSTheme::TEXT_SECONDARY);
-    terminalOutput.setColour(juce::TextEditor::highlightColourId, HSTheme::ACCENT_TEAL.withAlpha(0.35f));
-    terminalOutput.setColour(juce::TextEditor::highlightedTextColourId, HSTheme::SURFACE_BASE_START);
-    terminalOutput.setColour(juce::TextEditor::outlineColourId, juce::Colours::transparentBlack);
-    terminalOutput.setScrollBarThickness(10);
-    terminalOutput.setText("[ WAITING ]  |  DEVICE: ---  |  ADDR: ---  |  BAT: --%  |  BPM: ---", false);
-    terminalOutput.addMouseListener(this, false);
+    terminalOutput.setPlaceholder("[ WAITING ]  |  DEVICE: ---  |  ADDR: ---  |  BAT: --%  |  BPM: ---");
     addAndMakeVisible(terminalOutput);
 
     // Create three stacked metric rows
@@ -153,6 +144,7 @@ HeartSyncEditor::HeartSyncEditor(HeartSyncProcessor& p)
         [this](juce::Component& host) { buildHROffsetControls(host); });
     addAndMakeVisible(*rowHR);
     rowHR->getGraph().setLineColour(HSTheme::VITAL_HEART_RATE);
+    rowHR->setAccessory(&poincarePlot);
     rowHR->getGraph().setYAxisLabel("BPM");
     rowHR->getGraph().setFixedRange(40.0f, 200.0f);
     
@@ -174,13 +166,13 @@ HeartSyncEditor::HeartSyncEditor(HeartSyncProcessor& p)
         rowHR->setTempoSyncActive(enable);
         rowSmooth->setTempoSyncActive(false);
         rowWetDry->setTempoSyncActive(false);
-        repaint();
     };
 
     rowSmooth = std::make_unique<MetricRow>("SMOOTHED HR", "BPM", HSTheme::VITAL_SMOOTHED,
         [this](juce::Component& host) { buildSmoothControls(host); });
     addAndMakeVisible(*rowSmooth);
     rowSmooth->getGraph().setLineColour(HSTheme::VITAL_SMOOTHED);
+    rowSmooth->setAccessory(&rrHistogram);
     rowSmooth->getGraph().setYAxisLabel("BPM");
     rowSmooth->getGraph().setFixedRange(40.0f, 200.0f);
     
@@ -202,13 +194,13 @@ HeartSyncEditor::HeartSyncEditor(HeartSyncProcessor& p)
         rowHR->setTempoSyncActive(false);
         rowSmooth->setTempoSyncActive(enable);
         rowWetDry->setTempoSyncActive(false);
-        repaint();
     };
 
     rowWetDry = std::make_unique<MetricRow>("WET/DRY RATIO", "", HSTheme::VITAL_WET_DRY,
         [this](juce::Component& host) { buildWetDryControls(host); });
     addAndMakeVisible(*rowWetDry);
     rowWetDry->getGraph().setLineColour(HSTheme::VITAL_WET_DRY);
+    rowWetDry->setAccessory(&spectrogramView);
     rowWetDry->getGraph().setYAxisLabel("%");
     rowWetDry->getGraph().setFixedRange(0.0f, 100.0f);
     
@@ -230,12 +222,8 @@ HeartSyncEditor::HeartSyncEditor(HeartSyncProcessor& p)
         rowHR->setTempoSyncActive(false);
         rowSmooth->setTempoSyncActive(false);
         rowWetDry->setTempoSyncActive(enable);
-        repaint();
     };
 
-    terminalLines.clear();
-    updateTerminalLabel();
-
     wireClientCallbacks();
     refreshDeviceDropdown();
     updateBluetoothStatus();
@@ -244,16 +232,22 @@ HeartSyncEditor::HeartSyncEditor(HeartSyncProcessor& p)
     
     // Do NOT auto-start scanning - user must manually click SCAN button
     
+    addChildComponent(frameStatsOverlay);
+    setWantsKeyboardFocus(true);   // for the profiler hotkey
+
     setSize(1180, 740); // triggers resized once all children exist
-    startTimer(100);
+#if JUCE_DEBUG
+    setProfilerVisible(true);
+#endif
+    resumeFrameClock();
 }
 
 HeartSyncEditor::~HeartSyncEditor()
 {
     processorRef.onDeviceListUpdated = nullptr;
     processorRef.onBluetoothStateChanged = nullptr;
-    processorRef.onSystemMessage = nullptr;
     processorRef.onBiometricDataUpdated = nullptr;
+    setProfilerVisible(false);
     setLookAndFeel(nullptr);
 }
 
@@ -448,6 +442,17 @@ void HeartSyncEditor::buildWetDryControls(juce::Component& host)
 
 void HeartSyncEditor::updateSmoothMetrics()
 {
+    if (processorRef.isAdaptiveSmoothingEnabled())
+    {
+        // Adaptive mode: show what the processor is actually applying per sample
+        const float alpha = processorRef.getEffectiveSmoothingAlpha();
+        const float tau = processorRef.getEffectiveSmoothingTimeConstant();
+        smoothMetricsLabel.setText(juce::String::formatted("ADAPTIVE α=%.3f\nτ=%.2fs\nT½=%.2fs",
+                                                           alpha, tau, tau * std::log(2.0f)),
+                                   juce::dontSendNotification);
+        return;
+    }
+
     const float alpha = 1.0f / (1.0f + smoothing);
     const float halfLifeSamples = std::log(0.5f) / std::log(1.0f - alpha);
     const float halfLifeSeconds = halfLifeSamples * 0.025f;
@@ -457,8 +462,71 @@ void HeartSyncEditor::updateSmoothMetrics()
     smoothMetricsLabel.setText(metrics, juce::dontSendNotification);
 }
 
+void HeartSyncEditor::updateLatencyMetrics()
+{
+    const auto metrics = processorRef.getPerformanceMetrics();
+
+    juce::String text;
+    auto appendHop = [&text](const char* name, const LatencyHistogram::Summary& hop)
+    {
+        if (hop.count > 0)
+            text << (text.isEmpty() ? "" : "  ")
+                 << juce::String::formatted("%s %.1f/%.1f/%.1f", name, hop.p50Ms, hop.p95Ms, hop.p99Ms);
+    };
+
+    appendHop("RX", metrics.receiveLatency);
+    appendHop("MSG", metrics.dispatchLatency);
+    appendHop("PUB", metrics.publishLatency);
+    appendHop("AUDIO", metrics.consumeLatency);
+
+    latencyLabel.setText(text.isEmpty() ? juce::String() : "LATENCY ms p50/p95/p99  " + text,
+                         juce::dontSendNotification);
+}
+
+void HeartSyncEditor::updateHrvViews()
+{
+    // Beats arrive about once a second and spectrogram columns every 2 s; most ticks have nothing to read
+    if (processorRef.getRrHistoryVersion() != shownRrVersion)
+    {
+        processorRef.getRrHistory(rrSnapshot, shownRrVersion);
+        shownRrVersion = rrSnapshot.version;
+
+        poincarePlot.addIntervals(rrSnapshot);
+        rrHistogram.addIntervals(rrSnapshot);
+    }
+
+    if (processorRef.getRrSpectrogramVersion() != shownSpectrogramVersion)
+    {
+        processorRef.getRrSpectrogram(spectrogramSnapshot, shownSpectrogramVersion);
+        shownSpectrogramVersion = spectrogramSnapshot.version;
+
+        spectrogramView.addColumns(spectrogramSnapshot);
+    }
+}
+
+void HeartSyncEditor::updateGraphs()
+{
+    // The history is already paced at 10 Hz; a late tick picks up every entry it missed
+    if (processorRef.getBiometricHistoryVersion() == shownHistoryVersion)
+        return;
+
+    processorRef.getBiometricHistory(historySnapshot, shownHistoryVersion);
+    shownHistoryVersion = historySnapshot.version;
+
+    for (const auto& entry : historySnapshot.entries)
+    {
+        rowHR->getGraph().push(entry.rawHeartRate);
+        rowSmooth->getGraph().push(entry.smoothedHeartRate);
+        rowWetDry->getGraph().push(entry.wetDryRatio);
+    }
+}
+
 void HeartSyncEditor::paint(juce::Graphics& g)
 {
+    // Timed through paintOverChildren(), so children painted in this pass are included
+    paintStartTicks = juce::Time::getHighResolutionTicks();
+    paintStats.pixels += (juce::int64)g.getClipBounds().getWidth() * g.getClipBounds().getHeight();
+
     g.fillAll(HSTheme::SURFACE_BASE_START);
 
     const int width = getWidth();
@@ -498,6 +566,15 @@ void HeartSyncEditor::paint(juce::Graphics& g)
     g.drawLine(textRow.getX(), textRow.getBottom(), textRow.getRight(), textRow.getBottom(), 2.0f);
 }
 
+void HeartSyncEditor::paintOverChildren(juce::Graphics&)
+{
+    const double elapsedMs = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - paintStartTicks) * 1000.0;
+    ++paintStats.frames;
+    paintStats.totalMs += elapsedMs;
+    paintStats.maxMs = juce::jmax(paintStats.maxMs, elapsedMs);
+    UiProfiler::getInstance().record(UiProfiler::Section::EditorPaint, elapsedMs);
+}
+
 void HeartSyncEditor::resized()
 {
     if (!isInitialized)
@@ -574,33 +651,199 @@ void HeartSyncEditor::resized()
     auto bleStatus = bleBar.removeFromTop(24);
     statusDot.setBounds(bleStatus.removeFromLeft(24).withSizeKeepingCentre(14, 14));
     statusLabel.setBounds(bleStatus.removeFromLeft(220).withSizeKeepingCentre(200, 18));
+    latencyLabel.setBounds(bleStatus.reduced(4, 3));
 
     // Terminal panel under BLE
     terminalTitle.setBounds(terminal.removeFromTop(20));
     terminalOutput.setBounds(terminal);
+
+    frameStatsOverlay.setBounds(getLocalBounds().removeFromBottom(frameStatsOverlay.getIdealHeight() + HSTheme::grid)
+                                                .removeFromRight(380).reduced(HSTheme::grid / 2));
+}
+
+void HeartSyncEditor::onFrame()
+{
+    ++clockStats.frames;
+
+    if (! isShowing())
+    {
+        suspendFrameClock();
+        return;
+    }
+
+    // Ticks stay on a 100 ms grid but land on a frame boundary
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    if (lastFrameMs > 0.0)
+        UiProfiler::getInstance().record(UiProfiler::Section::Frame, nowMs - lastFrameMs);
+    lastFrameMs = nowMs;
+
+    refreshDeviceDropdown();
+
+    if (nowMs >= nextTickMs)
+    {
+        nextTickMs = nowMs - nextTickMs < TICK_INTERVAL_MS ? nextTickMs + TICK_INTERVAL_MS
+                                                           : nowMs + TICK_INTERVAL_MS;
+        ++clockStats.ticks;
+        tick();
+    }
+
+    if (frameStatsOverlay.isVisible())
+        updateFrameStatsOverlay(nowMs);
+}
+
+void HeartSyncEditor::suspendFrameClock()
+{
+    // Nothing is drawn while hidden; the probe is the only wakeup left
+    frameClock = {};
+    lastFrameMs = 0.0;   // the gap until the clock resumes is not a slow frame
+    startTimer(SUSPENDED_PROBE_MS);
+}
+
+void HeartSyncEditor::resumeFrameClock()
+{
+    stopTimer();
+
+    if (frameClock.isEmpty())
+        frameClock = juce::VBlankAttachment(this, [this] { onFrame(); });
 }
 
 void HeartSyncEditor::timerCallback()
 {
-    headerClockRight.setText(juce::Time::getCurrentTime().toString(true, true), juce::dontSendNotification);
+    ++clockStats.probes;
+
+    // Keep the processor's log queue from filling while nothing is drawn
+    drainSystemMessages();
+
+    if (isShowing())
+        resumeFrameClock();
+}
+
+void HeartSyncEditor::visibilityChanged()
+{
+    if (isShowing())
+        resumeFrameClock();
+}
+
+void HeartSyncEditor::updateFrameStatsOverlay(double nowMs)
+{
+    if (! UiProfiler::getInstance().roll(nowMs))
+        return;
+
+    const double perSecond = 1000.0 / juce::jmax(1.0, nowMs - overlayWindowStartMs);
+    const auto bridge = processorRef.getBridgeDispatchStats();
+    const auto bridgeBacklog = bridge.posted - juce::jmin(bridge.posted, bridge.delivered + bridge.coalesced + bridge.dropped);
+
+    frameStatsOverlay.setText(
+        juce::String::formatted("vblank %.0f/s  tick %.0f/s  probe %.0f/s  %.2f Mpx/s\n",
+                                (double)(clockStats.frames - overlayClockStats.frames) * perSecond,
+                                (double)(clockStats.ticks - overlayClockStats.ticks) * perSecond,
+                                (double)(clockStats.probes - overlayClockStats.probes) * perSecond,
+                                (double)(paintStats.pixels - overlayPaintStats.pixels) * perSecond / 1.0e6)
+        + "bridge queue " + juce::String(bridgeBacklog) + " (dropped " + juce::String(bridge.dropped)
+        + ")  log dropped " + juce::String(processorRef.getNumDroppedSystemMessages()));
+
+    std::array<UiProfiler::Summary, UiProfiler::NUM_SECTIONS> summaries;
+    for (int s = 0; s < UiProfiler::NUM_SECTIONS; ++s)
+        summaries[(size_t)s] = UiProfiler::getInstance().getSummary((UiProfiler::Section)s);
+    frameStatsOverlay.setSummaries(summaries);
+
+    overlayClockStats = clockStats;
+    overlayPaintStats = paintStats;
+    paintStats.maxMs = 0.0;   // max is per window; the rest stays cumulative
+    overlayWindowStartMs = nowMs;
+}
+
+void HeartSyncEditor::probeMessageQueue()
+{
+    // One probe in flight at a time: the delay from post to run is how long
+    // the message queue takes to get through whatever is ahead of it
+    if (messageProbePending || ! UiProfiler::getInstance().isEnabled())
+        return;
+
+    messageProbePending = true;
+    const double postedMs = juce::Time::getMillisecondCounterHiRes();
+    juce::MessageManager::callAsync([safe = juce::Component::SafePointer<HeartSyncEditor>(this), postedMs]
+    {
+        if (auto* editor = safe.getComponent())
+        {
+            UiProfiler::getInstance().record(UiProfiler::Section::MessageQueue,
+                                             juce::Time::getMillisecondCounterHiRes() - postedMs);
+            editor->messageProbePending = false;
+        }
+    });
+}
+
+void HeartSyncEditor::setProfilerVisible(bool shouldBeVisible)
+{
+    if (shouldBeVisible == frameStatsOverlay.isVisible())
+        return;
+
+    if (shouldBeVisible)
+    {
+        UiProfiler::getInstance().addClient();
+        overlayWindowStartMs = juce::Time::getMillisecondCounterHiRes();
+        overlayClockStats = clockStats;
+        overlayPaintStats = paintStats;
+        frameStatsOverlay.setText("collecting...");
+        frameStatsOverlay.toFront(false);
+    }
+    else
+    {
+        UiProfiler::getInstance().removeClient();
+    }
+
+    frameStatsOverlay.setVisible(shouldBeVisible);
+}
+
+bool HeartSyncEditor::keyPressed(const juce::KeyPress& key)
+{
+    const auto mods = key.getModifiers();
+    if (mods.isCommandDown() && mods.isShiftDown()
+        && (key.getKeyCode() == 'P' || key.getKeyCode() == 'p'))
+    {
+        setProfilerVisible(! frameStatsOverlay.isVisible());
+        return true;
+    }
+
+    return false;
+}
+
+void HeartSyncEditor::tick()
+{
+    const UiProfiler::Scope profile(UiProfiler::Section::Tick);
+    probeMessageQueue();
+
+    // Everything below only touches widgets whose displayed value changed;
+    // components invalidate their own bounds, the editor is never repainted wholesale
+    const auto now = juce::Time::getCurrentTime();
+    const auto second = now.toMilliseconds() / 1000;
+    if (second != shownClockSecond)
+    {
+        shownClockSecond = second;
+        headerClockRight.setText(now.toString(true, true), juce::dontSendNotification);
+    }
+
     updateBluetoothStatus();
+    drainSystemMessages();
+
+    updateSmoothMetrics();
+    updateLatencyMetrics();
+    updateHrvViews();
+    updateGraphs();
 
     auto bioData = processorRef.getCurrentBiometricData();
     if (bioData.isDataValid)
     {
-        rowHR->setValueText(juce::String(juce::roundToInt(bioData.rawHeartRate)));
-        rowSmooth->setValueText(juce::String(juce::roundToInt(bioData.smoothedHeartRate)));
-        rowWetDry->setValueText(juce::String(juce::roundToInt(bioData.wetDryRatio)));
-        rowHR->getGraph().push(bioData.rawHeartRate);
-        rowSmooth->getGraph().push(bioData.smoothedHeartRate);
-        rowWetDry->getGraph().push(bioData.wetDryRatio);
+        showValue(*rowHR, shownRawHr, juce::roundToInt(bioData.rawHeartRate));
+        showValue(*rowSmooth, shownSmoothedHr, juce::roundToInt(bioData.smoothedHeartRate));
+        showValue(*rowWetDry, shownWetDry, juce::roundToInt(bioData.wetDryRatio));
     }
     else
     {
         // No valid data - show dashes
-        rowHR->setValueText("--");
-        rowSmooth->setValueText("--");
-        rowWetDry->setValueText("--");
+        showValue(*rowHR, shownRawHr, NO_VALUE);
+        showValue(*rowSmooth, shownSmoothedHr, NO_VALUE);
+        showValue(*rowWetDry, shownWetDry, NO_VALUE);
     }
     
     // Update tempo sync indicators
@@ -629,45 +872,31 @@ void HeartSyncEditor::timerCallback()
         headerStatusRight.setText(juce::CharPointer_UTF8("◆ SYSTEM OPERATIONAL"), juce::dontSendNotification);
         headerStatusRight.setColour(juce::Label::textColourId, HSTheme::STATUS_CONNECTED);
     }
-    
-    repaint();
 }
 
-void HeartSyncEditor::mouseDown(const juce::MouseEvent& event)
+void HeartSyncEditor::showValue(MetricRow& row, int& shown, int value)
 {
-    if (event.eventComponent == &terminalOutput && event.mods.isPopupMenu())
-    {
-        juce::PopupMenu menu;
-        menu.addItem("Copy Selected", [this]() { terminalOutput.copy(); });
-        menu.addItem("Copy All", [this]() { juce::SystemClipboard::copyTextToClipboard(terminalOutput.getText()); });
-
-        menu.showMenuAsync(juce::PopupMenu::Options{}
-                               .withTargetComponent(&terminalOutput)
-                               .withTargetScreenArea({ event.getScreenPosition(), { 1, 1 } }));
+    if (value == shown)
         return;
-    }
 
-    juce::AudioProcessorEditor::mouseDown(event);
+    shown = value;
+    row.setValueText(value == NO_VALUE ? juce::String("--") : juce::String(value));
 }
 
 void HeartSyncEditor::wireClientCallbacks()
 {
     auto safe = juce::Component::SafePointer<HeartSyncEditor>(this);
 
-    processorRef.onDeviceListUpdated = [safe]()
+    // Device events arrive in bursts while scanning; the frame clock picks them up
+    processorRef.onDeviceListUpdated = [dirty = deviceListDirty]()
     {
-        if (safe != nullptr)
-        {
-            juce::MessageManager::callAsync([safe]()
-            {
-                if (auto* editor = safe.getComponent())
-                    editor->refreshDeviceDropdown();
-            });
-        }
+        dirty->store(true);
     };
 
-    processorRef.onBluetoothStateChanged = [safe]()
+    processorRef.onBluetoothStateChanged = [safe, dirty = deviceListDirty]()
     {
+        dirty->store(true);   // the list's source may have switched between bridge and native BLE
+
         if (safe != nullptr)
         {
             juce::MessageManager::callAsync([safe]()
@@ -677,18 +906,6 @@ void HeartSyncEditor::wireClientCallbacks()
             });
         }
     };
-
-    processorRef.onSystemMessage = [safe](const juce::String& message)
-    {
-        if (safe != nullptr)
-        {
-            juce::MessageManager::callAsync([safe, message]()
-            {
-                if (auto* editor = safe.getComponent())
-                    editor->appendTerminal(message);
-            });
-        }
-    };
 }
 
 void HeartSyncEditor::scanForDevices()
@@ -702,18 +919,18 @@ void HeartSyncEditor::scanForDevices()
 
     if (!available)
     {
-#if JUCE_MAC
+#if HEARTSYNC_HAS_BRIDGE_CLIENT
         if (bridgeConfigured && !bridgeConnected && !nativeReady)
         {
-            appendTerminal("Waiting for HeartSync Bridge helper; attempting to launch helper...");
+            appendTerminal("Waiting for HeartSync Bridge helper; attempting to launch helper...", TerminalLogView::Severity::Warning);
             processorRef.requestBridgeReconnect(true);
         }
         else
         {
-            appendTerminal("Bluetooth subsystem still initializing");
+            appendTerminal("Bluetooth subsystem still initializing", TerminalLogView::Severity::Warning);
         }
 #else
-        appendTerminal("Bluetooth subsystem still initializing");
+        appendTerminal("Bluetooth subsystem still initializing", TerminalLogView::Severity::Warning);
 #endif
         pendingScanRequest = true;
         syncBleControls();
@@ -722,22 +939,22 @@ void HeartSyncEditor::scanForDevices()
 
     if (!ready)
     {
-#if JUCE_MAC
+#if HEARTSYNC_HAS_BRIDGE_CLIENT
         if (bridgeConfigured && bridgeConnected && !bridgeReady)
         {
-            appendTerminal("Bridge helper awaiting permission; retrying shortly");
+            appendTerminal("Bridge helper awaiting permission; retrying shortly", TerminalLogView::Severity::Warning);
         }
         else if (bridgeConfigured && !bridgeConnected && !nativeReady)
         {
-            appendTerminal("HeartSync Bridge helper not yet ready; will retry automatically");
+            appendTerminal("HeartSync Bridge helper not yet ready; will retry automatically", TerminalLogView::Severity::Warning);
             processorRef.requestBridgeReconnect();
         }
         else
         {
-            appendTerminal("Bluetooth radio not ready; will retry when available");
+            appendTerminal("Bluetooth radio not ready; will retry when available", TerminalLogView::Severity::Warning);
         }
 #else
-        appendTerminal("Bluetooth radio not ready; will retry when available");
+        appendTerminal("Bluetooth radio not ready; will retry when available", TerminalLogView::Severity::Warning);
 #endif
         pendingScanRequest = true;
         syncBleControls();
@@ -756,14 +973,15 @@ void HeartSyncEditor::scanForDevices()
         auto result = processorRef.startDeviceScan();
         if (result.failed())
         {
-            appendTerminal("Scan failed: " + result.getErrorMessage());
+            appendTerminal("Scan failed: " + result.getErrorMessage(), TerminalLogView::Severity::Error);
         }
         else
         {
             appendTerminal("Scanning for devices...");
-            availableDevices.clear();
-            knownDeviceCount = 0;
-            deviceBox.clear(juce::dontSendNotification);
+            // Start the list over: the next refresh fetches every device again
+            clearDeviceDropdown();
+            deviceCursor = {};
+            deviceListDirty->store(true);
         }
     }
 
@@ -789,12 +1007,13 @@ void HeartSyncEditor::connectSelectedDevice()
     
     appendTerminal("DEBUG: Selected device index " + juce::String(selectedId - 1) + 
                    ", id: '" + juce::String(device.identifier) + 
-                   "', name: '" + juce::String(device.name) + "'");
+                   "', name: '" + juce::String(device.name) + "'",
+                   TerminalLogView::Severity::Debug);
     
     auto result = processorRef.connectToDevice(device.identifier);
     if (result.failed())
     {
-        appendTerminal("Connection failed: " + result.getErrorMessage());
+        appendTerminal("Connection failed: " + result.getErrorMessage(), TerminalLogView::Severity::Error);
     }
     else
     {
@@ -807,182 +1026,109 @@ void HeartSyncEditor::connectSelectedDevice()
 
 void HeartSyncEditor::refreshDeviceDropdown()
 {
-    auto devices = processorRef.getAvailableDevices();
-    
-    // FILTER: Only show devices advertising Heart Rate service (180D) like Python version
-    std::vector<HeartSyncProcessor::DeviceInfo> filteredDevices;
-    for (const auto& device : devices)
-    {
-        bool hasHRService = false;
-        for (const auto& service : device.services)
-        {
-            juce::String svc = juce::String(service).trim();
-            if (svc.equalsIgnoreCase("180D") || svc.equalsIgnoreCase("0000180D-0000-1000-8000-00805F9B34FB"))
-            {
-                hasHRService = true;
-                break;
-            }
-        }
-        
-        if (hasHRService)
-            filteredDevices.push_back(device);
-    }
-    
-    availableDevices = filteredDevices;
-
-    auto previousId = deviceBox.getSelectedId();
-    deviceBox.clear(juce::dontSendNotification);
+    if (! deviceListDirty->load() && pendingDeviceChanges.empty())
+        return;
 
-    int itemId = 1;
-    int connectedId = 0;
-    std::set<std::string> namesSeen;
+    const UiProfiler::Scope profile(UiProfiler::Section::DeviceDropdown);
+    bool cleared = false;
 
-    for (const auto& device : availableDevices)
+    if (deviceListDirty->exchange(false))
     {
-        // Build smart display name
-        juce::String displayName;
-        juce::String deviceName = juce::String(device.name).trim();
-        
-        // Use actual device name if available and meaningful
-        if (deviceName.isNotEmpty() && !deviceName.equalsIgnoreCase("Unknown"))
-        {
-            displayName = deviceName;
-        }
-        else
+        processorRef.getDeviceChanges(deviceCursor, deviceChanges);
+        deviceCursor = deviceChanges.cursor;
+
+        if (deviceChanges.reset)
         {
-            // Fallback to service-based naming
-            bool isHeartRateMonitor = false;
-            for (const auto& service : device.services)
-            {
-                if (juce::String(service).equalsIgnoreCase("180D"))
-                {
-                    isHeartRateMonitor = true;
-                    break;
-                }
-            }
-            
-            // Get short identifier from UUID
-            juce::String shortId = juce::String(device.identifier);
-            auto lastDash = shortId.lastIndexOfChar('-');
-            if (lastDash >= 0 && lastDash < shortId.length() - 1)
-                shortId = shortId.substring(lastDash + 1);
-            if (shortId.length() > 5)
-                shortId = shortId.substring(shortId.length() - 5);
-            shortId = shortId.toUpperCase();
-            
-            displayName = isHeartRateMonitor 
-                ? ("HR Monitor • " + shortId)
-                : ("BLE Device • " + shortId);
+            cleared = ! availableDevices.empty();
+            clearDeviceDropdown();
         }
 
-        // Append signal strength
-        if (device.signalStrength != 0)
-            displayName += juce::String(" (") + juce::String(device.signalStrength) + " dBm)";
+        // Only Heart Rate devices are listed, but one already shown keeps updating
+        for (auto& device : deviceChanges.changed)
+            if (device.hasHeartRateService || deviceIndexById.count(device.identifier) > 0)
+                pendingDeviceChanges.push_back(std::move(device));
+    }
 
-        deviceBox.addItem(displayName, itemId);
-        if (device.isConnected)
-            connectedId = itemId;
+    const auto countBefore = availableDevices.size();
+    const double deadlineMs = juce::Time::getMillisecondCounterHiRes() + DEVICE_UPDATE_BUDGET_MS;
 
-        if (!namesSeen.count(device.identifier))
-        {
-            namesSeen.insert(device.identifier);
-        }
+    // Whatever misses the budget waits for the next frame
+    while (! pendingDeviceChanges.empty())
+    {
+        applyDeviceChange(pendingDeviceChanges.front());
+        pendingDeviceChanges.pop_front();
 
-        ++itemId;
+        if (juce::Time::getMillisecondCounterHiRes() >= deadlineMs)
+            break;
     }
 
-    if (connectedId > 0)
-        deviceBox.setSelectedId(connectedId, juce::dontSendNotification);
-    else if (previousId > 0 && previousId <= deviceBox.getNumItems())
-        deviceBox.setSelectedId(previousId, juce::dontSendNotification);
-    else if (deviceBox.getNumItems() > 0)
+    if (deviceBox.getSelectedId() == 0 && deviceBox.getNumItems() > 0)
         deviceBox.setSelectedId(1, juce::dontSendNotification);
 
-    if (availableDevices.size() > knownDeviceCount)
+    if (availableDevices.size() > countBefore)
     {
-        auto newCount = availableDevices.size() - knownDeviceCount;
-        if (!availableDevices.empty())
-        {
-            const auto& latest = availableDevices.back();
-            
-            // Build smart display name for terminal
-            juce::String latestLabel;
-            juce::String deviceName = juce::String(latest.name).trim();
-            
-            if (deviceName.isNotEmpty() && !deviceName.equalsIgnoreCase("Unknown"))
-            {
-                latestLabel = deviceName;
-            }
-            else
-            {
-                bool isHeartRateMonitor = false;
-                for (const auto& service : latest.services)
-                {
-                    if (juce::String(service).equalsIgnoreCase("180D"))
-                    {
-                        isHeartRateMonitor = true;
-                        break;
-                    }
-                }
-                
-                juce::String shortId = juce::String(latest.identifier);
-                auto lastDash = shortId.lastIndexOfChar('-');
-                if (lastDash >= 0 && lastDash < shortId.length() - 1)
-                    shortId = shortId.substring(lastDash + 1);
-                if (shortId.length() > 5)
-                    shortId = shortId.substring(shortId.length() - 5);
-                shortId = shortId.toUpperCase();
-                
-                latestLabel = isHeartRateMonitor 
-                    ? ("HR Monitor • " + shortId)
-                    : ("BLE Device • " + shortId);
-            }
-            
-            appendTerminal("Discovered " + juce::String(newCount) + (newCount == 1 ? " device: " : " devices (latest): ") + latestLabel);
-        }
-        else
-        {
-            appendTerminal("Discovered " + juce::String(newCount) + (newCount == 1 ? " device" : " devices"));
-        }
+        const auto newCount = availableDevices.size() - countBefore;
+        appendTerminal("Discovered " + juce::String((int)newCount) + (newCount == 1 ? " device: " : " devices (latest): ")
+                       + buildDeviceLabel(availableDevices.back()));
     }
-    else if (availableDevices.empty() && knownDeviceCount != 0)
+    else if (cleared && availableDevices.empty())
     {
         appendTerminal("Devices cleared");
     }
 
-    knownDeviceCount = availableDevices.size();
     syncBleControls();
 }
 
-void HeartSyncEditor::appendTerminal(const juce::String& message)
+void HeartSyncEditor::applyDeviceChange(const HeartSyncProcessor::DeviceInfo& device)
 {
-    auto timestamp = juce::Time::getCurrentTime().formatted("%H:%M:%S");
-    terminalLines.add("[" + timestamp + "] " + message);
-    while (terminalLines.size() > 200)
-        terminalLines.remove(0);
+    const auto label = device.signalStrength != 0 ? buildDeviceDetail(device) : buildDeviceLabel(device);
 
-    updateTerminalLabel();
+    auto found = deviceIndexById.find(device.identifier);
+    if (found == deviceIndexById.end())
+    {
+        found = deviceIndexById.emplace(device.identifier, availableDevices.size()).first;
+        availableDevices.push_back(device);
+        deviceBox.addItem(label, (int)availableDevices.size());
+    }
+    else
+    {
+        availableDevices[found->second] = device;
+        deviceBox.changeItemText((int)found->second + 1, label);
+    }
+
+    const int itemId = (int)found->second + 1;
+
+    // setSelectedId also refreshes the shown text when the selected item was relabelled
+    if (device.isConnected || deviceBox.getSelectedId() == itemId)
+        deviceBox.setSelectedId(itemId, juce::dontSendNotification);
 }
 
-void HeartSyncEditor::updateTerminalLabel()
+void HeartSyncEditor::clearDeviceDropdown()
 {
-    if (terminalLines.isEmpty())
-    {
-        terminalOutput.setText("[ WAITING ]  |  DEVICE: ---  |  ADDR: ---  |  BAT: --%  |  BPM: ---",
-                               false);
-        return;
-    }
+    availableDevices.clear();
+    deviceIndexById.clear();
+    pendingDeviceChanges.clear();
+    deviceBox.clear(juce::dontSendNotification);
+}
 
-    juce::String text;
-    for (int i = 0; i < terminalLines.size(); ++i)
+void HeartSyncEditor::appendTerminal(const juce::String& message, TerminalLogView::Severity severity)
+{
+    terminalOutput.append(severity, message);
+}
+
+void HeartSyncEditor::drainSystemMessages()
+{
+    systemMessageBatch.clear();
+    if (processorRef.drainSystemMessages(systemMessageBatch) > 0)
+        terminalOutput.append(systemMessageBatch);
+
+    const auto dropped = processorRef.getNumDroppedSystemMessages();
+    if (dropped != shownDroppedMessages)
     {
-        if (i > 0)
-            text += '\n';
-        text += terminalLines[i];
+        appendTerminal(juce::String(dropped - shownDroppedMessages) + " system messages dropped (queue full)",
+                       TerminalLogView::Severity::Warning);
+        shownDroppedMessages = dropped;
     }
-
-    terminalOutput.setText(text, false);
-    terminalOutput.setCaretPosition(terminalOutput.getText().length());
 }
 
 juce::String HeartSyncEditor::buildDeviceLabel(const HeartSyncProcessor::DeviceInfo& device) const
@@ -995,18 +1141,8 @@ juce::String HeartSyncEditor::buildDeviceLabel(const HeartSyncProcessor::DeviceI
     }
     
     // Fallback to service-based naming
-    bool isHeartRateMonitor = false;
-    for (const auto& service : device.services)
-    {
-        if (juce::String(service).equalsIgnoreCase("180D"))
-        {
-            isHeartRateMonitor = true;
-            break;
-        }
-    }
-    
     juce::String shortId = shortenIdentifier(device.identifier);
-    return isHeartRateMonitor 
+    return device.hasHeartRateService
         ? ("HR Monitor • " + shortId)
         : ("BLE Device • " + shortId);
 }
@@ -1029,6 +1165,7 @@ juce::String HeartSyncEditor::shortenIdentifier(const std::string& identifier) c
 
 void HeartSyncEditor::updateBluetoothStatus()
 {
+    const UiProfiler::Scope profile(UiProfiler::Section::BluetoothStatus);
     const bool bridgeConfigured = processorRef.isBridgeClientConfigured();
     const bool bridgeConnected = processorRef.isBridgeClientConnected();
     const bool bridgeReady = processorRef.isBridgeClientReady();
@@ -1146,9 +1283,8 @@ void HeartSyncEditor::syncBleControls()
 
 void HeartSyncEditor::setStatusIndicator(juce::Colour colour, const juce::String& text)
 {
+    // Labels repaint themselves when their text or colour actually changes
     statusDot.setColour(juce::Label::textColourId, colour);
     statusLabel.setColour(juce::Label::textColourId, colour);
     statusLabel.setText(text, juce::dontSendNotification);
-    statusDot.repaint();
-    statusLabel.repaint();
 }
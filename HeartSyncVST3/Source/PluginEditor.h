@@ -29,6 +29,16 @@ namespace HeartSyncColors
 #include "UI/MetricRow.h"
 #include "UI/ParamBox.h"
 #include "UI/ParamToggle.h"
+#include "UI/FrameStatsOverlay.h"
+#include "UI/TerminalLogView.h"
+#include "UI/PoincarePlot.h"
+#include "UI/RrHistogram.h"
+#include "UI/SpectrogramView.h"
+#include <limits>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <unordered_map>
 
 // Use the Professional processor type
 using HeartSyncProcessor = HeartSyncVST3AudioProcessor;
@@ -41,11 +51,35 @@ public:
     ~HeartSyncEditor() override;
 
     void paint(juce::Graphics&) override;
+    void paintOverChildren(juce::Graphics&) override;
     void resized() override;
 
+    /** Editor repaint passes (editor and the children painted with it), cumulative.
+        maxMs restarts each time the profiler overlay refreshes. */
+    struct PaintStats
+    {
+        uint64_t frames{0};
+        double totalMs{0.0};
+        double maxMs{0.0};
+        juce::int64 pixels{0};   // clip area painted, logical pixels
+    };
+
+    const PaintStats& getPaintStats() const { return paintStats; }
+
 private:
-    void timerCallback() override;
-    void mouseDown(const juce::MouseEvent& event) override;
+    // UI clock. One VBlankAttachment drives every update while the editor is
+    // showing; once it is hidden or minimised the attachment is dropped and a
+    // slow probe timer waits for it to come back.
+    void onFrame();
+    void tick();
+    void suspendFrameClock();
+    void resumeFrameClock();
+    void timerCallback() override;   // suspended-state probe
+    void visibilityChanged() override;
+    void updateFrameStatsOverlay(double nowMs);
+    void probeMessageQueue();
+    void setProfilerVisible(bool shouldBeVisible);
+    bool keyPressed(const juce::KeyPress& key) override;   // Cmd/Ctrl+Shift+P toggles the profiler
     
     void wireClientCallbacks();
     void scanForDevices();
@@ -57,10 +91,19 @@ private:
     void buildSmoothControls(juce::Component& host);
     void buildWetDryControls(juce::Component& host);
     void updateSmoothMetrics();
+    void showValue(MetricRow& row, int& shown, int value);
+    void updateLatencyMetrics();
+    void updateHrvViews();
+    void updateGraphs();
+    // Device list. Processor callbacks only mark it dirty; the frame clock
+    // fetches what changed and applies it a few items per frame.
     void refreshDeviceDropdown();
+    void applyDeviceChange(const HeartSyncProcessor::DeviceInfo& device);
+    void clearDeviceDropdown();
     void updateBiometricDisplay();
-    void appendTerminal(const juce::String& message);
-    void updateTerminalLabel();
+    void appendTerminal(const juce::String& message,
+                        TerminalLogView::Severity severity = TerminalLogView::Severity::Info);
+    void drainSystemMessages();
     void updateBluetoothStatus();
     void syncBleControls();
     void setStatusIndicator(juce::Colour colour, const juce::String& text);
@@ -71,6 +114,18 @@ private:
     HeartSyncProcessor& processorRef;
     HSLookAndFeel lnf;
 
+    // HRV views, shown as accessories of the three metric rows
+    PoincarePlot poincarePlot{HSTheme::VITAL_HEART_RATE};
+    RrHistogram rrHistogram{HSTheme::VITAL_SMOOTHED};
+    SpectrogramView spectrogramView{HSTheme::VITAL_WET_DRY};
+    RrHistory::Snapshot rrSnapshot;                     // reused by updateHrvViews()
+    RrSpectrogram::Snapshot spectrogramSnapshot;        // likewise
+    uint64_t shownRrVersion = 0;
+    uint64_t shownSpectrogramVersion = 0;
+
+    BiometricHistory::Snapshot historySnapshot;         // reused by updateGraphs()
+    uint64_t shownHistoryVersion = 0;
+
     // Three stacked metric rows
     std::unique_ptr<MetricRow> rowHR;
     std::unique_ptr<MetricRow> rowSmooth;
@@ -89,12 +144,14 @@ private:
     juce::ComboBox deviceBox;
     juce::Label deviceLabel;
     juce::Label statusDot, statusLabel;
+    juce::Label latencyLabel;         // per-hop heart-rate age, p50/p95/p99
     juce::Label bleTitle;
 
     // Device terminal row
     juce::Label terminalTitle;
-    juce::TextEditor terminalOutput;
-    juce::StringArray terminalLines;
+    TerminalLogView terminalOutput;
+    std::vector<LogMessageQueue::Message> systemMessageBatch;   // reused by drainSystemMessages()
+    uint64_t shownDroppedMessages = 0;
 
     // Header labels (Python parity)
     juce::Label headerSettingsIcon;   // gear glyph
@@ -104,6 +161,36 @@ private:
     juce::Label headerClockRight;     // YYYY-MM-DD HH:MM:SS
     juce::Label headerStatusRight;    // ◆ SYSTEM OPERATIONAL
 
+    // What the timer last displayed, so unchanged values are neither reformatted nor invalidated
+    static constexpr int NO_VALUE = std::numeric_limits<int>::min();   // shown as "--"
+    int shownRawHr = 0, shownSmoothedHr = 0, shownWetDry = 0;          // MetricRow starts at "0"
+    juce::int64 shownClockSecond = -1;
+
+    PaintStats paintStats;
+    juce::int64 paintStartTicks = 0;
+
+    static constexpr double TICK_INTERVAL_MS = 100.0;   // status polling; graphs follow the processor's history
+    static constexpr int SUSPENDED_PROBE_MS = 500;
+
+    struct ClockStats
+    {
+        uint64_t frames{0};    // vblank callbacks
+        uint64_t ticks{0};     // tick() runs
+        uint64_t probes{0};    // probe timer wakeups while suspended
+    };
+
+    juce::VBlankAttachment frameClock;
+    double nextTickMs = 0.0;
+    ClockStats clockStats;
+
+    // Profiler overlay: shown by default in debug builds, toggled from the keyboard in any build
+    FrameStatsOverlay frameStatsOverlay;
+    ClockStats overlayClockStats;     // counters at the start of the overlay's window
+    PaintStats overlayPaintStats;
+    double overlayWindowStartMs = 0.0;
+    double lastFrameMs = 0.0;
+    bool messageProbePending = false;
+
     // State variables (matching Python)
     float currentHR = 0.0f;
     float smoothedHR = 0.0f;
@@ -117,8 +204,13 @@ private:
     bool statusWasReady = false;
     bool pendingScanRequest = false;
     juce::String statusLastDeviceName;
-    std::vector<HeartSyncProcessor::DeviceInfo> availableDevices;
-    size_t knownDeviceCount = 0;
+    std::vector<HeartSyncProcessor::DeviceInfo> availableDevices;   // item id = index + 1, first-seen order
+    std::unordered_map<std::string, size_t> deviceIndexById;
+    std::deque<HeartSyncProcessor::DeviceInfo> pendingDeviceChanges;
+    DeviceRegistry::Cursor deviceCursor;
+    DeviceRegistry::Changes deviceChanges;
+    std::shared_ptr<std::atomic<bool>> deviceListDirty = std::make_shared<std::atomic<bool>>(true);   // outlives the editor in callbacks
+    static constexpr double DEVICE_UPDATE_BUDGET_MS = 2.0;
     bool bridgeWasConnected = false;
     bool bridgeWasReady = false;
     bool bridgeHintShown = false;
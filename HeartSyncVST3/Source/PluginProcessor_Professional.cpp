@@ -13,6 +13,22 @@ const juce::String HeartSyncVST3AudioProcessor::PARAM_SMOOTHING_FACTOR = "smooth
 const juce::String HeartSyncVST3AudioProcessor::PARAM_WET_DRY_OFFSET = "wet_dry_offset";
 const juce::String HeartSyncVST3AudioProcessor::PARAM_WET_DRY_INPUT_SOURCE = "wet_dry_input_source";
 const juce::String HeartSyncVST3AudioProcessor::PARAM_TEMPO_SYNC_SOURCE = "tempo_sync_source";
+const juce::String HeartSyncVST3AudioProcessor::PARAM_JITTER_BUFFER_ENABLED = "jitter_buffer_enabled";
+const juce::String HeartSyncVST3AudioProcessor::PARAM_JITTER_BUFFER_LATENCY = "jitter_buffer_latency";
+const juce::String HeartSyncVST3AudioProcessor::PARAM_ADAPTIVE_SMOOTHING = "adaptive_smoothing";
+const juce::String HeartSyncVST3AudioProcessor::PARAM_ADAPTIVE_TAU_MIN = "adaptive_tau_min";
+const juce::String HeartSyncVST3AudioProcessor::PARAM_ADAPTIVE_TAU_MAX = "adaptive_tau_max";
+const juce::String HeartSyncVST3AudioProcessor::PARAM_HR_ZONE = "hr_zone";
+const juce::String HeartSyncVST3AudioProcessor::PARAM_ZONE_MODE = "zone_mode";
+const juce::String HeartSyncVST3AudioProcessor::PARAM_ZONE_MAX_HR = "zone_max_hr";
+const juce::String HeartSyncVST3AudioProcessor::PARAM_ZONE_REST_HR = "zone_rest_hr";
+const juce::String HeartSyncVST3AudioProcessor::PARAM_ZONE_BOUNDARY_PREFIX = "zone_boundary_";
+const juce::String HeartSyncVST3AudioProcessor::PARAM_ZONE_HYSTERESIS = "zone_hysteresis";
+const juce::String HeartSyncVST3AudioProcessor::PARAM_ZONE_MIDI_OUTPUT = "zone_midi_output";
+const juce::String HeartSyncVST3AudioProcessor::PARAM_ZONE_MIDI_CHANNEL = "zone_midi_channel";
+const juce::String HeartSyncVST3AudioProcessor::PARAM_ZONE_MIDI_BASE = "zone_midi_base";
+const juce::String HeartSyncVST3AudioProcessor::PARAM_RESPIRATION_RATE = "respiration_rate";
+const juce::String HeartSyncVST3AudioProcessor::PARAM_BREATH_PHASE = "breath_phase";
 
 //==============================================================================
 HeartSyncVST3AudioProcessor::HeartSyncVST3AudioProcessor()
@@ -20,20 +36,19 @@ HeartSyncVST3AudioProcessor::HeartSyncVST3AudioProcessor()
                       .withInput("Input", juce::AudioChannelSet::stereo(), true)
                       .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
        parameters(*this, nullptr, "HeartSyncParameters", createParameterLayout()),
-       historyWriteIndex(0),
        lastResetTime(std::chrono::steady_clock::now())
 {
-    // Initialize arrays to zero
-    rawHeartRateHistory.fill(0.0f);
-    smoothedHeartRateHistory.fill(0.0f);
-    wetDryHistory.fill(50.0f); // Default to 50% wet/dry
+    for (size_t i = 0; i < zoneBoundaryValues.size(); ++i)
+        zoneBoundaryValues[i] = parameters.getRawParameterValue(PARAM_ZONE_BOUNDARY_PREFIX + juce::String((int)i + 1));
+    
+    analysisWorker.start();
     
     // Defer Bluetooth initialization to prevent constructor crashes
     bluetoothManager = nullptr;
     
     logSystemMessage("HeartSync Professional v2.0 - Enterprise Audio Processor Initialized");
 
-#if JUCE_MAC
+#if HEARTSYNC_HAS_BRIDGE_CLIENT
     initialiseBridgeClient();
 #endif
 
@@ -45,7 +60,8 @@ HeartSyncVST3AudioProcessor::~HeartSyncVST3AudioProcessor()
 {
     stopTimer(); // Stop deferred initialization timer
     bluetoothManager.reset();
-#if JUCE_MAC
+    analysisWorker.stop();
+#if HEARTSYNC_HAS_BRIDGE_CLIENT
     bridgeClient.reset();
 #endif
 }
@@ -115,6 +131,120 @@ juce::AudioProcessorValueTreeState::ParameterLayout HeartSyncVST3AudioProcessor:
         juce::StringArray{"Off", "Raw Heart Rate", "Smoothed HR", "Wet/Dry Ratio"},
         0)); // Default to Off
 
+    // Jitter buffer: trades a fixed playout delay for step-free bridge modulation
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        PARAM_JITTER_BUFFER_ENABLED,
+        "Jitter Buffer",
+        false));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        PARAM_JITTER_BUFFER_LATENCY,
+        "Jitter Buffer Latency",
+        juce::NormalisableRange<float>(50.0f, 3000.0f, 1.0f, 0.5f),
+        1200.0f,
+        "ms"));
+
+    // Adaptive smoothing: time constant tuned online between these bounds
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        PARAM_ADAPTIVE_SMOOTHING,
+        "Adaptive Smoothing",
+        false));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        PARAM_ADAPTIVE_TAU_MIN,
+        "Adaptive Min Time Constant",
+        juce::NormalisableRange<float>(0.1f, 10.0f, 0.01f, 0.5f),
+        0.5f,
+        "s"));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        PARAM_ADAPTIVE_TAU_MAX,
+        "Adaptive Max Time Constant",
+        juce::NormalisableRange<float>(1.0f, 60.0f, 0.1f, 0.5f),
+        15.0f,
+        "s"));
+
+    // Heart-rate zone output (discrete, read-only for the host)
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        PARAM_HR_ZONE,
+        "Heart Rate Zone",
+        juce::StringArray{"Zone 1", "Zone 2", "Zone 3", "Zone 4", "Zone 5"},
+        0,
+        juce::AudioParameterChoiceAttributes().withCategory(juce::AudioProcessorParameter::outputMeter)
+                                              .withAutomatable(false)));
+
+    // Zone configuration: boundaries are BPM or percent depending on the mode
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        PARAM_ZONE_MODE,
+        "Zone Mode",
+        juce::StringArray{"Absolute BPM", "% of Max HR", "% of HR Reserve"},
+        1)); // Default to % of max
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        PARAM_ZONE_MAX_HR,
+        "Zone Max Heart Rate",
+        juce::NormalisableRange<float>(120.0f, 220.0f, 1.0f),
+        190.0f,
+        "BPM"));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        PARAM_ZONE_REST_HR,
+        "Zone Resting Heart Rate",
+        juce::NormalisableRange<float>(30.0f, 100.0f, 1.0f),
+        60.0f,
+        "BPM"));
+
+    const float defaultBoundaries[] = { 60.0f, 70.0f, 80.0f, 90.0f };
+    for (int i = 0; i < HeartRateZoneTracker::NUM_ZONES - 1; ++i)
+    {
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            PARAM_ZONE_BOUNDARY_PREFIX + juce::String(i + 1),
+            "Zone " + juce::String(i + 1) + "/" + juce::String(i + 2) + " Boundary",
+            juce::NormalisableRange<float>(0.0f, 220.0f, 0.5f),
+            defaultBoundaries[i]));
+    }
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        PARAM_ZONE_HYSTERESIS,
+        "Zone Hysteresis",
+        juce::NormalisableRange<float>(0.0f, 20.0f, 0.5f),
+        3.0f,
+        "BPM"));
+
+    // Zone transitions as MIDI scene changes
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        PARAM_ZONE_MIDI_OUTPUT,
+        "Zone MIDI Output",
+        juce::StringArray{"Off", "Program Change", "Note"},
+        0)); // Default to Off
+
+    params.push_back(std::make_unique<juce::AudioParameterInt>(
+        PARAM_ZONE_MIDI_CHANNEL,
+        "Zone MIDI Channel",
+        1, 16, 1));
+
+    params.push_back(std::make_unique<juce::AudioParameterInt>(
+        PARAM_ZONE_MIDI_BASE,
+        "Zone MIDI Base",
+        0, 123, 0));
+
+    // Respiration derived from RR intervals
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        PARAM_RESPIRATION_RATE,
+        "Respiration Rate",
+        juce::NormalisableRange<float>(0.0f, 40.0f, 0.1f),
+        0.0f,
+        "br/min",
+        juce::AudioProcessorParameter::outputMeter));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        PARAM_BREATH_PHASE,
+        "Breath Phase",
+        juce::NormalisableRange<float>(0.0f, 1.0f, 0.001f),
+        0.0f,
+        juce::String(),
+        juce::AudioProcessorParameter::outputMeter));
+
     return { params.begin(), params.end() };
 }
 
@@ -136,6 +266,11 @@ void HeartSyncVST3AudioProcessor::prepareToPlay(double sampleRate, int samplesPe
     smoothingFactorSmoothed.reset(sampleRate, 0.05);
     wetDryOffsetSmoothed.reset(sampleRate, 0.05);
     
+    // Forget the zone; a note still held from before is released by the first block
+    zoneTracker.reset();
+    currentHeartRateZone.store(-1);
+    zoneResetRequested.store(heldZoneNote >= 0);
+
     // Reset performance metrics
     resetPerformanceMetrics();
     
@@ -145,6 +280,8 @@ void HeartSyncVST3AudioProcessor::prepareToPlay(double sampleRate, int samplesPe
 
 void HeartSyncVST3AudioProcessor::releaseResources()
 {
+    // No MIDI buffer here: the held zone note gets its note-off in the next processed block
+    zoneResetRequested.store(true);
     logSystemMessage("DSP resources released");
 }
 
@@ -166,7 +303,6 @@ void HeartSyncVST3AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     auto startTime = std::chrono::high_resolution_clock::now();
     
     juce::ScopedNoDenormals noDenormals;
-    juce::ignoreUnused(midiMessages);
     
     auto totalNumInputChannels = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
@@ -176,7 +312,11 @@ void HeartSyncVST3AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
         buffer.clear(i, 0, buffer.getNumSamples());
 
     // Update biometric parameters from Bluetooth data
+    pollBridgeHeartRate();
+    recordConsumeLatency();
     updateBiometricParameters();
+    updateHeartRateZone(midiMessages, buffer.getNumSamples());
+    updateRespirationParameters();
     
     // Update smoothed parameter values (sample-accurate)
     heartRateOffsetSmoothed.setTargetValue(*parameters.getRawParameterValue(PARAM_HEART_RATE_OFFSET));
@@ -221,10 +361,11 @@ void HeartSyncVST3AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
 
 void HeartSyncVST3AudioProcessor::processBlockBypassed(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
-    juce::ignoreUnused(midiMessages);
-    
-    // Still update biometric data when bypassed
+    // Still update biometric data when bypassed, but release the zone note
+    pollBridgeHeartRate();
+    recordConsumeLatency();
     updateBiometricParameters();
+    resetHeartRateZone(midiMessages);
     
     // Pass audio through unchanged
     auto totalNumInputChannels = getTotalNumInputChannels();
@@ -321,74 +462,11 @@ HeartSyncVST3AudioProcessor::BiometricData HeartSyncVST3AudioProcessor::getCurre
     return currentBiometricData;
 }
 
-std::vector<float> HeartSyncVST3AudioProcessor::getRawHeartRateHistory() const
-{
-    const juce::SpinLock::ScopedLockType lock(historyDataLock);
-    const auto capacity = rawHeartRateHistory.size();
-    const auto count = std::min(historyCount, capacity);
-
-    std::vector<float> ordered;
-    ordered.reserve(count);
-    if (count == 0)
-        return ordered;
-
-    const size_t startIndex = (count == capacity) ? historyWriteIndex : 0;
-    for (size_t i = 0; i < count; ++i)
-    {
-        const size_t idx = (startIndex + i) % capacity;
-        ordered.push_back(rawHeartRateHistory[idx]);
-    }
-
-    return ordered;
-}
-
-std::vector<float> HeartSyncVST3AudioProcessor::getSmoothedHeartRateHistory() const
-{
-    const juce::SpinLock::ScopedLockType lock(historyDataLock);
-    const auto capacity = smoothedHeartRateHistory.size();
-    const auto count = std::min(historyCount, capacity);
-
-    std::vector<float> ordered;
-    ordered.reserve(count);
-    if (count == 0)
-        return ordered;
-
-    const size_t startIndex = (count == capacity) ? historyWriteIndex : 0;
-    for (size_t i = 0; i < count; ++i)
-    {
-        const size_t idx = (startIndex + i) % capacity;
-        ordered.push_back(smoothedHeartRateHistory[idx]);
-    }
-
-    return ordered;
-}
-
-std::vector<float> HeartSyncVST3AudioProcessor::getWetDryHistory() const
-{
-    const juce::SpinLock::ScopedLockType lock(historyDataLock);
-    const auto capacity = wetDryHistory.size();
-    const auto count = std::min(historyCount, capacity);
-
-    std::vector<float> ordered;
-    ordered.reserve(count);
-    if (count == 0)
-        return ordered;
-
-    const size_t startIndex = (count == capacity) ? historyWriteIndex : 0;
-    for (size_t i = 0; i < count; ++i)
-    {
-        const size_t idx = (startIndex + i) % capacity;
-        ordered.push_back(wetDryHistory[idx]);
-    }
-
-    return ordered;
-}
-
 //==============================================================================
 // Device management
 bool HeartSyncVST3AudioProcessor::isBluetoothAvailable() const
 {
-#if JUCE_MAC
+#if HEARTSYNC_HAS_BRIDGE_CLIENT
     if (bridgeClient && bridgeClient->isConnected())
         return bridgeAvailable.load();
 #endif
@@ -397,7 +475,7 @@ bool HeartSyncVST3AudioProcessor::isBluetoothAvailable() const
 
 bool HeartSyncVST3AudioProcessor::isDeviceConnected() const
 {
-#if JUCE_MAC
+#if HEARTSYNC_HAS_BRIDGE_CLIENT
     if (bridgeClient && bridgeClient->isConnected())
         return bridgeDeviceConnected.load();
 #endif
@@ -406,7 +484,7 @@ bool HeartSyncVST3AudioProcessor::isDeviceConnected() const
 
 bool HeartSyncVST3AudioProcessor::isScanning() const
 {
-#if JUCE_MAC
+#if HEARTSYNC_HAS_BRIDGE_CLIENT
     if (bridgeClient && bridgeClient->isConnected())
         return bridgeScanning.load();
 #endif
@@ -415,7 +493,7 @@ bool HeartSyncVST3AudioProcessor::isScanning() const
 
 bool HeartSyncVST3AudioProcessor::isBluetoothReady() const
 {
-#if JUCE_MAC
+#if HEARTSYNC_HAS_BRIDGE_CLIENT
     if (bridgeClient && bridgeClient->isConnected())
         return bridgeReady.load();
 #endif
@@ -424,15 +502,12 @@ bool HeartSyncVST3AudioProcessor::isBluetoothReady() const
 
 std::string HeartSyncVST3AudioProcessor::getConnectedDeviceName() const
 {
-#if JUCE_MAC
+#if HEARTSYNC_HAS_BRIDGE_CLIENT
     if (bridgeClient && bridgeClient->isConnected())
     {
-        const juce::ScopedLock lock(bridgeDevicesLock);
-        for (const auto& device : bridgeDevices)
-        {
-            if (device.identifier == bridgeCurrentDeviceId.toStdString())
-                return device.name;
-        }
+        DeviceInfo device;
+        if (bridgeDevices.findDevice(bridgeCurrentDeviceId.toStdString(), device))
+            return device.name;
         return bridgeCurrentDeviceId.isNotEmpty() ? bridgeCurrentDeviceId.toStdString() : "Not Connected";
     }
 #endif
@@ -441,41 +516,58 @@ std::string HeartSyncVST3AudioProcessor::getConnectedDeviceName() const
 
 std::vector<HeartSyncVST3AudioProcessor::DeviceInfo> HeartSyncVST3AudioProcessor::getAvailableDevices() const
 {
-    std::vector<DeviceInfo> devices;
-#if JUCE_MAC
+#if HEARTSYNC_HAS_BRIDGE_CLIENT
+    if (bridgeClient && bridgeClient->isConnected())
+        return bridgeDevices.getDevices();
+#endif
+
+    syncNativeDevices();
+    return nativeDevices.getDevices();
+}
+
+void HeartSyncVST3AudioProcessor::getDeviceChanges(const DeviceRegistry::Cursor& cursor,
+                                                   DeviceRegistry::Changes& changes) const
+{
+#if HEARTSYNC_HAS_BRIDGE_CLIENT
     if (bridgeClient && bridgeClient->isConnected())
     {
-        const juce::ScopedLock lock(bridgeDevicesLock);
-        devices = bridgeDevices;
-        return devices;
+        bridgeDevices.getChangesSince(cursor, changes);
+        return;
     }
 #endif
 
-    if (bluetoothManager)
+    syncNativeDevices();
+    nativeDevices.getChangesSince(cursor, changes);
+}
+
+void HeartSyncVST3AudioProcessor::syncNativeDevices() const
+{
+    if (! bluetoothManager)
+        return;
+
+    const auto discovered = bluetoothManager->getDiscoveredDevices();
+
+    // The manager only forgets devices when a new scan starts; start the registry over with it
+    if (discovered.size() < nativeDevices.getNumDevices())
+        nativeDevices.clear();
+
+    std::string connectedId;
+    for (const auto& device : discovered)
     {
-        auto bluetoothDevices = bluetoothManager->getDiscoveredDevices();
-        devices.reserve(bluetoothDevices.size());
-        
-        for (const auto& btDevice : bluetoothDevices)
-        {
-            DeviceInfo device;
-            device.name = btDevice.name;
-            device.identifier = btDevice.identifier;
-            device.signalStrength = btDevice.rssi;
-            device.isConnected = btDevice.isConnected;
-            device.lastSeen = std::chrono::steady_clock::now(); // Could be improved with actual timestamp from BT manager
-            devices.push_back(device);
-        }
+        // didDiscoverPeripheral only keeps Heart Rate devices, so every entry offers the service
+        nativeDevices.report(device.identifier, device.name, device.rssi, { "180D" });
+        if (device.isConnected)
+            connectedId = device.identifier;
     }
-    
-    return devices;
+
+    nativeDevices.setConnected(connectedId);
 }
 
 //==============================================================================
 // Device control
 juce::Result HeartSyncVST3AudioProcessor::startDeviceScan()
 {
-#if JUCE_MAC
+#if HEARTSYNC_HAS_BRIDGE_CLIENT
     const bool nativeReady = bluetoothManager && bluetoothManager->isReady();
     if (bridgeClient)
     {
@@ -483,7 +575,7 @@ juce::Result HeartSyncVST3AudioProcessor::startDeviceScan()
         {
             if (!bridgeReady.load())
             {
-                logSystemMessage("Bridge not ready; waiting for permission state " + bridgePermissionState);
+                logSystemMessage("Bridge not ready; waiting for permission state " + bridgePermissionState, LogMessageQueue::Severity::Warning);
                 return juce::Result::fail("Bridge not ready");
             }
 
@@ -495,7 +587,7 @@ juce::Result HeartSyncVST3AudioProcessor::startDeviceScan()
 
         if (!nativeReady)
         {
-            logSystemMessage("HeartSync Bridge helper not connected; attempting reconnect");
+            logSystemMessage("HeartSync Bridge helper not connected; attempting reconnect", LogMessageQueue::Severity::Warning);
             bridgeClient->launchBridge();
             bridgeClient->connectToBridge();
             return juce::Result::fail("Bridge not connected");
@@ -524,7 +616,7 @@ juce::Result HeartSyncVST3AudioProcessor::startDeviceScan()
 
 void HeartSyncVST3AudioProcessor::stopDeviceScan()
 {
-#if JUCE_MAC
+#if HEARTSYNC_HAS_BRIDGE_CLIENT
     if (bridgeClient && bridgeClient->isConnected())
     {
         bridgeClient->startScan(false);
@@ -543,7 +635,7 @@ void HeartSyncVST3AudioProcessor::stopDeviceScan()
 
 juce::Result HeartSyncVST3AudioProcessor::connectToDevice(const std::string& deviceIdentifier)
 {
-#if JUCE_MAC
+#if HEARTSYNC_HAS_BRIDGE_CLIENT
     const bool nativeReady = bluetoothManager && bluetoothManager->isReady();
     if (bridgeClient)
     {
@@ -551,7 +643,7 @@ juce::Result HeartSyncVST3AudioProcessor::connectToDevice(const std::string& dev
         {
             if (!bridgeReady.load())
             {
-                logSystemMessage("Bridge not ready; cannot connect to device");
+                logSystemMessage("Bridge not ready; cannot connect to device", LogMessageQueue::Severity::Warning);
                 return juce::Result::fail("Bridge not ready");
             }
 
@@ -563,7 +655,8 @@ juce::Result HeartSyncVST3AudioProcessor::connectToDevice(const std::string& dev
 
         if (!nativeReady)
         {
-            logSystemMessage("HeartSync Bridge helper not connected; attempting reconnect before device connection");
+            logSystemMessage("HeartSync Bridge helper not connected; attempting reconnect before device connection",
+                             LogMessageQueue::Severity::Warning);
             bridgeClient->launchBridge();
             bridgeClient->connectToBridge();
             return juce::Result::fail("Bridge not connected");
@@ -590,7 +683,7 @@ juce::Result HeartSyncVST3AudioProcessor::connectToDevice(const std::string& dev
 
 void HeartSyncVST3AudioProcessor::disconnectDevice()
 {
-#if JUCE_MAC
+#if HEARTSYNC_HAS_BRIDGE_CLIENT
     if (bridgeClient && bridgeClient->isConnected())
     {
         bridgeClient->disconnectDevice();
@@ -617,7 +710,7 @@ bool HeartSyncVST3AudioProcessor::isNativeBluetoothReady() const
     return bluetoothManager ? bluetoothManager->isReady() : false;
 }
 
-#if JUCE_MAC
+#if HEARTSYNC_HAS_BRIDGE_CLIENT
 bool HeartSyncVST3AudioProcessor::isBridgeClientConfigured() const
 {
     return bridgeClient != nullptr;
@@ -671,6 +764,15 @@ HeartSyncVST3AudioProcessor::PerformanceMetrics HeartSyncVST3AudioProcessor::get
         double blockDurationMs = (getBlockSize() / getSampleRate()) * 1000.0;
         metrics.cpuUsagePercent = (metrics.averageProcessingTimeMs / blockDurationMs) * 100.0;
     }
+
+    if (bridgeClient != nullptr)
+    {
+        metrics.receiveLatency = bridgeClient->getReceiveLatency().getSummary();
+        metrics.dispatchLatency = bridgeClient->getDispatchLatency().getSummary();
+    }
+
+    metrics.publishLatency = publishLatency.getSummary();
+    metrics.consumeLatency = consumeLatency.getSummary();
     
     return metrics;
 }
@@ -681,18 +783,46 @@ void HeartSyncVST3AudioProcessor::resetPerformanceMetrics()
     peakProcessingTime.store(0.0);
     processBlockCount.store(0);
     lastResetTime = std::chrono::steady_clock::now();
+
+    if (bridgeClient != nullptr)
+        bridgeClient->resetLatencyStats();
+
+    publishLatency.reset();
+    consumeLatency.reset();
+}
+
+void HeartSyncVST3AudioProcessor::recordConsumeLatency()
+{
+    // Audio thread. Measured when a new sample first becomes visible here;
+    // the jitter buffer's playout delay, when enabled, comes on top
+    const auto sampleCount = heartRateSampleCount.load();
+    if (sampleCount == consumedSampleCount)
+        return;
+
+    consumedSampleCount = sampleCount;
+    consumeLatency.record(juce::Time::getMillisecondCounterHiRes() - lastHeartRateSampleMs.load());
 }
 
 //==============================================================================
 // Internal processing methods
 void HeartSyncVST3AudioProcessor::updateBiometricParameters()
 {
-#if JUCE_MAC
+#if HEARTSYNC_HAS_BRIDGE_CLIENT
     if (bridgeClient && bridgeClient->isConnected() && bridgeDataValid.load())
     {
         // CRITICAL DATA FLOW (matching Python):
-        // 1. Raw HR from device
-        const float measuredHr = bridgeRawHeartRate.load();
+        // 1. Raw HR from device (optionally replayed through the jitter buffer)
+        float measuredHr = bridgeRawHeartRate.load();
+
+        if (parameters.getRawParameterValue(PARAM_JITTER_BUFFER_ENABLED)->load() > 0.5f)
+        {
+            bridgeJitterBuffer.setPlayoutLatencyMs(parameters.getRawParameterValue(PARAM_JITTER_BUFFER_LATENCY)->load());
+
+            float playoutHr = 0.0f;
+            measuredHr = bridgeJitterBuffer.read(juce::Time::getMillisecondCounterHiRes(), playoutHr)
+                ? playoutHr
+                : 0.0f; // still filling the playout window
+        }
         
         // Check if we actually have valid heart rate data
         if (measuredHr <= 0)
@@ -713,11 +843,21 @@ void HeartSyncVST3AudioProcessor::updateBiometricParameters()
         if (!bridgeSmootherInitialised)
         {
             bridgeSmoothedValue = adjustedRawHr;
+            adaptiveSmoother.reset();
             bridgeSmootherInitialised = true;
         }
         
-        const float alpha = smoothingFactor;
-        bridgeSmoothedValue = bridgeSmoothedValue + alpha * (adjustedRawHr - bridgeSmoothedValue);
+        if (isAdaptiveSmoothingEnabled())
+        {
+            bridgeSmoothedValue = applyAdaptiveSmoothing(adjustedRawHr, bridgeRawHeartRate.load() + hrOffset);
+        }
+        else
+        {
+            const float alpha = smoothingFactor;
+            bridgeSmoothedValue = bridgeSmoothedValue + alpha * (adjustedRawHr - bridgeSmoothedValue);
+            effectiveSmoothingAlpha.store(alpha);
+            effectiveSmoothingTimeConstant.store(0.0f);
+        }
         const float smoothedHr = bridgeSmoothedValue;
         
         // 4. Calculate wet/dry based on difference, then apply WET/DRY OFFSET → This is displayed "WET/DRY RATIO"
@@ -780,9 +920,19 @@ void HeartSyncVST3AudioProcessor::updateBiometricParameters()
     const float smoothingFactor = juce::jlimit(0.01f, 1.0f,
         parameters.getRawParameterValue(PARAM_SMOOTHING_FACTOR)->load());
     
-    // Update smoothing (maintain state in bluetoothManager)
+    // Update smoothing (maintain state in bluetoothManager unless adaptive mode owns it)
     bluetoothManager->setSmoothingFactor(smoothingFactor);
     float smoothedHr = bluetoothManager->getSmoothedHeartRate();
+
+    if (isAdaptiveSmoothingEnabled())
+    {
+        smoothedHr = applyAdaptiveSmoothing(adjustedRawHr, adjustedRawHr);
+    }
+    else
+    {
+        effectiveSmoothingAlpha.store(smoothingFactor);
+        effectiveSmoothingTimeConstant.store(0.0f);
+    }
     
     const float wetDryOffset = parameters.getRawParameterValue(PARAM_WET_DRY_OFFSET)->load();
     const bool useSmoothed = parameters.getRawParameterValue(PARAM_WET_DRY_INPUT_SOURCE)->load() > 0.5f;
@@ -821,7 +971,7 @@ void HeartSyncVST3AudioProcessor::updateBiometricParameters()
         wetDryParam->setValueNotifyingHost(wetDryNorm);
     }
     
-    // Update history arrays with offset-adjusted values
+    // Record offset-adjusted values in the history
     addToHistory(adjustedRawHr, smoothedHr, wetDry);
     
     // Update tempo sync if enabled
@@ -840,6 +990,34 @@ void HeartSyncVST3AudioProcessor::updateBiometricParameters()
         onBiometricDataUpdated();
 }
 
+bool HeartSyncVST3AudioProcessor::isAdaptiveSmoothingEnabled() const
+{
+    return parameters.getRawParameterValue(PARAM_ADAPTIVE_SMOOTHING)->load() > 0.5f;
+}
+
+float HeartSyncVST3AudioProcessor::applyAdaptiveSmoothing(float adjustedHr, float latestMeasurement)
+{
+    adaptiveSmoother.setTimeConstantRange(parameters.getRawParameterValue(PARAM_ADAPTIVE_TAU_MIN)->load(),
+                                          parameters.getRawParameterValue(PARAM_ADAPTIVE_TAU_MAX)->load());
+
+    // Variance statistics only see genuine sensor readings, never repeated block values
+    const auto sampleCount = heartRateSampleCount.load();
+    if (sampleCount != adaptiveSampleCount)
+    {
+        adaptiveSampleCount = sampleCount;
+        adaptiveSmoother.addMeasurement(latestMeasurement, lastHeartRateSampleMs.load() / 1000.0);
+    }
+
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    const float dtSeconds = lastAdaptiveAdvanceMs > 0.0 ? (float)((nowMs - lastAdaptiveAdvanceMs) / 1000.0) : 0.0f;
+    lastAdaptiveAdvanceMs = nowMs;
+
+    const float smoothed = adaptiveSmoother.advance(adjustedHr, dtSeconds);
+    effectiveSmoothingAlpha.store(adaptiveSmoother.getMeasurementAlpha());
+    effectiveSmoothingTimeConstant.store(adaptiveSmoother.getTimeConstant());
+    return smoothed;
+}
+
 //==============================================================================
 // Tempo Sync Implementation
 void HeartSyncVST3AudioProcessor::setTempoSyncSource(TempoSyncSource source)
@@ -932,17 +1110,118 @@ float HeartSyncVST3AudioProcessor::mapValueToTempo(float value, TempoSyncSource
     return juce::jlimit(60.0f, 200.0f, targetTempo);
 }
 
+//==============================================================================
+// Heart-rate zones
+void HeartSyncVST3AudioProcessor::updateHeartRateZone(juce::MidiBuffer& midiMessages, int numSamples)
+{
+    if (zoneResetRequested.exchange(false))
+        resetHeartRateZone(midiMessages);
+
+    const auto midiOutput = static_cast<ZoneMidiOutput>(
+        juce::roundToInt(parameters.getRawParameterValue(PARAM_ZONE_MIDI_OUTPUT)->load()));
+
+    // Release a held zone note as soon as note output is switched away
+    if (heldZoneNote >= 0 && midiOutput != ZoneMidiOutput::Note)
+    {
+        midiMessages.addEvent(juce::MidiMessage::noteOff(heldZoneNoteChannel, heldZoneNote), 0);
+        heldZoneNote = -1;
+    }
+
+    float heartRate = 0.0f;
+    bool dataValid = false;
+    {
+        const juce::SpinLock::ScopedLockType lock(biometricDataLock);
+        dataValid = currentBiometricData.isDataValid;
+        heartRate = currentBiometricData.smoothedHeartRate;
+    }
+
+    // No data: nothing should keep sounding, and the zone is announced afresh when data returns
+    if (! dataValid)
+    {
+        resetHeartRateZone(midiMessages);
+        return;
+    }
+
+    HeartRateZoneTracker::Config config;
+    config.mode = static_cast<HeartRateZoneTracker::Mode>(
+        juce::roundToInt(parameters.getRawParameterValue(PARAM_ZONE_MODE)->load()));
+    config.maxHeartRate = parameters.getRawParameterValue(PARAM_ZONE_MAX_HR)->load();
+    config.restingHeartRate = parameters.getRawParameterValue(PARAM_ZONE_REST_HR)->load();
+    config.hysteresisBpm = parameters.getRawParameterValue(PARAM_ZONE_HYSTERESIS)->load();
+    for (size_t i = 0; i < config.boundaries.size(); ++i)
+        config.boundaries[i] = zoneBoundaryValues[i]->load();
+    zoneTracker.setConfig(config);
+
+    float crossingFraction = 0.0f;
+    if (! zoneTracker.update(heartRate, crossingFraction))
+        return;
+
+    const int zone = zoneTracker.getZone();
+    currentHeartRateZone.store(zone);
+
+    if (auto* zoneParam = parameters.getParameter(PARAM_HR_ZONE))
+        zoneParam->setValueNotifyingHost(zoneParam->convertTo0to1((float)zone));
+
+    if (midiOutput == ZoneMidiOutput::Off)
+        return;
+
+    // The heart rate moves linearly across the block, so place the event where it crossed
+    const int lastSample = juce::jmax(0, numSamples - 1);
+    const int offset = juce::jlimit(0, lastSample, juce::roundToInt(crossingFraction * (float)lastSample));
+    const int channel = juce::roundToInt(parameters.getRawParameterValue(PARAM_ZONE_MIDI_CHANNEL)->load());
+    const int value = juce::jlimit(0, 127, juce::roundToInt(parameters.getRawParameterValue(PARAM_ZONE_MIDI_BASE)->load()) + zone);
+
+    if (midiOutput == ZoneMidiOutput::ProgramChange)
+    {
+        midiMessages.addEvent(juce::MidiMessage::programChange(channel, value), offset);
+    }
+    else
+    {
+        if (heldZoneNote >= 0)
+            midiMessages.addEvent(juce::MidiMessage::noteOff(heldZoneNoteChannel, heldZoneNote), offset);
+
+        midiMessages.addEvent(juce::MidiMessage::noteOn(channel, value, (juce::uint8)100), offset);
+        heldZoneNote = value;
+        heldZoneNoteChannel = channel;
+    }
+}
+
+void HeartSyncVST3AudioProcessor::resetHeartRateZone(juce::MidiBuffer& midiMessages)
+{
+    if (heldZoneNote >= 0)
+    {
+        midiMessages.addEvent(juce::MidiMessage::noteOff(heldZoneNoteChannel, heldZoneNote), 0);
+        heldZoneNote = -1;
+    }
+
+    zoneTracker.reset();
+    currentHeartRateZone.store(-1);
+}
+
+//==============================================================================
+// Respiration
+void HeartSyncVST3AudioProcessor::updateRespirationParameters()
+{
+    const auto state = analysisWorker.getRespirationState();
+    if (! state.valid)
+        return;
+
+    if (auto* rateParam = parameters.getParameter(PARAM_RESPIRATION_RATE))
+        rateParam->setValueNotifyingHost(rateParam->convertTo0to1(juce::jlimit(0.0f, 40.0f, state.breathsPerMinute)));
+    if (auto* phaseParam = parameters.getParameter(PARAM_BREATH_PHASE))
+        phaseParam->setValueNotifyingHost(state.getPhaseAt(juce::Time::getMillisecondCounterHiRes()));
+}
+
 void HeartSyncVST3AudioProcessor::addToHistory(float rawHr, float smoothedHr, float wetDry)
 {
-    const juce::SpinLock::ScopedLockType lock(historyDataLock);
-    
-    rawHeartRateHistory[historyWriteIndex] = rawHr;
-    smoothedHeartRateHistory[historyWriteIndex] = smoothedHr;
-    wetDryHistory[historyWriteIndex] = wetDry;
-    
-    historyWriteIndex = (historyWriteIndex + 1) % rawHeartRateHistory.size();
-    if (historyCount < rawHeartRateHistory.size())
-        ++historyCount;
+    // Called every block; the history keeps a fixed rate so its span does not depend on the buffer size
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    if (nowMs < nextHistoryMs)
+        return;
+
+    nextHistoryMs = nowMs - nextHistoryMs < HISTORY_INTERVAL_MS ? nextHistoryMs + HISTORY_INTERVAL_MS
+                                                                : nowMs + HISTORY_INTERVAL_MS;
+    biometricHistory.push({ rawHr, smoothedHr, wetDry, nowMs });
 }
 
 void HeartSyncVST3AudioProcessor::logError(const juce::String& error) const
@@ -955,10 +1234,13 @@ void HeartSyncVST3AudioProcessor::logError(const juce::String& error) const
     // TODO: Implement thread-safe error logging without const issues
 }
 
-void HeartSyncVST3AudioProcessor::logSystemMessage(const juce::String& message) const
+void HeartSyncVST3AudioProcessor::logSystemMessage(const juce::String& message,
+                                                   LogMessageQueue::Severity severity) const
 {
     DBG("HeartSync: " << message);
-    
+
+    systemMessages.push(severity, message.toStdString());
+
     if (onSystemMessage)
         onSystemMessage(message);
 }
@@ -967,8 +1249,14 @@ void HeartSyncVST3AudioProcessor::logSystemMessage(const juce::String& message)
 // Bluetooth event handlers
 void HeartSyncVST3AudioProcessor::handleHeartRateData(float heartRate)
 {
-    juce::ignoreUnused(heartRate);
-    // Heart rate processing is handled in updateBiometricParameters()
+    // Heart rate processing is handled in updateBiometricParameters();
+    // only record the arrival so per-measurement statistics stay accurate.
+    // The callback time is the sample's source timestamp on this path.
+    if (heartRate > 0.0f)
+    {
+        lastHeartRateSampleMs.store(juce::Time::getMillisecondCounterHiRes());
+        heartRateSampleCount.fetch_add(1);
+    }
 }
 
 void HeartSyncVST3AudioProcessor::handleBluetoothStateChange()
@@ -988,14 +1276,14 @@ void HeartSyncVST3AudioProcessor::handleSystemMessage(const std::string& message
     logSystemMessage(juce::String(message));
 }
 
-#if JUCE_MAC
+#if HEARTSYNC_HAS_BRIDGE_CLIENT
 void HeartSyncVST3AudioProcessor::initialiseBridgeClient()
 {
     logSystemMessage("Initializing HeartSync Bridge helper interface");
     bridgeClient = std::make_unique<HeartSyncBLEClient>();
 
     bridgeClient->onLog = [this](const juce::String& message) {
-        logSystemMessage("Bridge: " + message);
+        logSystemMessage("Bridge: " + message, LogMessageQueue::Severity::Debug);
     };
 
     bridgeClient->onBridgeConnected = [this]() {
@@ -1013,14 +1301,14 @@ void HeartSyncVST3AudioProcessor::initialiseBridgeClient()
         bridgeDeviceConnected.store(false);
         bridgeDataValid.store(false);
         bridgeSmootherInitialised = false;
+        bridgeJitterBuffer.requestReset();
+        analysisWorker.requestReset();
+        zoneResetRequested.store(true);
         bridgeCurrentDeviceId.clear();
 
-        {
-            const juce::ScopedLock lock(bridgeDevicesLock);
-            bridgeDevices.clear();
-        }
+        bridgeDevices.clear();
 
-        logSystemMessage("Bridge helper disconnected");
+        logSystemMessage("Bridge helper disconnected", LogMessageQueue::Severity::Warning);
         if (onBluetoothStateChanged)
             onBluetoothStateChanged();
     };
@@ -1038,44 +1326,50 @@ void HeartSyncVST3AudioProcessor::initialiseBridgeClient()
     };
 
     bridgeClient->onDeviceFound = [this](const HeartSyncBLEClient::DeviceInfo& info) {
-        logSystemMessage("Processor: Received device from bridge - id: '" + info.id + "', name: '" + info.name + "'");
+        logSystemMessage("Processor: Received device from bridge - id: '" + info.id + "', name: '" + info.name + "'",
+                         LogMessageQueue::Severity::Debug);
         
-        DeviceInfo device;
-        device.identifier = info.id.toStdString();
-        device.name = info.getDisplayName().toStdString();
-        device.signalStrength = info.rssi;
-        device.isConnected = (info.id == bridgeCurrentDeviceId);
-        device.lastSeen = std::chrono::steady_clock::now();
-        device.services.clear();
+        std::vector<std::string> services;
+        services.reserve((size_t)info.services.size());
         for (const auto& service : info.services)
-            device.services.push_back(service.toStdString());
+            services.push_back(service.toStdString());
 
-        {
-            const juce::ScopedLock lock(bridgeDevicesLock);
-            bool updated = false;
-            for (auto& existing : bridgeDevices)
-            {
-                if (existing.identifier == device.identifier)
-                {
-                    existing = device;
-                    updated = true;
-                    break;
-                }
-            }
+        // Scans re-report the same devices every few hundred ms; only real changes go to the UI
+        if (! bridgeDevices.report(info.id.toStdString(), info.getDisplayName().toStdString(), info.rssi, services))
+            return;
 
-            if (!updated)
-                bridgeDevices.push_back(device);
-        }
+        if (info.id == bridgeCurrentDeviceId)
+            bridgeDevices.setConnected(info.id.toStdString());
 
-        logSystemMessage("Processor: Device list now has " + juce::String(bridgeDevices.size()) + " devices");
+        logSystemMessage("Processor: Device list now has " + juce::String((int)bridgeDevices.getNumDevices()) + " devices",
+                         LogMessageQueue::Severity::Debug);
 
         if (onDeviceListUpdated)
             onDeviceListUpdated();
     };
 
-    bridgeClient->onHeartRate = [this](float bpm, juce::Array<float> rr) {
-        juce::ignoreUnused(rr);
-        updateBridgeBiometrics(bpm);
+    bridgeClient->onHeartRate = [this](float bpm, juce::Array<float> rr, double timestampMs) {
+        if (sharedBiometricRing.load() != nullptr)
+            return; // callbacks queued before the ring was attached
+
+        queueSocketHeartRate(bpm, timestampMs);
+        analysisWorker.pushRRIntervals(rr, timestampMs);
+    };
+
+    bridgeClient->onRrIntervals = [this](juce::Array<float> rr, double timestampMs) {
+        if (sharedBiometricRing.load() == nullptr)
+            analysisWorker.pushRRIntervals(rr, timestampMs);
+    };
+
+    bridgeClient->onSharedRingChanged = [this](const BiometricSharedRing* ring) {
+        sharedBiometricRing.store(ring);
+        analysisWorker.setSharedRing(ring);
+        logSystemMessage(ring != nullptr ? "Bridge heart rate via shared memory" : "Bridge heart rate via socket");
+    };
+
+    bridgeClient->onEcgSamples = [this](const float* samples, int numSamples, double sampleRateHz,
+                                        bool discontinuity, double timestampMs) {
+        analysisWorker.pushEcgSamples(samples, numSamples, sampleRateHz, discontinuity, timestampMs);
     };
 
     bridgeClient->onConnected = [this](const juce::String& deviceId) {
@@ -1084,11 +1378,10 @@ void HeartSyncVST3AudioProcessor::initialiseBridgeClient()
         bridgeScanning.store(false);
         bridgeDataValid.store(false);
 
-        {
-            const juce::ScopedLock lock(bridgeDevicesLock);
-            for (auto& device : bridgeDevices)
-                device.isConnected = (device.identifier == deviceId.toStdString());
-        }
+        bridgeDevices.setConnected(deviceId.toStdString());
+
+        // Straps without an ECG stream simply never send ECG frames
+        bridgeClient->setEcgStreaming(true);
 
         logSystemMessage("Bridge connected to device: " + deviceId);
         if (onDeviceListUpdated)
@@ -1102,14 +1395,13 @@ void HeartSyncVST3AudioProcessor::initialiseBridgeClient()
         bridgeDataValid.store(false);
         bridgeCurrentDeviceId.clear();
         bridgeSmootherInitialised = false;
+        bridgeJitterBuffer.requestReset();
+        analysisWorker.requestReset();
+        zoneResetRequested.store(true);
 
-        {
-            const juce::ScopedLock lock(bridgeDevicesLock);
-            for (auto& device : bridgeDevices)
-                device.isConnected = false;
-        }
+        bridgeDevices.setConnected({});
 
-        logSystemMessage("Bridge disconnected: " + reason);
+        logSystemMessage("Bridge disconnected: " + reason, LogMessageQueue::Severity::Warning);
         if (onDeviceListUpdated)
             onDeviceListUpdated();
         if (onBluetoothStateChanged)
@@ -1117,7 +1409,7 @@ void HeartSyncVST3AudioProcessor::initialiseBridgeClient()
     };
 
     bridgeClient->onError = [this](const juce::String& error) {
-        logSystemMessage("Bridge error: " + error);
+        logSystemMessage("Bridge error: " + error, LogMessageQueue::Severity::Error);
         logError("Bridge error: " + error);
     };
 
@@ -1125,15 +1417,88 @@ void HeartSyncVST3AudioProcessor::initialiseBridgeClient()
     bridgeClient->connectToBridge();
 }
 
-void HeartSyncVST3AudioProcessor::updateBridgeBiometrics(float bpm)
+void HeartSyncVST3AudioProcessor::queueSocketHeartRate(float bpm, double timestampMs)
+{
+    // Message thread; the audio thread moves it into the jitter buffer
+    if (bpm > 0.0f)
+        publishLatency.record(juce::Time::getMillisecondCounterHiRes() - timestampMs);
+
+    const auto scope = socketHeartRateFifo.write(1);
+    if (scope.blockSize1 > 0)
+        socketHeartRates[(size_t)scope.startIndex1] = { timestampMs, bpm };
+}
+
+void HeartSyncVST3AudioProcessor::updateBridgeBiometrics(float bpm, double timestampMs)
 {
+    // Audio thread only
     bridgeRawHeartRate.store(bpm);
     bridgeDataValid.store(bpm > 0.0f);
+
+    if (bpm > 0.0f)
+    {
+        bridgeJitterBuffer.push(timestampMs, bpm);
+        lastHeartRateSampleMs.store(timestampMs);
+        heartRateSampleCount.fetch_add(1);
+    }
+}
+
+void HeartSyncVST3AudioProcessor::pollBridgeHeartRate()
+{
+    // Audio thread. The queue and ring reads are wait-free and the jitter
+    // buffer push is lock-free, so this stays real-time safe; the per-block
+    // cap bounds the ring work after a stall.
+    static constexpr int maxRecordsPerBlock = 32;
+
+    // Socket samples first: anything queued before the ring took over is older
+    {
+        const auto scope = socketHeartRateFifo.read(socketHeartRateFifo.getNumReady());
+
+        for (int i = 0; i < scope.blockSize1; ++i)
+        {
+            const auto& sample = socketHeartRates[(size_t)(scope.startIndex1 + i)];
+            updateBridgeBiometrics(sample.bpm, sample.timestampMs);
+        }
+
+        for (int i = 0; i < scope.blockSize2; ++i)
+        {
+            const auto& sample = socketHeartRates[(size_t)(scope.startIndex2 + i)];
+            updateBridgeBiometrics(sample.bpm, sample.timestampMs);
+        }
+    }
+
+    const auto* ring = sharedBiometricRing.load();
+    if (ring != audioThreadRing)
+    {
+        audioThreadRing = ring;
+        if (ring != nullptr)
+            audioThreadRingCursor = ring->makeCursor();
+    }
+
+    if (ring == nullptr)
+        return;
+
+    BiometricSharedRing::Record record;
+    for (int i = 0; i < maxRecordsPerBlock; ++i)
+    {
+        const auto result = ring->read(audioThreadRingCursor, record);
+        if (result == BiometricSharedRing::ReadResult::Empty)
+            break;
+
+        if (result != BiometricSharedRing::ReadResult::Record
+            || record.type != BiometricSharedRing::RecordType::HeartRate)
+            continue;
+
+        // Arrival time on the host clock, independent of when this block polled
+        const double ageMs = (BiometricSharedRing::now() - record.timestampSeconds) * 1000.0;
+        updateBridgeBiometrics(record.bpm, juce::Time::getMillisecondCounterHiRes() - juce::jmax(0.0, ageMs));
+    }
 }
 #endif
-#if ! JUCE_MAC
+#if ! HEARTSYNC_HAS_BRIDGE_CLIENT
 void HeartSyncVST3AudioProcessor::initialiseBridgeClient() {}
-void HeartSyncVST3AudioProcessor::updateBridgeBiometrics(float) {}
+void HeartSyncVST3AudioProcessor::queueSocketHeartRate(float, double) {}
+void HeartSyncVST3AudioProcessor::updateBridgeBiometrics(float, double) {}
+void HeartSyncVST3AudioProcessor::pollBridgeHeartRate() {}
 #endif
 
 //==============================================================================
@@ -5,6 +5,14 @@
 #include <juce_dsp/juce_dsp.h>
 #include "Core/BluetoothManager.h"
 #include "Core/HeartSyncBLEClient.h"
+#include "Core/BiometricJitterBuffer.h"
+#include "Core/AdaptiveSmoother.h"
+#include "Core/HeartRateZones.h"
+#include "Core/AnalysisWorker.h"
+#include "Core/LatencyHistogram.h"
+#include "Core/BiometricHistory.h"
+#include "Core/LogMessageQueue.h"
+#include "Core/DeviceRegistry.h"
 #include <memory>
 #include <atomic>
 #include <array>
@@ -91,21 +99,34 @@ public:
     };
     
     BiometricData getCurrentBiometricData() const;
-    std::vector<float> getRawHeartRateHistory() const;
-    std::vector<float> getSmoothedHeartRateHistory() const;
-    std::vector<float> getWetDryHistory() const;
+
+    /** Lock-free; valid readings at 10 Hz newer than sinceVersion (0 for all). Reuse one snapshot to avoid allocating. */
+    void getBiometricHistory(BiometricHistory::Snapshot& snapshot, uint64_t sinceVersion = 0) const
+    {
+        biometricHistory.read(snapshot, sinceVersion);
+    }
+
+    uint64_t getBiometricHistoryVersion() const { return biometricHistory.getVersion(); }
+
+    BiometricJitterBuffer::Stats getJitterBufferStats() const { return bridgeJitterBuffer.getStats(); }
+    HeartSyncBLEClient::DispatchStats getBridgeDispatchStats() const
+    {
+        return bridgeClient != nullptr ? bridgeClient->getDispatchStats() : HeartSyncBLEClient::DispatchStats{};
+    }
+
+    HeartSyncBLEClient::ReconnectStats getBridgeReconnectStats() const
+    {
+        return bridgeClient != nullptr ? bridgeClient->getReconnectStats() : HeartSyncBLEClient::ReconnectStats{};
+    }
+
+    // Smoothing actually applied (adaptive mode publishes its per-sample values)
+    bool isAdaptiveSmoothingEnabled() const;
+    float getEffectiveSmoothingAlpha() const { return effectiveSmoothingAlpha.load(); }
+    float getEffectiveSmoothingTimeConstant() const { return effectiveSmoothingTimeConstant.load(); }
     
     //==============================================================================
     // Bluetooth device management
-    struct DeviceInfo
-    {
-        std::string name;
-        std::string identifier;
-        int signalStrength{0};
-        bool isConnected{false};
-        std::chrono::steady_clock::time_point lastSeen;
-        std::vector<std::string> services;
-    };
+    using DeviceInfo = DeviceRegistry::Device;
     
     bool isBluetoothAvailable() const;
     bool isDeviceConnected() const;
@@ -113,6 +134,9 @@ public:
     bool isBluetoothReady() const;
     std::string getConnectedDeviceName() const;
     std::vector<DeviceInfo> getAvailableDevices() const;
+
+    /** Devices changed since cursor; everything, with reset set, after a clear or a switch between bridge and native BLE. */
+    void getDeviceChanges(const DeviceRegistry::Cursor& cursor, DeviceRegistry::Changes& changes) const;
     
     //==============================================================================
     // Device control methods
@@ -136,6 +160,13 @@ public:
         double peakProcessingTimeMs{0.0};
         size_t totalProcessedBlocks{0};
         double cpuUsagePercent{0.0};
+
+        // Age of heart-rate samples at each hop, from their source timestamp
+        // (bridge notification time, or the BluetoothManager callback)
+        LatencyHistogram::Summary receiveLatency;    // decoded on the bridge socket thread
+        LatencyHistogram::Summary dispatchLatency;   // message-thread callback ran
+        LatencyHistogram::Summary publishLatency;    // handed to the audio-thread pipeline
+        LatencyHistogram::Summary consumeLatency;    // first processBlock that saw it
     };
     
     PerformanceMetrics getPerformanceMetrics() const;
@@ -148,6 +179,10 @@ public:
     std::function<void()> onDeviceListUpdated;
     std::function<void(const juce::String&)> onSystemMessage;
 
+    /** Message thread. Appends the system messages logged since the last call to batch. */
+    size_t drainSystemMessages(std::vector<LogMessageQueue::Message>& batch) { return systemMessages.drain(batch); }
+    uint64_t getNumDroppedSystemMessages() const { return systemMessages.getNumDropped(); }
+
     //==============================================================================
     // Tempo Sync Control
     enum class TempoSyncSource
@@ -163,6 +198,39 @@ public:
     juce::String getTempoSyncSourceName() const;
     float getCurrentSuggestedTempo() const { return currentSuggestedTempo; }
 
+    //==============================================================================
+    // Heart-rate zones (discrete modulation source, optional MIDI scene output)
+    enum class ZoneMidiOutput
+    {
+        Off = 0,
+        ProgramChange = 1,
+        Note = 2
+    };
+
+    int getCurrentHeartRateZone() const { return currentHeartRateZone.load(); } // -1 until valid data
+
+    //==============================================================================
+    // Respiration estimated from RR intervals (respiratory sinus arrhythmia)
+    AnalysisWorker::RespirationState getRespirationState() const { return analysisWorker.getRespirationState(); }
+
+    // Beats detected in the raw ECG stream (straps that expose one)
+    AnalysisWorker::EcgState getEcgState() const { return analysisWorker.getEcgState(); }
+
+    // Beat-to-beat intervals behind both, for HRV displays. Lock-free; reuse one snapshot.
+    void getRrHistory(RrHistory::Snapshot& snapshot, uint64_t sinceVersion = 0) const
+    {
+        analysisWorker.readRrHistory(snapshot, sinceVersion);
+    }
+
+    uint64_t getRrHistoryVersion() const { return analysisWorker.getRrHistoryVersion(); }
+
+    void getRrSpectrogram(RrSpectrogram::Snapshot& snapshot, uint64_t sinceVersion = 0) const
+    {
+        analysisWorker.readRrSpectrogram(snapshot, sinceVersion);
+    }
+
+    uint64_t getRrSpectrogramVersion() const { return analysisWorker.getRrSpectrogramVersion(); }
+
     //==============================================================================
     // Parameter IDs (public for UI binding)
     static const juce::String PARAM_RAW_HEART_RATE;
@@ -173,6 +241,22 @@ public:
     static const juce::String PARAM_WET_DRY_OFFSET;
     static const juce::String PARAM_WET_DRY_INPUT_SOURCE; // true=Smoothed, false=Raw
     static const juce::String PARAM_TEMPO_SYNC_SOURCE;    // 0=Off, 1=Raw, 2=Smooth, 3=WetDry
+    static const juce::String PARAM_JITTER_BUFFER_ENABLED;
+    static const juce::String PARAM_JITTER_BUFFER_LATENCY; // playout delay in ms
+    static const juce::String PARAM_ADAPTIVE_SMOOTHING;
+    static const juce::String PARAM_ADAPTIVE_TAU_MIN;      // seconds
+    static const juce::String PARAM_ADAPTIVE_TAU_MAX;      // seconds
+    static const juce::String PARAM_HR_ZONE;               // output: 0..4
+    static const juce::String PARAM_ZONE_MODE;             // 0=Absolute, 1=% Max, 2=% Reserve
+    static const juce::String PARAM_ZONE_MAX_HR;
+    static const juce::String PARAM_ZONE_REST_HR;
+    static const juce::String PARAM_ZONE_BOUNDARY_PREFIX;  // zone_boundary_1..4
+    static const juce::String PARAM_ZONE_HYSTERESIS;       // BPM
+    static const juce::String PARAM_ZONE_MIDI_OUTPUT;      // 0=Off, 1=Program Change, 2=Note
+    static const juce::String PARAM_ZONE_MIDI_CHANNEL;
+    static const juce::String PARAM_ZONE_MIDI_BASE;        // program/note for zone 1
+    static const juce::String PARAM_RESPIRATION_RATE;      // output: breaths/min
+    static const juce::String PARAM_BREATH_PHASE;          // output: 0..1, 0 = heart-rate peak
 
     //==============================================================================
     // Timer callback for deferred initialization
@@ -195,18 +279,16 @@ private:
     // Bluetooth LE manager
     std::unique_ptr<BluetoothManager> bluetoothManager;
     std::unique_ptr<HeartSyncBLEClient> bridgeClient;
+    mutable DeviceRegistry nativeDevices;  // mirrors bluetoothManager's list when it is read
     
     //==============================================================================
     // Thread-safe data storage
     mutable juce::SpinLock biometricDataLock;
     BiometricData currentBiometricData;
     
-    mutable juce::SpinLock historyDataLock;
-    std::array<float, 200> rawHeartRateHistory;
-    std::array<float, 200> smoothedHeartRateHistory;
-    std::array<float, 200> wetDryHistory;
-    size_t historyWriteIndex{0};
-    size_t historyCount{0};
+    BiometricHistory biometricHistory;     // written by updateBiometricParameters() on the audio thread
+    double nextHistoryMs{0.0};             // audio thread; paces the history to HISTORY_INTERVAL_MS
+    static constexpr double HISTORY_INTERVAL_MS = 100.0;   // 10 Hz whatever the block size
 
     // Bridge state (macOS helper)
     std::atomic<bool> bridgeAvailable{false};
@@ -219,11 +301,40 @@ private:
     std::atomic<bool> bridgeDataValid{false};
     juce::String bridgePermissionState{"unknown"};
     juce::String bridgeCurrentDeviceId;
-    mutable juce::CriticalSection bridgeDevicesLock;
-    std::vector<DeviceInfo> bridgeDevices;
+    DeviceRegistry bridgeDevices;
+    BiometricJitterBuffer bridgeJitterBuffer;
+
+    // The audio thread is the jitter buffer's only producer. Socket samples
+    // reach it through this queue; once the shared-memory ring is attached
+    // (set on the message thread) it polls the ring instead.
+    struct SocketHeartRate
+    {
+        double timestampMs{0.0};
+        float bpm{0.0f};
+    };
+
+    static constexpr int SOCKET_FIFO_CAPACITY = 64;
+    juce::AbstractFifo socketHeartRateFifo{SOCKET_FIFO_CAPACITY};
+    std::array<SocketHeartRate, SOCKET_FIFO_CAPACITY> socketHeartRates{};
+
+    std::atomic<const BiometricSharedRing*> sharedBiometricRing{nullptr};
+    const BiometricSharedRing* audioThreadRing{nullptr};
+    BiometricSharedRing::Cursor audioThreadRingCursor;
+
     float bridgeSmoothedValue{0.0f};
     float bridgeWetDryValue{50.0f};
     bool bridgeSmootherInitialised{false};
+
+    // Heart-rate arrivals (bridge or native), used to drive per-measurement statistics
+    std::atomic<uint32_t> heartRateSampleCount{0};
+    std::atomic<double> lastHeartRateSampleMs{0.0};
+
+    // Adaptive smoothing (audio thread owned)
+    AdaptiveSmoother adaptiveSmoother;
+    uint32_t adaptiveSampleCount{0};
+    double lastAdaptiveAdvanceMs{0.0};
+    std::atomic<float> effectiveSmoothingAlpha{0.1f};
+    std::atomic<float> effectiveSmoothingTimeConstant{0.0f};
     
     //==============================================================================
     // Sample-accurate parameter smoothing
@@ -240,6 +351,24 @@ private:
     
     void updateTempoSync(const BiometricData& data);
     float mapValueToTempo(float value, TempoSyncSource source) const;
+
+    //==============================================================================
+    // Heart-rate zone state (audio thread owned)
+    HeartRateZoneTracker zoneTracker;
+    std::array<std::atomic<float>*, HeartRateZoneTracker::NUM_ZONES - 1> zoneBoundaryValues{};
+    std::atomic<int> currentHeartRateZone{-1};
+    int heldZoneNote{-1};
+    int heldZoneNoteChannel{1};
+    std::atomic<bool> zoneResetRequested{false};   // set off the audio thread, e.g. on disconnect
+
+    void updateHeartRateZone(juce::MidiBuffer& midiMessages, int numSamples);
+    void resetHeartRateZone(juce::MidiBuffer& midiMessages);
+
+    //==============================================================================
+    // Beat-level analysis (respiration) off the audio and message threads
+    AnalysisWorker analysisWorker;
+
+    void updateRespirationParameters();
     
     //==============================================================================
     // Performance monitoring
@@ -247,28 +376,39 @@ private:
     mutable std::atomic<double> peakProcessingTime{0.0};
     mutable std::atomic<size_t> processBlockCount{0};
     mutable std::chrono::steady_clock::time_point lastResetTime;
+
+    LatencyHistogram publishLatency;
+    LatencyHistogram consumeLatency;
+    uint32_t consumedSampleCount{0};   // audio thread only
     
     //==============================================================================
     // Professional error handling
     mutable juce::CriticalSection errorLogLock;
     std::vector<std::pair<std::chrono::steady_clock::time_point, juce::String>> errorLog;
     static const size_t MAX_ERROR_LOG_SIZE = 100;
+    mutable LogMessageQueue systemMessages;     // drained by the editor's terminal once per UI tick
     
     //==============================================================================
     // Internal processing methods
     void updateBiometricParameters();
+    void recordConsumeLatency();
+    float applyAdaptiveSmoothing(float adjustedHr, float latestMeasurement);
     void addToHistory(float rawHr, float smoothedHr, float wetDry);
     void logError(const juce::String& error) const;
-    void logSystemMessage(const juce::String& message) const;
+    void logSystemMessage(const juce::String& message,
+                          LogMessageQueue::Severity severity = LogMessageQueue::Severity::Info) const;
     
     //==============================================================================
     // Bluetooth event handlers
     void handleHeartRateData(float heartRate);
     void handleBluetoothStateChange();
     void handleDeviceDiscovery();
+    void syncNativeDevices() const;
     void handleSystemMessage(const std::string& message);
     void initialiseBridgeClient();
-    void updateBridgeBiometrics(float bpm);
+    void queueSocketHeartRate(float bpm, double timestampMs);
+    void updateBridgeBiometrics(float bpm, double timestampMs);
+    void pollBridgeHeartRate();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HeartSyncVST3AudioProcessor)
 };
\ No newline at end of file
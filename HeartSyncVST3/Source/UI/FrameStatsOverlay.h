@@ -0,0 +1,113 @@
+#pragma once
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "HSTheme.h"
+#include "../Core/UiProfiler.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Profiler readout drawn over the editor.
+ *
+ * Two lines of preformatted text from the editor (clock and queue
+ * counters), then one row per UiProfiler section: rate, p50 / p95 / max
+ * and a bar histogram of the rolling window, one bar per octave bin
+ * (leftmost bin below 62.5 µs). Purely a display, refreshed about once per
+ * second. Ignores the mouse so it never gets in the way of the controls
+ * underneath.
+ */
+class FrameStatsOverlay : public juce::Component
+{
+public:
+    FrameStatsOverlay()
+    {
+        setInterceptsMouseClicks(false, false);
+    }
+
+    void setText(const juce::String& newText)
+    {
+        if (newText == text)
+            return;
+
+        text = newText;
+        repaint();
+    }
+
+    void setSummaries(const std::array<UiProfiler::Summary, UiProfiler::NUM_SECTIONS>& newSummaries)
+    {
+        summaries = newSummaries;
+        repaint();
+    }
+
+    /** Height needed for TEXT_LINES of text and every section row. */
+    static int getIdealHeight()
+    {
+        return 8 + TEXT_LINE_HEIGHT * TEXT_LINES + ROW_HEIGHT * (UiProfiler::NUM_SECTIONS + 1);
+    }
+
+    static constexpr int TEXT_LINES = 2;
+
+    void paint(juce::Graphics& g) override
+    {
+        g.setColour(juce::Colours::black.withAlpha(0.75f));
+        g.fillRoundedRectangle(getLocalBounds().toFloat(), 4.0f);
+
+        auto area = getLocalBounds().reduced(6, 4);
+
+        g.setColour(HSTheme::TEXT_SECONDARY);
+        g.setFont(HSTheme::mono(10.0f, false));
+        g.drawFittedText(text, area.removeFromTop(TEXT_LINE_HEIGHT * TEXT_LINES), juce::Justification::topLeft, TEXT_LINES);
+
+        g.drawText("section      rate    p50    p95  max ms", area.removeFromTop(ROW_HEIGHT),
+                   juce::Justification::centredLeft, false);
+
+        for (int s = 0; s < UiProfiler::NUM_SECTIONS; ++s)
+        {
+            const auto& summary = summaries[(size_t)s];
+            auto row = area.removeFromTop(ROW_HEIGHT);
+            auto bars = row.removeFromRight(UiProfiler::NUM_BINS * BAR_WIDTH).reduced(0, 2);
+
+            g.setColour(HSTheme::TEXT_SECONDARY);
+            g.drawText(juce::String::formatted("%-9s %5.0f/s %6.2f %6.2f %7.2f",
+                                               UiProfiler::getName((UiProfiler::Section)s), summary.perSecond,
+                                               summary.p50Ms, summary.p95Ms, summary.maxMs),
+                       row, juce::Justification::centredLeft, false);
+
+            drawHistogram(g, summary, bars.toFloat());
+        }
+    }
+
+private:
+    static void drawHistogram(juce::Graphics& g, const UiProfiler::Summary& summary, juce::Rectangle<float> area)
+    {
+        g.setColour(HSTheme::ACCENT_TEAL.withAlpha(0.15f));
+        g.fillRect(area);
+
+        const auto peak = *std::max_element(summary.bins.begin(), summary.bins.end());
+        if (peak == 0)
+            return;
+
+        // Bins past 16 ms (a 60 Hz frame) are drawn as warnings
+        g.setColour(HSTheme::ACCENT_TEAL);
+        for (int b = 0; b < UiProfiler::NUM_BINS; ++b)
+        {
+            if (b == SLOW_BIN)
+                g.setColour(HSTheme::STATUS_ERROR);
+
+            const auto count = summary.bins[(size_t)b];
+            if (count == 0)
+                continue;
+
+            // Square-root scale keeps a handful of stalls visible next to thousands of fast passes
+            const float height = juce::jmax(1.0f, area.getHeight() * std::sqrt((float)count / (float)peak));
+            g.fillRect(area.getX() + (float)(b * BAR_WIDTH), area.getBottom() - height, (float)(BAR_WIDTH - 1), height);
+        }
+    }
+
+    static constexpr int TEXT_LINE_HEIGHT = 13;
+    static constexpr int ROW_HEIGHT = 13;
+    static constexpr int BAR_WIDTH = 5;
+    static constexpr int SLOW_BIN = 9;     // [16 ms, 32 ms)
+
+    juce::String text;
+    std::array<UiProfiler::Summary, UiProfiler::NUM_SECTIONS> summaries{};
+};
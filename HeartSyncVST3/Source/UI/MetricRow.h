@@ -6,12 +6,13 @@
 #include <memory>
 
 /**
- * @brief Single metric row: Value (200px) | Controls (200px) | Waveform (flex)
+ * @brief Single metric row: Value (200px) | Controls (200px) | Waveform (flex) [| Accessory]
  * 
  * Matches Python's stacked row layout exactly:
  * - Left: value tile with large centered number and bottom title
  * - Middle: controls column (buildControlsFn populates this)
  * - Right: waveform graph with ECG grid
+ * - Optional: a square accessory view after the waveform (setAccessory)
  */
 class MetricRow : public juce::Component
 {
@@ -87,11 +88,27 @@ public:
     }
     
     WaveGraph& getGraph() { return *graph; }
+
+    /** Shows an extra view (not owned) in a square column right of the waveform; nullptr removes it. */
+    void setAccessory(juce::Component* newAccessory)
+    {
+        if (accessory != nullptr)
+            removeChildComponent(accessory);
+
+        accessory = newAccessory;
+        if (accessory != nullptr)
+            addAndMakeVisible(accessory);
+
+        resized();
+    }
     
     void setTempoSyncActive(bool active) 
     { 
+        if (active == isSyncedToTempo)
+            return;
+
         isSyncedToTempo = active;
-        repaint();
+        repaint(valuePanel->getBounds().removeFromTop(20));
     }
     
     bool isTempoSyncActive() const { return isSyncedToTempo; }
@@ -189,6 +206,13 @@ public:
         controlsPanel->setBounds(controlsCol);
         controlsHost->setBounds(controlsCol.reduced(HSTheme::grid));
         
+        // Accessory column (far right), as wide as the row is tall
+        if (accessory != nullptr)
+        {
+            accessory->setBounds(r.removeFromRight(juce::jmax(minAccessoryWidth, r.getHeight())));
+            r.removeFromRight(HSTheme::grid); // gap
+        }
+
         // Waveform column (right - remaining width)
         waveformPanel->setBounds(r);
         graph->setBounds(r);
@@ -209,4 +233,7 @@ private:
     
     std::unique_ptr<RectPanel> waveformPanel;
     std::unique_ptr<WaveGraph> graph;
+
+    juce::Component* accessory = nullptr;
+    static constexpr int minAccessoryWidth = 120;
 };
@@ -0,0 +1,238 @@
+#pragma once
+#include "RectPanel.h"
+#include "../Core/PoincareStats.h"
+#include "../Core/RrHistory.h"
+#include <cmath>
+#include <vector>
+
+/**
+ * @brief Poincaré scatter of consecutive RR intervals (RRn against RRn+1)
+ * with the SD1 / SD2 ellipse of the last PoincareStats::WINDOW pairs.
+ *
+ * Points are blended into a persistent image as beats arrive, so a new
+ * beat costs one dot however many are on screen. Every DECAY_INTERVAL
+ * beats the image's alpha is scaled down, which fades old beats out over
+ * a few minutes. The image is only rebuilt (from the pairs PoincareStats
+ * holds) when the size or display scale changes. The ellipse, identity
+ * line and readout are cheap vector drawing on top.
+ *
+ * Axes are fixed at MIN_RR_MS .. MAX_RR_MS so nothing needs redrawing
+ * when the heart rate drifts.
+ */
+class PoincarePlot : public RectPanel
+{
+public:
+    PoincarePlot (juce::Colour border) : RectPanel (border), pointColour (border) {}
+
+    /** New intervals from an RrHistory read; gaps, missed entries and intervals off the axes are never paired across. */
+    void addIntervals (const RrHistory::Snapshot& snapshot)
+    {
+        if (snapshot.missed > 0)
+            hasPrevious = false;
+
+        bool added = false;
+
+        for (const auto& entry : snapshot.entries)
+        {
+            if (entry.rrMs < MIN_RR_MS || entry.rrMs > MAX_RR_MS)
+            {
+                hasPrevious = false;
+                continue;
+            }
+
+            if (hasPrevious && ! entry.followsGap)
+            {
+                const PoincareStats::Pair pair { previousRrMs, entry.rrMs };
+                stats.add (pair);
+                pendingPairs.push_back (pair);
+                added = true;
+            }
+
+            previousRrMs = entry.rrMs;
+            hasPrevious = true;
+        }
+
+        // Not painted for a while: cheaper to rebuild from the held pairs than to blend a backlog
+        if (pendingPairs.size() >= PoincareStats::WINDOW)
+        {
+            pendingPairs.clear();
+            points = {};
+        }
+
+        if (added)
+            repaint();
+    }
+
+    void clear()
+    {
+        stats.clear();
+        pendingPairs.clear();
+        hasPrevious = false;
+        points = {};
+        repaint();
+    }
+
+    void resized() override
+    {
+        auto r = getLocalBounds().reduced (HSTheme::grid).toFloat();
+        readoutArea = r.removeFromTop (14.0f);
+
+        // Square, so the identity line sits at 45 degrees
+        const float side = juce::jmax (0.0f, juce::jmin (r.getWidth(), r.getHeight()));
+        plotArea = r.withSizeKeepingCentre (side, side);
+
+        background = {};
+        points = {};
+    }
+
+    static constexpr float MIN_RR_MS = 300.0f;    // 200 bpm
+    static constexpr float MAX_RR_MS = 1500.0f;   // 40 bpm
+
+private:
+    void paint (juce::Graphics& g) override
+    {
+        const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        if (scale != renderScale)
+        {
+            renderScale = scale;
+            background = {};
+            points = {};
+        }
+
+        if (background.isNull())
+            renderBackground();
+
+        if (background.isValid())
+            g.drawImage (background, getLocalBounds().toFloat());
+        else
+            RectPanel::paint (g);
+
+        updatePoints();
+        if (points.isValid())
+            g.drawImage (points, plotArea);
+
+        const auto result = stats.getResult();
+        g.setColour (HSTheme::TEXT_SECONDARY);
+        g.setFont (HSTheme::mono (10.0f, false));
+        g.drawText (result.valid ? juce::String::formatted ("SD1 %.0f  SD2 %.0f ms", result.sd1Ms, result.sd2Ms)
+                                 : juce::String ("POINCARE"),
+                    readoutArea, juce::Justification::centredLeft);
+
+        if (! result.valid || plotArea.isEmpty())
+            return;
+
+        // Ellipse in ms space: SD2 along the identity line, SD1 across it
+        juce::Path ellipse;
+        ellipse.addEllipse ((float) -result.sd2Ms, (float) -result.sd1Ms, (float) (2.0 * result.sd2Ms), (float) (2.0 * result.sd1Ms));
+        ellipse.applyTransform (juce::AffineTransform::rotation (juce::MathConstants<float>::pi * 0.25f)
+                                    .translated ((float) result.meanRrMs, (float) result.meanNextRrMs)
+                                    .followedBy (msToPlot()));
+
+        g.saveState();
+        g.reduceClipRegion (plotArea.getSmallestIntegerContainer());
+        g.setColour (HSTheme::TEXT_PRIMARY.withAlpha (0.8f));
+        g.strokePath (ellipse, juce::PathStrokeType (1.5f));
+        g.restoreState();
+    }
+
+    /** Maps (RRn, RRn+1) in ms onto plotArea, RRn+1 growing upwards. */
+    juce::AffineTransform msToPlot() const
+    {
+        const float k = plotArea.getWidth() / (MAX_RR_MS - MIN_RR_MS);
+        return juce::AffineTransform (k, 0.0f, plotArea.getX() - MIN_RR_MS * k,
+                                      0.0f, -k, plotArea.getBottom() + MIN_RR_MS * k);
+    }
+
+    void renderBackground()
+    {
+        const int w = juce::roundToInt (getWidth() * renderScale);
+        const int h = juce::roundToInt (getHeight() * renderScale);
+        if (w <= 0 || h <= 0)
+            return;
+
+        background = juce::Image (juce::Image::RGB, w, h, false);
+        juce::Graphics g (background);
+        g.addTransform (juce::AffineTransform::scale (renderScale));
+
+        RectPanel::paint (g);
+        if (plotArea.isEmpty())
+            return;
+
+        g.setColour (juce::Colour (0xff003f3f));
+        g.drawRect (plotArea, 1.0f);
+
+        // Grid every 200 ms; the identity line marks RRn+1 == RRn
+        const auto toPlot = msToPlot();
+        g.setColour (juce::Colour (0xff001e1e));
+        for (float ms = 400.0f; ms < MAX_RR_MS; ms += 200.0f)
+        {
+            auto x = ms, y = ms;
+            toPlot.transformPoint (x, y);
+            g.drawVerticalLine (juce::roundToInt (x), plotArea.getY(), plotArea.getBottom());
+            g.drawHorizontalLine (juce::roundToInt (y), plotArea.getX(), plotArea.getRight());
+        }
+
+        g.setColour (juce::Colour (0xff003f3f));
+        g.drawLine (plotArea.getX(), plotArea.getBottom(), plotArea.getRight(), plotArea.getY(), 1.0f);
+    }
+
+    /** Blends pending pairs into the points image, rebuilding it first if it was dropped. */
+    void updatePoints()
+    {
+        const int side = juce::roundToInt (plotArea.getWidth() * renderScale);
+        if (side <= 0)
+        {
+            pendingPairs.clear();
+            return;
+        }
+
+        if (points.isNull())
+        {
+            points = juce::Image (juce::Image::ARGB, side, side, true);
+            pendingPairs.clear();
+            sinceDecay = 0;
+
+            for (size_t i = 0; i < stats.size(); ++i)
+                drawPair (stats.getPair (i));
+
+            return;
+        }
+
+        for (const auto& pair : pendingPairs)
+            drawPair (pair);
+
+        pendingPairs.clear();
+    }
+
+    void drawPair (const PoincareStats::Pair& pair)
+    {
+        if (++sinceDecay >= DECAY_INTERVAL)
+        {
+            points.multiplyAllAlphas (DECAY_FACTOR);
+            sinceDecay = 0;
+        }
+
+        const float k = (float) points.getWidth() / (MAX_RR_MS - MIN_RR_MS);
+        const float x = (juce::jlimit (MIN_RR_MS, MAX_RR_MS, pair.rrMs) - MIN_RR_MS) * k;
+        const float y = (float) points.getHeight() - (juce::jlimit (MIN_RR_MS, MAX_RR_MS, pair.nextRrMs) - MIN_RR_MS) * k;
+        const float radius = 1.5f * renderScale;
+
+        juce::Graphics g (points);
+        g.setColour (pointColour.withAlpha (0.6f));
+        g.fillEllipse (x - radius, y - radius, radius * 2.0f, radius * 2.0f);
+    }
+
+    static constexpr int DECAY_INTERVAL = 32;      // beats
+    static constexpr float DECAY_FACTOR = 0.85f;   // a beat fades below 10% after about 450 more
+
+    juce::Colour pointColour;
+    PoincareStats stats;
+    std::vector<PoincareStats::Pair> pendingPairs;
+    float previousRrMs = 0.0f;
+    bool hasPrevious = false;
+    int sinceDecay = 0;
+
+    juce::Rectangle<float> readoutArea, plotArea;
+    juce::Image background, points;
+    float renderScale = 1.0f;
+};
@@ -0,0 +1,250 @@
+#pragma once
+#include "RectPanel.h"
+#include "../Core/RrHistory.h"
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cmath>
+
+/**
+ * @brief Histogram of RR intervals in BIN_MS bins from MIN_RR_MS to MAX_RR_MS
+ * (intervals outside that range are not counted).
+ *
+ * Counts decay by DECAY_FACTOR every DECAY_INTERVAL beats, so the shape
+ * follows the last few minutes rather than the whole session. Bars live in
+ * a cached image: a new beat redraws only its own bar. The whole image is
+ * redrawn when the counts decay or the tallest bar outgrows the scale,
+ * which happens every few dozen beats at most.
+ */
+class RrHistogram : public RectPanel
+{
+public:
+    RrHistogram (juce::Colour border) : RectPanel (border), barColour (border) {}
+
+    void addIntervals (const RrHistory::Snapshot& snapshot)
+    {
+        if (snapshot.entries.empty())
+            return;
+
+        for (const auto& entry : snapshot.entries)
+        {
+            if (entry.rrMs < MIN_RR_MS || entry.rrMs >= MAX_RR_MS)
+                continue;
+
+            const int bin = binFor (entry.rrMs);
+            counts[(size_t) bin] += 1.0f;
+            dirtyBins.set ((size_t) bin);
+            latestRrMs = entry.rrMs;
+
+            if (counts[(size_t) bin] > scaleCount)
+            {
+                scaleCount = counts[(size_t) bin] * 1.5f;
+                barsValid = false;
+            }
+
+            if (++sinceDecay >= DECAY_INTERVAL)
+            {
+                for (auto& count : counts)
+                    count *= DECAY_FACTOR;
+
+                // Let the scale follow a shrinking peak, with the same headroom it grows with
+                const float peak = *std::max_element (counts.begin(), counts.end());
+                scaleCount = juce::jmax (MIN_SCALE, juce::jmin (scaleCount, peak * 1.5f));
+                sinceDecay = 0;
+                barsValid = false;
+            }
+        }
+
+        updateSummary();
+        repaint();
+    }
+
+    void clear()
+    {
+        counts = {};
+        scaleCount = MIN_SCALE;
+        sinceDecay = 0;
+        latestRrMs = 0.0f;
+        barsValid = false;
+        updateSummary();
+        repaint();
+    }
+
+    void resized() override
+    {
+        auto r = getLocalBounds().reduced (HSTheme::grid).toFloat();
+        readoutArea = r.removeFromTop (14.0f);
+        axisArea = r.removeFromBottom (12.0f);
+        plotArea = r;
+
+        background = {};
+        bars = {};
+    }
+
+    static constexpr float MIN_RR_MS = 300.0f;
+    static constexpr float MAX_RR_MS = 1500.0f;
+    static constexpr float BIN_MS = 10.0f;
+    static constexpr int NUM_BINS = (int) ((MAX_RR_MS - MIN_RR_MS) / BIN_MS);
+
+private:
+    void paint (juce::Graphics& g) override
+    {
+        const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        if (scale != renderScale)
+        {
+            renderScale = scale;
+            background = {};
+            bars = {};
+        }
+
+        if (background.isNull())
+            renderBackground();
+
+        if (background.isValid())
+            g.drawImage (background, getLocalBounds().toFloat());
+        else
+            RectPanel::paint (g);
+
+        updateBars();
+        if (bars.isValid())
+            g.drawImage (bars, plotArea);
+
+        g.setColour (HSTheme::TEXT_SECONDARY);
+        g.setFont (HSTheme::mono (10.0f, false));
+        g.drawText (summaryText, readoutArea, juce::Justification::centredLeft);
+
+        if (latestRrMs > 0.0f && ! plotArea.isEmpty())
+        {
+            const float x = plotArea.getX() + plotArea.getWidth() * (float) (binFor (latestRrMs) + 0.5f) / (float) NUM_BINS;
+            g.setColour (HSTheme::TEXT_PRIMARY.withAlpha (0.7f));
+            g.drawVerticalLine (juce::roundToInt (x), plotArea.getY(), plotArea.getBottom());
+        }
+    }
+
+    static int binFor (float rrMs)
+    {
+        return juce::jlimit (0, NUM_BINS - 1, (int) std::floor ((rrMs - MIN_RR_MS) / BIN_MS));
+    }
+
+    void updateSummary()
+    {
+        double total = 0.0, sum = 0.0, sumSq = 0.0;
+        for (int b = 0; b < NUM_BINS; ++b)
+        {
+            const double centre = MIN_RR_MS + (b + 0.5) * BIN_MS;
+            total += counts[(size_t) b];
+            sum += counts[(size_t) b] * centre;
+            sumSq += counts[(size_t) b] * centre * centre;
+        }
+
+        if (total < 2.0)
+        {
+            summaryText = "RR HISTOGRAM";
+            return;
+        }
+
+        const double mean = sum / total;
+        const double sd = std::sqrt (juce::jmax (0.0, sumSq / total - mean * mean));
+        summaryText = juce::String::formatted ("MEAN %.0f  SD %.0f ms", mean, sd);
+    }
+
+    void renderBackground()
+    {
+        const int w = juce::roundToInt (getWidth() * renderScale);
+        const int h = juce::roundToInt (getHeight() * renderScale);
+        if (w <= 0 || h <= 0)
+            return;
+
+        background = juce::Image (juce::Image::RGB, w, h, false);
+        juce::Graphics g (background);
+        g.addTransform (juce::AffineTransform::scale (renderScale));
+
+        RectPanel::paint (g);
+        if (plotArea.isEmpty())
+            return;
+
+        g.setColour (juce::Colour (0xff003f3f));
+        g.drawRect (plotArea, 1.0f);
+
+        g.setColour (juce::Colour (0xff001e1e));
+        for (float ms = 500.0f; ms < MAX_RR_MS; ms += 250.0f)
+        {
+            const float x = plotArea.getX() + plotArea.getWidth() * (ms - MIN_RR_MS) / (MAX_RR_MS - MIN_RR_MS);
+            g.drawVerticalLine (juce::roundToInt (x), plotArea.getY(), plotArea.getBottom());
+        }
+
+        g.setColour (HSTheme::TEXT_SECONDARY);
+        g.setFont (HSTheme::mono (9.0f, false));
+        g.drawText (juce::String ((int) MIN_RR_MS), axisArea, juce::Justification::centredLeft);
+        g.drawText ("RR ms", axisArea, juce::Justification::centred);
+        g.drawText (juce::String ((int) MAX_RR_MS), axisArea, juce::Justification::centredRight);
+    }
+
+    void updateBars()
+    {
+        const int w = juce::roundToInt (plotArea.getWidth() * renderScale);
+        const int h = juce::roundToInt (plotArea.getHeight() * renderScale);
+        if (w <= 0 || h <= 0)
+        {
+            bars = {};
+            return;
+        }
+
+        if (bars.isNull())
+        {
+            bars = juce::Image (juce::Image::ARGB, w, h, true);
+            barsValid = false;
+        }
+
+        if (! barsValid)
+        {
+            bars.clear (bars.getBounds());
+            for (int b = 0; b < NUM_BINS; ++b)
+                drawBar (b);
+
+            barsValid = true;
+        }
+        else
+        {
+            for (int b = 0; b < NUM_BINS; ++b)
+                if (dirtyBins[(size_t) b])
+                    drawBar (b);
+        }
+
+        dirtyBins.reset();
+    }
+
+    void drawBar (int bin)
+    {
+        const int x0 = bin * bars.getWidth() / NUM_BINS;
+        const int x1 = (bin + 1) * bars.getWidth() / NUM_BINS;
+        const juce::Rectangle<int> column (x0, 0, juce::jmax (1, x1 - x0), bars.getHeight());
+        bars.clear (column);
+
+        const float fraction = juce::jmin (1.0f, counts[(size_t) bin] / scaleCount);
+        const int height = juce::roundToInt (fraction * (float) bars.getHeight());
+        if (height <= 0)
+            return;
+
+        juce::Graphics g (bars);
+        g.setColour (barColour.withAlpha (0.85f));
+        g.fillRect (column.withTop (bars.getHeight() - height).withTrimmedRight (column.getWidth() > 2 ? 1 : 0));
+    }
+
+    static constexpr int DECAY_INTERVAL = 32;       // beats
+    static constexpr float DECAY_FACTOR = 0.9f;
+    static constexpr float MIN_SCALE = 4.0f;
+
+    juce::Colour barColour;
+    std::array<float, (size_t) NUM_BINS> counts{};
+    std::bitset<(size_t) NUM_BINS> dirtyBins;
+    float scaleCount = MIN_SCALE;
+    float latestRrMs = 0.0f;
+    int sinceDecay = 0;
+    bool barsValid = false;
+    juce::String summaryText { "RR HISTOGRAM" };
+
+    juce::Rectangle<float> readoutArea, axisArea, plotArea;
+    juce::Image background, bars;
+    float renderScale = 1.0f;
+};
@@ -0,0 +1,159 @@
+#pragma once
+#include "RectPanel.h"
+#include "../Core/RrSpectrogram.h"
+
+/**
+ * @brief Scrolling spectrogram of the RR tachogram, 0–0.5 Hz, newest on the right.
+ *
+ * Columns arrive already colour-mapped from the analysis worker
+ * (RrSpectrogram). Each one is written into a ring image one pixel wide
+ * and NUM_ROWS tall at the write position, so new data never moves old
+ * pixels; paint() only composites the ring's two halves, scaled up to the
+ * plot. The LF / HF band edges (0.04 and 0.15 Hz) are marked on the
+ * cached background: slow breathing and coherence show up as a bright
+ * band low in the HF range or below it.
+ */
+class SpectrogramView : public RectPanel
+{
+public:
+    SpectrogramView (juce::Colour border) : RectPanel (border)
+    {
+        ring.clear (ring.getBounds(), juce::Colours::black);
+    }
+
+    void addColumns (const RrSpectrogram::Snapshot& snapshot)
+    {
+        if (snapshot.entries.empty())
+            return;
+
+        // More than the ring holds: only the newest VISIBLE_COLUMNS can be seen
+        const size_t skip = snapshot.entries.size() > (size_t) VISIBLE_COLUMNS
+                              ? snapshot.entries.size() - (size_t) VISIBLE_COLUMNS : 0;
+
+        {
+            juce::Image::BitmapData pixels (ring, juce::Image::BitmapData::writeOnly);
+            for (size_t c = skip; c < snapshot.entries.size(); ++c)
+            {
+                const auto& column = snapshot.entries[c];
+                for (int row = 0; row < RrSpectrogram::NUM_ROWS; ++row)
+                    pixels.setPixelColour (writeColumn, RrSpectrogram::NUM_ROWS - 1 - row,
+                                           juce::Colour (column.pixels[(size_t) row]));
+
+                writeColumn = (writeColumn + 1) % VISIBLE_COLUMNS;
+            }
+        }
+
+        columnsShown = juce::jmin (VISIBLE_COLUMNS, columnsShown + (int) (snapshot.entries.size() - skip));
+        repaint (plotArea.getSmallestIntegerContainer());
+    }
+
+    void resized() override
+    {
+        auto r = getLocalBounds().reduced (HSTheme::grid).toFloat();
+        readoutArea = r.removeFromTop (14.0f);
+        r.removeFromLeft (24.0f);   // frequency labels
+        plotArea = r;
+
+        background = {};
+    }
+
+    static constexpr int VISIBLE_COLUMNS = 150;   // 5 minutes at one column per 2 s
+
+private:
+    void paint (juce::Graphics& g) override
+    {
+        const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        if (scale != renderScale)
+        {
+            renderScale = scale;
+            background = {};
+        }
+
+        if (background.isNull())
+            renderBackground();
+
+        if (background.isValid())
+            g.drawImage (background, getLocalBounds().toFloat());
+        else
+            RectPanel::paint (g);
+
+        if (plotArea.isEmpty() || columnsShown == 0)
+            return;
+
+        // Oldest part of the ring [writeColumn, end) goes left of the newest [0, writeColumn)
+        const float columnWidth = plotArea.getWidth() / (float) VISIBLE_COLUMNS;
+        const int older = VISIBLE_COLUMNS - writeColumn;
+        const auto rows = RrSpectrogram::NUM_ROWS;
+
+        auto target = plotArea;
+        const auto olderArea = target.removeFromLeft (older * columnWidth);
+
+        g.setImageResamplingQuality (juce::Graphics::lowResamplingQuality);
+        g.drawImage (ring.getClippedImage ({ writeColumn, 0, older, rows }), olderArea, juce::RectanglePlacement::stretchToFit);
+
+        if (writeColumn > 0)
+            g.drawImage (ring.getClippedImage ({ 0, 0, writeColumn, rows }), target, juce::RectanglePlacement::stretchToFit);
+
+        drawBandEdges (g);
+    }
+
+    float yFor (double frequencyHz) const
+    {
+        const double top = RrSpectrogram::rowFrequency (RrSpectrogram::NUM_ROWS - 1);
+        return plotArea.getBottom() - plotArea.getHeight() * (float) (frequencyHz / top);
+    }
+
+    void drawBandEdges (juce::Graphics& g) const
+    {
+        g.setColour (HSTheme::TEXT_SECONDARY.withAlpha (0.5f));
+        for (const double edge : { LF_EDGE_HZ, HF_EDGE_HZ })
+            g.drawHorizontalLine (juce::roundToInt (yFor (edge)), plotArea.getX(), plotArea.getRight());
+    }
+
+    void renderBackground()
+    {
+        const int w = juce::roundToInt (getWidth() * renderScale);
+        const int h = juce::roundToInt (getHeight() * renderScale);
+        if (w <= 0 || h <= 0)
+            return;
+
+        background = juce::Image (juce::Image::RGB, w, h, false);
+        juce::Graphics g (background);
+        g.addTransform (juce::AffineTransform::scale (renderScale));
+
+        RectPanel::paint (g);
+
+        g.setColour (HSTheme::TEXT_SECONDARY);
+        g.setFont (HSTheme::mono (10.0f, false));
+        g.drawText ("RR SPECTRUM", readoutArea, juce::Justification::centredLeft);
+
+        if (plotArea.isEmpty())
+            return;
+
+        g.setColour (juce::Colour (0xff003f3f));
+        g.drawRect (plotArea.expanded (1.0f), 1.0f);
+
+        g.setColour (HSTheme::TEXT_SECONDARY);
+        g.setFont (HSTheme::mono (9.0f, false));
+        const auto label = [&] (double frequencyHz, const juce::String& text)
+        {
+            g.drawText (text, juce::Rectangle<float> (plotArea.getX() - 26.0f, yFor (frequencyHz) - 6.0f, 24.0f, 12.0f),
+                        juce::Justification::centredRight);
+        };
+
+        label (0.5, ".5");
+        label (HF_EDGE_HZ, "HF");
+        label (LF_EDGE_HZ, "LF");
+    }
+
+    static constexpr double LF_EDGE_HZ = 0.04;
+    static constexpr double HF_EDGE_HZ = 0.15;
+
+    juce::Image ring { juce::Image::RGB, VISIBLE_COLUMNS, RrSpectrogram::NUM_ROWS, true };
+    int writeColumn = 0;
+    int columnsShown = 0;
+
+    juce::Rectangle<float> readoutArea, plotArea;
+    juce::Image background;
+    float renderScale = 1.0f;
+};
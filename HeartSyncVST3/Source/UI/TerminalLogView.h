@@ -0,0 +1,317 @@
+#pragma once
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "HSTheme.h"
+#include "../Core/LogMessageQueue.h"
+#include "../Core/UiProfiler.h"
+#include <cmath>
+#include <deque>
+#include <optional>
+#include <vector>
+
+/**
+ * @brief Device terminal: a fixed-capacity ring of log lines drawn virtually.
+ *
+ * Appending stores the line in a ring (the oldest line is overwritten once
+ * CAPACITY is reached) and, if it passes the severity filter, records its
+ * sequence number in the list of shown lines. Nothing is laid out up
+ * front: paint() works out which shown lines intersect the clip region and
+ * draws only those, so a burst of lines costs the same to display as one.
+ * Batches should be appended with one call so the view repaints once.
+ *
+ * Follows the newest line while scrolled to the bottom; scrolled up, the
+ * view stays on the same lines as new ones arrive. Click selects a line;
+ * the right-click menu copies, filters by severity and clears.
+ */
+class TerminalLogView : public juce::Component,
+                        private juce::ScrollBar::Listener
+{
+public:
+    using Severity = LogMessageQueue::Severity;
+
+    TerminalLogView()
+    {
+        lines.resize(CAPACITY);
+        scrollBar.setAutoHide(false);
+        scrollBar.addListener(this);
+        scrollBar.setColour(juce::ScrollBar::thumbColourId, HSTheme::ACCENT_TEAL.withAlpha(0.5f));
+        addAndMakeVisible(scrollBar);
+        setOpaque(true);
+    }
+
+    ~TerminalLogView() override
+    {
+        scrollBar.removeListener(this);
+    }
+
+    /** Shown while no line passes the filter. */
+    void setPlaceholder(const juce::String& text)
+    {
+        placeholder = text;
+        if (shown.empty())
+            repaint();
+    }
+
+    void append(Severity severity, const juce::String& text)
+    {
+        store(severity, text, juce::Time::currentTimeMillis());
+        linesChanged();
+    }
+
+    void append(const std::vector<LogMessageQueue::Message>& batch)
+    {
+        if (batch.empty())
+            return;
+
+        for (const auto& message : batch)
+            store(message.severity, juce::String::fromUTF8(message.text.c_str()), (juce::int64)message.timeMs);
+
+        linesChanged();
+    }
+
+    void clear()
+    {
+        firstSeq = nextSeq;
+        shown.clear();
+        selectedSeq.reset();
+        topLine = 0.0;
+        followTail = true;
+        updateScrollBar();
+        repaint();
+    }
+
+    void setMinimumSeverity(Severity severity)
+    {
+        if (severity == minimumSeverity)
+            return;
+
+        minimumSeverity = severity;
+        shown.clear();
+        for (uint64_t seq = firstSeq; seq < nextSeq; ++seq)
+            if (lineAt(seq).severity >= minimumSeverity)
+                shown.push_back(seq);
+
+        followTail = true;
+        updateScrollBar();
+        repaint();
+    }
+
+    Severity getMinimumSeverity() const { return minimumSeverity; }
+
+    /** Every shown line, oldest first, one per row. */
+    juce::String getShownText() const
+    {
+        juce::StringArray rows;
+        rows.ensureStorageAllocated((int)shown.size());
+        for (const auto seq : shown)
+            rows.add(lineAt(seq).text);
+        return rows.joinIntoString("\n");
+    }
+
+    static constexpr int CAPACITY = 500;
+    static constexpr float LINE_HEIGHT = 14.0f;
+    static constexpr double WHEEL_ROWS = 12.0;     // rows per unit of wheel delta
+
+    //==============================================================================
+    void paint(juce::Graphics& g) override
+    {
+        const UiProfiler::Scope profile(UiProfiler::Section::TerminalPaint);
+
+        g.fillAll(juce::Colour(0xff001818));
+
+        const auto textArea = getTextArea();
+        g.setFont(HSTheme::mono(10.0f, true));
+
+        if (shown.empty())
+        {
+            g.setColour(HSTheme::TEXT_SECONDARY);
+            g.drawText(placeholder, textArea.withHeight((int)LINE_HEIGHT), juce::Justification::centredLeft, true);
+            return;
+        }
+
+        // Only the rows that intersect the clip region
+        const auto clip = g.getClipBounds().getIntersection(textArea);
+        const double offset = topLine * LINE_HEIGHT;
+        const auto first = (size_t)juce::jmax(0.0, std::floor((clip.getY() - textArea.getY() + offset) / LINE_HEIGHT));
+        const auto last = (size_t)juce::jmax(0.0, std::ceil((clip.getBottom() - textArea.getY() + offset) / LINE_HEIGHT));
+
+        for (size_t row = first; row < juce::jmin(last, shown.size()); ++row)
+        {
+            const auto seq = shown[row];
+            const auto& line = lineAt(seq);
+            const juce::Rectangle<float> bounds((float)textArea.getX(),
+                                                (float)(textArea.getY() + row * LINE_HEIGHT - offset),
+                                                (float)textArea.getWidth(), LINE_HEIGHT);
+
+            if (selectedSeq == seq)
+            {
+                g.setColour(HSTheme::ACCENT_TEAL.withAlpha(0.35f));
+                g.fillRect(bounds);
+            }
+
+            g.setColour(colourFor(line.severity));
+            g.drawText(line.text, bounds, juce::Justification::centredLeft, true);
+        }
+    }
+
+    void resized() override
+    {
+        scrollBar.setBounds(getLocalBounds().removeFromRight(10));
+        updateScrollBar();
+    }
+
+    void mouseDown(const juce::MouseEvent& event) override
+    {
+        if (event.mods.isPopupMenu())
+        {
+            showMenu(event);
+            return;
+        }
+
+        const auto row = rowAt(event.position.y);
+        const std::optional<uint64_t> hit = row < shown.size() ? std::optional<uint64_t>(shown[row]) : std::nullopt;
+        if (hit != selectedSeq)
+        {
+            selectedSeq = hit;
+            repaint();
+        }
+    }
+
+    void mouseWheelMove(const juce::MouseEvent&, const juce::MouseWheelDetails& wheel) override
+    {
+        const double maxTop = juce::jmax(0.0, (double)shown.size() - visibleRows());
+        topLine = juce::jlimit(0.0, maxTop, topLine - wheel.deltaY * WHEEL_ROWS);
+        followTail = topLine >= maxTop - 0.5;
+        updateScrollBar();
+        repaint();
+    }
+
+private:
+    struct Line
+    {
+        Severity severity{Severity::Info};
+        juce::String text;      // "[HH:MM:SS] message", formatted once on append
+    };
+
+    const Line& lineAt(uint64_t seq) const { return lines[(size_t)(seq % CAPACITY)]; }
+
+    void store(Severity severity, const juce::String& text, juce::int64 timeMs)
+    {
+        auto& line = lines[(size_t)(nextSeq % CAPACITY)];
+        line.severity = severity;
+        line.text = "[" + juce::Time(timeMs).formatted("%H:%M:%S") + "] " + text;
+
+        if (severity >= minimumSeverity)
+            shown.push_back(nextSeq);
+
+        ++nextSeq;
+    }
+
+    void linesChanged()
+    {
+        // Retire whatever the ring has overwritten
+        if (nextSeq - firstSeq > (uint64_t)CAPACITY)
+            firstSeq = nextSeq - (uint64_t)CAPACITY;
+
+        size_t retired = 0;
+        while (! shown.empty() && shown.front() < firstSeq)
+        {
+            shown.pop_front();
+            ++retired;
+        }
+
+        if (selectedSeq.has_value() && *selectedSeq < firstSeq)
+            selectedSeq.reset();
+
+        // Scrolled up: keep the same lines in view
+        if (! followTail)
+            topLine = juce::jmax(0.0, topLine - (double)retired);
+
+        updateScrollBar();
+        repaint();
+    }
+
+    juce::Rectangle<int> getTextArea() const
+    {
+        return getLocalBounds().withTrimmedRight(scrollBar.getWidth()).reduced(4, 2);
+    }
+
+    double visibleRows() const { return getTextArea().getHeight() / (double)LINE_HEIGHT; }
+
+    size_t rowAt(float y) const
+    {
+        const double row = (y - getTextArea().getY()) / LINE_HEIGHT + topLine;
+        return row < 0.0 ? shown.size() : (size_t)row;
+    }
+
+    void updateScrollBar()
+    {
+        const double total = (double)shown.size();
+        const double visible = visibleRows();
+        const double maxTop = juce::jmax(0.0, total - visible);
+
+        topLine = followTail ? maxTop : juce::jlimit(0.0, maxTop, topLine);
+
+        scrollBar.setRangeLimits(0.0, juce::jmax(total, visible), juce::dontSendNotification);
+        scrollBar.setCurrentRange(topLine, visible, juce::dontSendNotification);
+        scrollBar.setSingleStepSize(1.0);
+    }
+
+    void scrollBarMoved(juce::ScrollBar*, double newRangeStart) override
+    {
+        topLine = newRangeStart;
+        followTail = topLine + visibleRows() >= (double)shown.size() - 0.5;
+        repaint();
+    }
+
+    juce::Colour colourFor(Severity severity) const
+    {
+        switch (severity)
+        {
+            case Severity::Debug:   return HSTheme::TEXT_SECONDARY.withAlpha(0.55f);
+            case Severity::Warning: return HSTheme::STATUS_SCANNING;
+            case Severity::Error:   return HSTheme::STATUS_ERROR;
+            case Severity::Info:
+            default:                return HSTheme::TEXT_SECONDARY;
+        }
+    }
+
+    void showMenu(const juce::MouseEvent& event)
+    {
+        juce::PopupMenu filter;
+        const auto addFilter = [this, &filter](const juce::String& name, Severity severity)
+        {
+            filter.addItem(name, true, minimumSeverity == severity, [this, severity] { setMinimumSeverity(severity); });
+        };
+        addFilter("Everything", Severity::Debug);
+        addFilter("Info and above", Severity::Info);
+        addFilter("Warnings and errors", Severity::Warning);
+        addFilter("Errors only", Severity::Error);
+
+        juce::PopupMenu menu;
+        menu.addItem("Copy Selected", selectedSeq.has_value(), false, [this]
+        {
+            if (selectedSeq.has_value())
+                juce::SystemClipboard::copyTextToClipboard(lineAt(*selectedSeq).text);
+        });
+        menu.addItem("Copy All", [this] { juce::SystemClipboard::copyTextToClipboard(getShownText()); });
+        menu.addSeparator();
+        menu.addSubMenu("Show", filter);
+        menu.addItem("Clear", [this] { clear(); });
+
+        menu.showMenuAsync(juce::PopupMenu::Options{}
+                               .withTargetComponent(this)
+                               .withTargetScreenArea({ event.getScreenPosition(), { 1, 1 } }));
+    }
+
+    std::vector<Line> lines;                // ring, indexed by seq % CAPACITY
+    uint64_t firstSeq = 0;                  // oldest line still held (or cleared up to)
+    uint64_t nextSeq = 0;
+    std::deque<uint64_t> shown;             // seqs passing the filter, oldest first
+    std::optional<uint64_t> selectedSeq;
+    Severity minimumSeverity = Severity::Info;
+
+    juce::ScrollBar scrollBar{ true };
+    double topLine = 0.0;                   // first visible row, in rows of shown
+    bool followTail = true;
+    juce::String placeholder;
+};
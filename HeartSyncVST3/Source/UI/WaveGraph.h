@@ -1,24 +1,67 @@
 #pragma once
 #include "RectPanel.h"
-#include <algorithm>
-#include <deque>
+#include "../Core/MinMaxPyramid.h"
+#include "../Core/UiProfiler.h"
+#include <cmath>
 #include <optional>
 #include <vector>
 
-class WaveGraph : public RectPanel, private juce::Timer
+/**
+ * @brief Scrolling trace of the session history with an ECG-style grid.
+ *
+ * Every pushed value is kept in a MinMaxPyramid, so the view can zoom from
+ * a few seconds to the whole session (mouse wheel; double-click returns to
+ * the default window). LAST / PEAK / MIN describe the visible window.
+ * Painting composites two cached images: the panel, axis label and grid
+ * (rebuilt on resize or scale change) and the trace itself.
+ *
+ * While the window has fewer samples than the trace has device pixels the
+ * trace is a polyline with the newest sample anchored at the right edge;
+ * new samples scroll the trace image left by whole device pixels and only
+ * the new segments are stroked. The fractional remainder of each scroll is
+ * carried into the next segment's x position, so the picture matches a
+ * full redraw.
+ *
+ * Zoomed out further, the trace is decimated from the pyramid to one
+ * min/max column per device pixel (or, in Lttb mode, one point per column
+ * picked by largest-triangle-three-buckets from those extrema). Columns
+ * are aligned to absolute sample positions so they do not shimmer, and a
+ * redraw costs O(width) however long the session is.
+ *
+ * No timer: the graph repaints when data arrives. Samples pushed while the
+ * graph is not painted are folded into the next paint.
+ */
+class WaveGraph : public RectPanel
 {
 public:
-    WaveGraph (juce::Colour border) : RectPanel (border), lineColour(border) { startTimerHz (40); }
-    
+    enum class RenderMode
+    {
+        MinMax,     // envelope of every sample; nothing is lost
+        Lttb        // one representative point per column; smoother when zoomed far out
+    };
+
+    WaveGraph (juce::Colour border) : RectPanel (border), lineColour(border) {}
+
     void push (float v)
     {
-        if (buffer.size() >= maxPts) buffer.pop_front();
-        buffer.push_back (v);
-        recomputeStats();
+        history.append (v);
+        ++pendingPoints;
+        repaint (plotArea.getSmallestIntegerContainer());
+    }
+
+    void setLineColour(juce::Colour c)
+    {
+        lineColour = c;
+        traceValid = false;
+        repaint();
+    }
+
+    void setYAxisLabel(const juce::String& label)
+    {
+        axisLabel = label;
+        background = {};
+        repaint();
     }
-    
-    void setLineColour(juce::Colour c) { lineColour = c; }
-    void setYAxisLabel(const juce::String& label) { axisLabel = label; repaint(); }
 
     void setFixedRange(float minValue, float maxValue)
     {
@@ -34,36 +77,171 @@ public:
 
     void setSamples(const std::vector<float>& values)
     {
-        if (values.empty())
-        {
-            buffer.clear();
-            recomputeStats();
-            repaint();
+        history.clear();
+        for (const float v : values)
+            history.append (v);
+
+        traceValid = false;
+        repaint();
+    }
+
+    void setRenderMode(RenderMode mode)
+    {
+        renderMode = mode;
+        traceValid = false;
+        repaint();
+    }
+
+    /** Seconds between pushes; used for the window length shown with the stats. */
+    void setSampleInterval(double seconds) { sampleIntervalSeconds = juce::jmax (0.001, seconds); }
+
+    /** Width of the view in samples, at least MIN_VISIBLE; larger than the history shows it all. */
+    void setVisibleSamples(int numSamples)
+    {
+        numSamples = juce::jmax (MIN_VISIBLE, numSamples);
+        if (numSamples == visibleSamples)
+            return;
+
+        visibleSamples = numSamples;
+        traceValid = false;
+        repaint();
+    }
+
+    int getVisibleSamples() const { return visibleSamples; }
+
+    void resized() override
+    {
+        auto r = getLocalBounds().reduced (HSTheme::grid).toFloat();
+
+        // Left margin for Y-axis label
+        constexpr float leftMargin = 40.0f;
+        frameArea = r.reduced(HSTheme::grid * 1.0f);
+        frameArea.removeFromLeft(leftMargin);
+
+        plotArea = frameArea;
+        traceArea = plotArea;
+        statsArea = traceArea.removeFromTop(16).reduced(4, 0);
+
+        background = {};
+        traceValid = false;
+    }
+
+    void mouseWheelMove (const juce::MouseEvent&, const juce::MouseWheelDetails& wheel) override
+    {
+        if (wheel.deltaY == 0.0f)
             return;
+
+        // Wheel up zooms in; zooming out stops once the whole session is in view
+        const double factor = std::pow (1.25, -wheel.deltaY * 4.0);
+        const int upperLimit = juce::jmax (DEFAULT_VISIBLE, (int) history.size());
+        setVisibleSamples (juce::jmin (upperLimit, juce::roundToInt (visibleSamples * factor)));
+    }
+
+    void mouseDoubleClick (const juce::MouseEvent&) override
+    {
+        setVisibleSamples (DEFAULT_VISIBLE);
+    }
+
+    static constexpr int DEFAULT_VISIBLE = 300;
+    static constexpr int MIN_VISIBLE = 100;
+
+private:
+    void paint (juce::Graphics& g) override
+    {
+        const UiProfiler::Scope profile (UiProfiler::Section::WaveGraphPaint);
+
+        const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        if (scale != renderScale)
+        {
+            renderScale = scale;
+            background = {};
+            traceValid = false;
         }
 
-        if (values.size() > maxPts)
-            buffer.assign(values.end() - maxPts, values.end());
+        if (background.isNull())
+            renderBackground();
+
+        if (background.isValid())
+            g.drawImage (background, getLocalBounds().toFloat());
         else
-            buffer.assign(values.begin(), values.end());
+            RectPanel::paint (g);
 
-        recomputeStats();
-        repaint();
+        // Draw LAST / PEAK / MIN in top-right
+        const auto window = visibleRange();
+        g.setColour(HSTheme::TEXT_SECONDARY);
+        g.setFont(HSTheme::mono(10.0f, false));
+        juce::String stats = juce::String::formatted("LAST %.0f  PEAK %.0f  MIN %.0f  %s",
+                                                     lastValue(), window.valid ? window.max : 0.0f,
+                                                     window.valid ? window.min : 0.0f,
+                                                     formatWindowLength().toRawUTF8());
+        g.drawText(stats, statsArea, juce::Justification::centredRight);
+
+        if (history.size() < 2)
+        {
+            pendingPoints = 0;
+            return;
+        }
+
+        updateTrace (window);
+        if (trace.isValid())
+            g.drawImage (trace, traceArea);
     }
 
-private:
-    void timerCallback() override { repaint(); }
+    //==============================================================================
+    float lastValue() const { return history.isEmpty() ? 0.0f : history.back(); }
 
-    void paint (juce::Graphics& g) override
+    int windowSamples() const { return juce::jmin (visibleSamples, (int) history.size()); }
+
+    MinMaxPyramid::Range visibleRange() const
+    {
+        return history.getRange (history.size() - (size_t) windowSamples(), history.size());
+    }
+
+    juce::String formatWindowLength() const
+    {
+        const int seconds = juce::roundToInt (visibleSamples * sampleIntervalSeconds);
+        if (seconds < 120)
+            return juce::String (seconds) + "s";
+        if (seconds < 7200)
+            return juce::String (seconds / 60) + "m";
+        return juce::String (seconds / 3600) + "h" + juce::String ((seconds / 60) % 60).paddedLeft ('0', 2);
+    }
+
+    juce::Range<float> currentRange (const MinMaxPyramid::Range& window) const
+    {
+        if (fixedRange.has_value())
+            return *fixedRange;
+
+        // Scale with 12% headroom
+        float lo = window.min;
+        float hi = window.max;
+        float range = hi - lo;
+        if (range < 1.0f)
+        {
+            range = 10.0f;
+            lo = lastValue() - 5.0f;
+            hi = lastValue() + 5.0f;
+        }
+
+        const float headroom = range * 0.12f;
+        return { lo - headroom, hi + headroom };
+    }
+
+    //==============================================================================
+    void renderBackground()
     {
+        const int w = juce::roundToInt (getWidth() * renderScale);
+        const int h = juce::roundToInt (getHeight() * renderScale);
+        if (w <= 0 || h <= 0)
+            return;
+
+        background = juce::Image (juce::Image::RGB, w, h, false);
+        juce::Graphics g (background);
+        g.addTransform (juce::AffineTransform::scale (renderScale));
+
         RectPanel::paint (g);
         auto r = getLocalBounds().reduced (HSTheme::grid).toFloat();
 
-        // Left margin for Y-axis label
-        constexpr float leftMargin = 40.0f;
-        auto plot = r.reduced(HSTheme::grid * 1.0f);
-        plot.removeFromLeft(leftMargin);
-        
         if (axisLabel.isNotEmpty())
         {
             g.saveState();
@@ -75,8 +253,9 @@ private:
                        juce::Justification::centred);
             g.restoreState();
         }
-        
+
         // Inner frame (ECG monitor style)
+        const auto& plot = frameArea;
         g.setColour (juce::Colour (0xff003f3f)); // Major grid color
         g.drawRect (plot, 1.0f);
 
@@ -88,7 +267,7 @@ private:
             auto y = plot.getY() + plot.getHeight() * i / 5.0f;
             g.drawLine (plot.getX(), y, plot.getRight(), y, 1.0f);
         }
-        
+
         // Minor grid lines (very dark)
         g.setColour (juce::Colour (0xff001e1e));
         for (int i = 1; i < 25; ++i)
@@ -97,75 +276,212 @@ private:
             auto y = plot.getY() + plot.getHeight() * i / 25.0f;
             g.drawLine (plot.getX(), y, plot.getRight(), y, 0.5f);
         }
-        
-        // Draw LAST / PEAK / MIN in top-right
-        g.setColour(HSTheme::TEXT_SECONDARY);
-        g.setFont(HSTheme::mono(10.0f, false));
-        juce::String stats = juce::String::formatted("LAST %.0f  PEAK %.0f  MIN %.0f", 
-                                                     lastValue, peakValue, minValue);
-        g.drawText(stats, plot.removeFromTop(16).reduced(4, 0), juce::Justification::centredRight);
+    }
 
-        if (buffer.size() < 2) return;
+    void updateTrace (const MinMaxPyramid::Range& window)
+    {
+        const int w = juce::roundToInt (traceArea.getWidth() * renderScale);
+        const int h = juce::roundToInt (traceArea.getHeight() * renderScale);
+        if (w <= 0 || h <= 0)
+        {
+            trace = {};
+            return;
+        }
 
-        // Scale with 12% headroom
-        float lo = minValue;
-        float hi = peakValue;
+        const auto range = currentRange (window);
+        const bool sizeChanged = trace.isNull() || trace.getWidth() != w || trace.getHeight() != h;
+        if (sizeChanged)
+        {
+            trace = juce::Image (juce::Image::ARGB, w, h, true);
+            traceValid = false;
+        }
 
-        if (fixedRange.has_value())
+        const bool decimated = visibleSamples > numColumns();
+        const int numSegments = windowSamples() - 1;
+
+        if (decimated)
+        {
+            // O(width) from the pyramid, so a full redraw per change is cheap enough
+            if (! traceValid || pendingPoints > 0 || range != traceRange)
+            {
+                trace.clear (trace.getBounds());
+                traceRange = range;
+                traceValid = true;
+                drawColumns();
+            }
+        }
+        else if (! traceValid || range != traceRange || pendingPoints >= numSegments)
         {
-            lo = fixedRange->getStart();
-            hi = fixedRange->getEnd();
+            trace.clear (trace.getBounds());
+            traceRange = range;
+            traceValid = true;
+            drawSegments (numSegments);
         }
-        else
+        else if (pendingPoints > 0)
         {
-            float range = hi - lo;
-            if (range < 1.0f)
+            // Same arithmetic as a full redraw: positions are exact, the image moves in whole pixels
+            int shift = 0;
+            for (int i = 0; i < pendingPoints; ++i)
             {
-                range = 10.0f;
-                lo = lastValue - 5.0f;
-                hi = lastValue + 5.0f;
+                scrollFraction += stepPx();
+                const int whole = (int) scrollFraction;
+                shift += whole;
+                scrollFraction -= whole;
             }
 
-            const float headroom = range * 0.12f;
-            lo -= headroom;
-            hi += headroom;
+            if (shift >= w)
+            {
+                trace.clear (trace.getBounds());
+                drawSegments (numSegments);
+            }
+            else
+            {
+                if (shift > 0)
+                {
+                    trace.moveImageSection (0, 0, shift, 0, w - shift, h);
+                    trace.clear ({ w - shift, 0, shift, h });
+                }
+
+                drawSegments (pendingPoints);
+            }
         }
-        
-        // Draw waveform path (2px line width)
-        juce::Path p; 
-        int i = 0;
-        for (auto v : buffer)
+
+        pendingPoints = 0;
+    }
+
+    float lineWidthPx() const { return 2.0f * renderScale; }
+
+    /** Device-pixel columns available to the trace (one min/max pair each when decimated). */
+    int numColumns() const { return juce::jmax (1, trace.getWidth() - 2 * (int) std::ceil (lineWidthPx()) - 1); }
+
+    float yFor (float value) const
+    {
+        return juce::jmap (value, traceRange.getStart(), traceRange.getEnd(), (float) trace.getHeight(), 0.0f);
+    }
+
+    /** Strokes the newest numSegments segments into the trace image. */
+    void drawSegments (int numSegments)
+    {
+        const uint64_t newest = history.size() - 1;
+        const double right = trace.getWidth() - lineWidthPx() - 1.0;
+
+        juce::Path p;
+        for (int i = numSegments; i >= 0; --i)
         {
-            float x = plot.getX() + plot.getWidth() * (float) i / (float) (buffer.size() - 1);
-            float y = juce::jmap (v, lo, hi, plot.getBottom(), plot.getY());
-            if (i++ == 0) p.startNewSubPath (x, y); 
+            const float x = (float) (right - i * stepPx() + scrollFraction);
+            const float y = yFor (history.valueAt ((size_t) (newest - (uint64_t) i)));
+            if (i == numSegments) p.startNewSubPath (x, y);
             else p.lineTo (x, y);
         }
-        
-        g.setColour (lineColour); 
-        g.strokePath (p, juce::PathStrokeType (2.0f));
-    }
 
-    static constexpr int maxPts = 300;
-    std::deque<float> buffer;
-    juce::Colour lineColour;
-    float lastValue = 0.0f;
-    float peakValue = 0.0f;
-    float minValue = 0.0f;
-    juce::String axisLabel{"BPM"};
-    std::optional<juce::Range<float>> fixedRange;
+        juce::Graphics g (trace);
+        g.setColour (lineColour);
+        g.strokePath (p, juce::PathStrokeType (lineWidthPx(), juce::PathStrokeType::curved, juce::PathStrokeType::rounded));
+    }
 
-    void recomputeStats()
+    /** Redraws the whole trace from the pyramid, one column per device pixel. */
+    void drawColumns()
     {
-        if (buffer.empty())
+        const int columns = numColumns();
+        const size_t samplesPerColumn = (size_t) ((visibleSamples + columns - 1) / columns);
+        const size_t lastColumn = (history.size() - 1) / samplesPerColumn;
+        const size_t firstColumn = lastColumn + 1 > (size_t) columns ? lastColumn + 1 - (size_t) columns : 0;
+        const size_t used = lastColumn - firstColumn + 1;
+
+        history.getColumns (firstColumn, used, samplesPerColumn, columnRanges);
+
+        const float lineWidth = lineWidthPx();
+        const float right = (float) trace.getWidth() - lineWidth - 1.0f;
+        const auto xFor = [&] (size_t c) { return right - (float) (used - 1 - c); };
+
+        juce::Graphics g (trace);
+        g.setColour (lineColour);
+
+        if (renderMode == RenderMode::MinMax)
         {
-            lastValue = peakValue = minValue = 0.0f;
+            // One vertical bar per column, stretched to meet its neighbour so the trace stays connected
+            juce::RectangleList<float> bars;
+            bars.ensureStorageAllocated ((int) used);
+
+            for (size_t c = 0; c < used; ++c)
+            {
+                const auto& column = columnRanges[c];
+                if (! column.valid)
+                    continue;
+
+                float lo = column.min, hi = column.max;
+                if (c > 0 && columnRanges[c - 1].valid)
+                {
+                    lo = juce::jmin (lo, columnRanges[c - 1].max);
+                    hi = juce::jmax (hi, columnRanges[c - 1].min);
+                }
+
+                const float top = yFor (hi), bottom = yFor (lo);
+                bars.addWithoutMerging ({ xFor (c) - lineWidth * 0.5f, top - lineWidth * 0.5f,
+                                          lineWidth, bottom - top + lineWidth });
+            }
+
+            g.fillRectList (bars);
             return;
         }
 
-        auto [mn, mx] = std::minmax_element(buffer.begin(), buffer.end());
-        minValue = *mn;
-        peakValue = *mx;
-        lastValue = buffer.back();
+        // LTTB over the column extrema: each column contributes its min or its
+        // max, whichever spans the larger triangle with the previous pick and
+        // the next column's centre
+        juce::Path p;
+        float prevX = xFor (0), prevY = yFor (0.5f * (columnRanges[0].min + columnRanges[0].max));
+        p.startNewSubPath (prevX, prevY);
+
+        for (size_t c = 1; c < used; ++c)
+        {
+            const auto& column = columnRanges[c];
+            if (! column.valid)
+                continue;
+
+            const float x = xFor (c);
+            if (c + 1 == used)
+            {
+                p.lineTo (x, yFor (history.back()));
+                break;
+            }
+
+            const auto& next = columnRanges[c + 1];
+            const float nextX = xFor (c + 1);
+            const float nextY = yFor (next.valid ? 0.5f * (next.min + next.max) : 0.5f * (column.min + column.max));
+
+            const auto area = [&] (float y) { return std::abs ((prevX - nextX) * (y - prevY) - (prevX - x) * (nextY - prevY)); };
+            const float yMin = yFor (column.min), yMax = yFor (column.max);
+            const float y = area (yMin) >= area (yMax) ? yMin : yMax;
+
+            p.lineTo (x, y);
+            prevX = x;
+            prevY = y;
+        }
+
+        g.strokePath (p, juce::PathStrokeType (lineWidth, juce::PathStrokeType::curved, juce::PathStrokeType::rounded));
     }
+
+    double stepPx() const
+    {
+        return juce::jmax (0.0, (trace.getWidth() - 2.0 * lineWidthPx() - 1.0) / (visibleSamples - 1));
+    }
+
+    MinMaxPyramid history;
+    std::vector<MinMaxPyramid::Range> columnRanges;   // scratch for drawColumns()
+    int visibleSamples = DEFAULT_VISIBLE;
+    double sampleIntervalSeconds = 0.1;
+    RenderMode renderMode = RenderMode::MinMax;
+
+    juce::Colour lineColour;
+    juce::String axisLabel{"BPM"};
+    std::optional<juce::Range<float>> fixedRange;
+
+    juce::Rectangle<float> frameArea, plotArea, statsArea, traceArea;
+    float renderScale = 1.0f;
+    juce::Image background;                     // panel, axis label and grid at device resolution
+    juce::Image trace;                          // transparent, traceArea at device resolution
+    juce::Range<float> traceRange;
+    bool traceValid = false;
+    int pendingPoints = 0;                      // pushed since the trace image was last brought up to date
+    double scrollFraction = 0.0;                // sub-pixel part of the scroll, in device pixels
 };
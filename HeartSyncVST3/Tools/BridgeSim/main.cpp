@@ -0,0 +1,991 @@
+/*
+    heartsync-bridge-sim
+
+    Stands in for the HeartSync Bridge helper on machines without Bluetooth.
+    Serves any number of plugin instances through BridgeServer and streams
+    simulated heart-rate straps to them.
+
+        heartsync-bridge-sim [--socket <path>] [--synthetic | --session <file>]
+                             [--devices <n>] [--speed <x>] [--jitter <ms>]
+                             [--drop <p>] [--outage-every <s> --outage-for <s>]
+                             [--duration <s>] [--max-queue <bytes>] [--seed <n>] [--no-shm] [--quiet]
+
+    Each client gets the handshake reply ("ready" at the negotiated version),
+    "permission", device_found advertisements while it scans, "connected" /
+    "disconnected" for the device it picks, one heart-rate message per
+    simulated second with that second's RR intervals, and a heartbeat every
+    wall-clock second. Protocol v2 clients that ask for binary frames get
+    HeartRate and Heartbeat frames; everyone else gets hr_data and
+    bridge_heartbeat JSON. Commands carrying a request_id are acknowledged.
+
+    Clients whose handshake advertises "shared_memory" (the
+    BiometricSharedRing layout version) are sent a shm_offer naming the
+    device's ring when they connect to it. Every simulated device owns one
+    ring, written with each heart-rate message (bpm and RR intervals). Once
+    a client answers {"type":"shm","on":true}, its heart-rate and RR
+    messages stop coming over the socket; "on":false puts them back.
+    --no-shm makes no offers, so everything goes over the socket.
+
+    Devices are shared like real straps: a device streams while at least one
+    client is connected to it, and every message is serialised once and
+    fanned out to all subscribers. A plugin instance is subscribed to the
+    device it connected to; other tools can pick their own filter with
+        {"type":"subscribe","types":["hr","rr","ecg","status","devices","heartbeat","control"],
+         "devices":["SIM-0001"]}
+    (omitting either list means "all"). A client whose send queue passes
+    --max-queue bytes (default 1 MiB) is evicted as a slow consumer.
+
+    Sources:
+        --synthetic       (default) RSA-modulated heart rate with slow drift,
+                          a different resting rate per device
+        --session <file>  recorded session, one message per line:
+                          "<seconds> <bpm> [rr_ms ...]" (comma, semicolon or
+                          whitespace separated; header lines are skipped).
+                          The recording loops and every device replays it.
+
+    Timing and faults (simulated seconds run --speed times faster than wall
+    time, 1x to 1000x; heartbeats stay on wall time so the plugin's
+    watchdog is unaffected):
+        --jitter <ms>       uniform random delivery delay per message (order kept;
+                            timestamps stay nominal, so it reads as transport delay)
+        --drop <p>          probability of losing a heart-rate message
+        --outage-every <s>  mean simulated seconds between link losses
+        --outage-for <s>    simulated length of each loss ("disconnected"
+                            then "connected" again)
+
+    A one-line summary per second goes to stderr (clients, messages,
+    deliveries, ring records, serialisations, bytes, drops, evictions) for
+    benchmarking and soak runs.
+*/
+
+#include "BiometricSharedRing.h"
+#include "BridgeProtocol.h"
+#include "BridgeServer.h"
+
+#include <unistd.h>
+#include <signal.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr double HEARTBEAT_INTERVAL = 1.0;         // wall seconds
+    constexpr double ADVERTISE_INTERVAL = 1.0;         // wall seconds, while scanning
+    constexpr double TWO_PI = 6.283185307179586;
+
+    volatile sig_atomic_t stopRequested = 0;
+
+    double now()
+    {
+        const auto sinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
+        return std::chrono::duration<double>(sinceEpoch).count();
+    }
+
+    struct Options
+    {
+        std::string socketPath;
+        std::string sessionPath;
+        int numDevices = 1;
+        double speed = 1.0;
+        double jitterMs = 0.0;
+        double dropProbability = 0.0;
+        double outageEvery = 0.0;
+        double outageFor = 5.0;
+        double duration = 0.0;
+        size_t maxQueuedBytes = 1u << 20;
+        unsigned seed = 1;
+        bool sharedMemory = true;
+        bool quiet = false;
+    };
+
+    void printUsage()
+    {
+        std::fprintf(stderr,
+                     "usage: heartsync-bridge-sim [--socket <path>] [--synthetic | --session <file>]\n"
+                     "                            [--devices <n>] [--speed <1-1000>] [--jitter <ms>]\n"
+                     "                            [--drop <p>] [--outage-every <s> --outage-for <s>]\n"
+                     "                            [--duration <s>] [--max-queue <bytes>] [--seed <n>] [--no-shm] [--quiet]\n");
+    }
+
+    /** The first path the plugin tries on this platform (see HeartSyncBLEClient::connectToSocket). */
+    std::string defaultSocketPath()
+    {
+        if (const char* path = std::getenv("HEARTSYNC_BRIDGE_SOCKET"))
+            return path;
+
+#ifdef __APPLE__
+        const char* home = std::getenv("HOME");
+        return std::string(home != nullptr ? home : "") + "/Library/Application Support/HeartSync/bridge.sock";
+#else
+        if (const char* runtimeDir = std::getenv("XDG_RUNTIME_DIR"))
+            return std::string(runtimeDir) + "/heartsync/bridge.sock";
+
+        return "/tmp/heartsync-" + std::to_string(::getuid()) + "/bridge.sock";
+#endif
+    }
+
+    //==============================================================================
+    /** One heart-rate message: the strap's bpm and the beats since the previous one. */
+    struct Sample
+    {
+        double time = 0.0;             // simulated seconds
+        float bpm = 0.0f;
+        std::vector<float> rrMs;
+    };
+
+    class Source
+    {
+    public:
+        virtual ~Source() = default;
+        virtual void next(Sample& sample) = 0;
+    };
+
+    /** Resting rate plus respiratory sinus arrhythmia (15 breaths/min), slow drift and beat noise. */
+    class SyntheticSource : public Source
+    {
+    public:
+        SyntheticSource(int deviceIndex, unsigned seed)
+            : restingBpm(62.0 + 7.0 * (deviceIndex % 5)),
+              driftPhase(0.9 * deviceIndex),
+              random(seed * 7919u + (unsigned)deviceIndex)
+        {
+        }
+
+        void next(Sample& sample) override
+        {
+            messageTime += 1.0;
+            sample.time = messageTime;
+            sample.rrMs.clear();
+
+            std::normal_distribution<double> noise(0.0, 12.0);
+
+            while (nextBeat <= messageTime)
+            {
+                const double bpm = restingBpm
+                                 + 4.0 * std::sin(TWO_PI * 0.25 * nextBeat)
+                                 + 6.0 * std::sin(TWO_PI * nextBeat / 300.0 + driftPhase);
+                const double rr = std::clamp(60000.0 / bpm + noise(random), 300.0, 2000.0);
+
+                sample.rrMs.push_back((float)rr);
+                lastRr = rr;
+                nextBeat += rr / 1000.0;
+            }
+
+            // Straps report a smoothed rate; the latest interval is close enough
+            sample.bpm = (float)std::round(60000.0 / lastRr);
+        }
+
+    private:
+        double restingBpm;
+        double driftPhase;
+        std::mt19937 random;
+        double messageTime = 0.0;
+        double nextBeat = 0.5;
+        double lastRr = 1000.0;
+    };
+
+    class RecordedSource : public Source
+    {
+    public:
+        explicit RecordedSource(const std::vector<Sample>& samplesToUse)
+            : samples(samplesToUse)
+        {
+            // Loop with the recording's typical spacing after its last message
+            loopLength = samples.back().time - samples.front().time
+                       + (samples.size() > 1 ? (samples.back().time - samples.front().time) / (double)(samples.size() - 1) : 1.0);
+            if (loopLength <= 0.0)
+                loopLength = 1.0;
+        }
+
+        void next(Sample& sample) override
+        {
+            sample = samples[position];
+            sample.time = sample.time - samples.front().time + loopOffset;
+
+            if (++position == samples.size())
+            {
+                position = 0;
+                loopOffset += loopLength;
+            }
+        }
+
+    private:
+        const std::vector<Sample>& samples;
+        size_t position = 0;
+        double loopOffset = 0.0;
+        double loopLength = 1.0;
+    };
+
+    bool loadSession(const std::string& path, std::vector<Sample>& samples)
+    {
+        std::ifstream input(path);
+        if (! input)
+        {
+            std::fprintf(stderr, "cannot open %s\n", path.c_str());
+            return false;
+        }
+
+        std::string line;
+        while (std::getline(input, line))
+        {
+            for (auto& c : line)
+                if (c == ',' || c == ';' || c == '\t')
+                    c = ' ';
+
+            std::istringstream fields(line);
+            Sample sample;
+            double bpm = 0.0;
+
+            // Header lines do not parse as numbers and are skipped
+            if (! (fields >> sample.time >> bpm))
+                continue;
+
+            sample.bpm = (float)bpm;
+            double rr = 0.0;
+            while (fields >> rr && (int)sample.rrMs.size() < BridgeProtocol::MAX_RR_PER_FRAME)
+                sample.rrMs.push_back((float)rr);
+
+            if (! samples.empty() && sample.time < samples.back().time)
+            {
+                std::fprintf(stderr, "%s: timestamps go backwards at t=%g\n", path.c_str(), sample.time);
+                return false;
+            }
+
+            samples.push_back(std::move(sample));
+        }
+
+        if (samples.empty())
+        {
+            std::fprintf(stderr, "%s: no samples\n", path.c_str());
+            return false;
+        }
+
+        return true;
+    }
+
+    //==============================================================================
+    /** Pulls the few fields the bridge needs out of a flat JSON command. */
+    std::string jsonString(const std::string& json, const char* key)
+    {
+        const std::string quotedKey = std::string("\"") + key + "\"";
+        size_t position = json.find(quotedKey);
+        if (position == std::string::npos)
+            return {};
+
+        position = json.find(':', position + quotedKey.size());
+        if (position == std::string::npos)
+            return {};
+
+        position = json.find_first_not_of(" \t\r\n", position + 1);
+        if (position == std::string::npos)
+            return {};
+
+        if (json[position] != '"')
+        {
+            const size_t end = json.find_first_of(",}] \t\r\n", position);
+            return json.substr(position, end == std::string::npos ? std::string::npos : end - position);
+        }
+
+        std::string value;
+        for (size_t i = position + 1; i < json.size() && json[i] != '"'; ++i)
+        {
+            if (json[i] == '\\' && i + 1 < json.size())
+                ++i;
+            value += json[i];
+        }
+        return value;
+    }
+
+    std::string escapeJson(const std::string& text)
+    {
+        std::string escaped;
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    /** String elements of a flat JSON array, e.g. "devices":["SIM-0001"]. */
+    std::vector<std::string> jsonStringArray(const std::string& json, const char* key)
+    {
+        std::vector<std::string> values;
+        const std::string quotedKey = std::string("\"") + key + "\"";
+        size_t position = json.find(quotedKey);
+        if (position == std::string::npos)
+            return values;
+
+        position = json.find('[', position + quotedKey.size());
+        const size_t end = json.find(']', position);
+        if (position == std::string::npos || end == std::string::npos)
+            return values;
+
+        for (size_t open = json.find('"', position); open < end; open = json.find('"', open + 1))
+        {
+            const size_t close = json.find('"', open + 1);
+            if (close == std::string::npos || close > end)
+                break;
+
+            values.push_back(json.substr(open + 1, close - open - 1));
+            open = close;
+        }
+
+        return values;
+    }
+
+    std::string deviceId(int index)
+    {
+        char id[16];
+        std::snprintf(id, sizeof(id), "SIM-%04d", index + 1);
+        return id;
+    }
+
+    uint32_t parseMessageTypes(const std::vector<std::string>& names)
+    {
+        uint32_t types = 0;
+        for (const auto& name : names)
+        {
+            if (name == "hr")               types |= BridgeServer::HeartRate;
+            else if (name == "rr")          types |= BridgeServer::RrIntervals;
+            else if (name == "ecg")         types |= BridgeServer::Ecg;
+            else if (name == "status")      types |= BridgeServer::DeviceStatus;
+            else if (name == "devices")     types |= BridgeServer::Advertisements;
+            else if (name == "heartbeat")   types |= BridgeServer::Heartbeat;
+            else if (name == "control")     types |= BridgeServer::Control;
+        }
+        return types;
+    }
+
+    constexpr uint32_t STREAM_TYPES = BridgeServer::HeartRate | BridgeServer::RrIntervals
+                                    | BridgeServer::Ecg | BridgeServer::DeviceStatus;
+
+    /** What a client reads from the device's ring instead of the socket once it has accepted the offer. */
+    constexpr uint32_t RING_TYPES = BridgeServer::HeartRate | BridgeServer::RrIntervals;
+
+    //==============================================================================
+    /** A simulated strap. It streams while at least one client is connected to it. */
+    struct Device
+    {
+        int index = 0;
+        std::string id;
+        std::vector<BridgeServer::ClientId> owners;   // clients that sent "connect"
+
+        std::unique_ptr<Source> source;
+        Sample pending;
+        double pendingDue = 0.0;
+        double wallOrigin = 0.0;       // wall time of simulated t=0
+        bool linkDown = false;
+        double nextOutageStart = 0.0;  // simulated seconds
+        double outageEnd = 0.0;
+        uint32_t heartRateSequence = 0;
+        std::unique_ptr<BiometricSharedRing> ring;   // nullptr with --no-shm or if it could not be created
+
+        bool isStreaming() const { return source != nullptr; }
+    };
+
+    /** What the simulator knows about each plugin instance; the server keeps the sockets. */
+    struct ClientState
+    {
+        int version = 1;
+        bool explicitSubscription = false;   // sent "subscribe"; connect/scan leave its filter alone
+        bool sharedMemory = false;           // handshake offered our ring layout
+        bool usingRing = false;              // accepted the offer for its current device
+        int device = -1;
+    };
+
+    struct SimStats
+    {
+        uint64_t heartRateMessages = 0;
+        uint64_t deliveries = 0;       // heart-rate messages times recipients
+        uint64_t dropped = 0;          // --drop
+        uint64_t outages = 0;
+        uint64_t commands = 0;
+        uint64_t ringRecords = 0;      // written to the devices' shared-memory rings
+    };
+
+    class Simulator
+    {
+    public:
+        explicit Simulator(const Options& optionsToUse)
+            : options(optionsToUse),
+              random(optionsToUse.seed)
+        {
+            for (int i = 0; i < options.numDevices; ++i)
+            {
+                devices.emplace_back();
+                devices.back().index = i;
+                devices.back().id = deviceId(i);
+            }
+
+            server.onClientConnected = [this](BridgeServer::ClientId client) { clientConnected(client); };
+            server.onClientDisconnected = [this](BridgeServer::ClientId client, const std::string& reason) { clientDisconnected(client, reason); };
+            server.onMessage = [this](BridgeServer::ClientId client, const uint8_t* payload, size_t size)
+            {
+                handleCommand(client, std::string(reinterpret_cast<const char*>(payload), size));
+            };
+        }
+
+        bool loadSource()
+        {
+            return options.sessionPath.empty() || loadSession(options.sessionPath, session);
+        }
+
+        int run()
+        {
+            BridgeServer::Options serverOptions;
+            serverOptions.socketPath = options.socketPath;
+            serverOptions.maxQueuedBytes = options.maxQueuedBytes;
+
+            std::string error;
+            if (! server.start(serverOptions, error))
+            {
+                std::fprintf(stderr, "%s\n", error.c_str());
+                return 1;
+            }
+
+            if (options.sharedMemory)
+                createRings();
+
+            std::fprintf(stderr, "listening on %s: %d %s device(s) at %gx%s\n", options.socketPath.c_str(),
+                         options.numDevices, session.empty() ? "synthetic" : "recorded", options.speed,
+                         devices.front().ring != nullptr ? ", shared memory" : "");
+
+            const double start = now();
+            double nextReport = start + 1.0;
+            double nextHeartbeat = start;
+            double nextAdvertise = start;
+
+            while (! stopRequested && (options.duration <= 0.0 || now() - start < options.duration))
+            {
+                double deadline = std::min({ nextReport, nextHeartbeat, nextAdvertise });
+                for (const auto& device : devices)
+                    if (device.isStreaming())
+                        deadline = std::min(deadline, device.pendingDue);
+
+                const double timeout = std::clamp(deadline - now(), 0.0, 0.25);
+                server.poll((int)std::ceil(timeout * 1000.0));
+
+                const double wallNow = now();
+
+                if (wallNow >= nextHeartbeat)
+                {
+                    publishHeartbeat();
+                    nextHeartbeat = wallNow + HEARTBEAT_INTERVAL;
+                }
+
+                if (wallNow >= nextAdvertise)
+                {
+                    publishAdvertisements();
+                    nextAdvertise = wallNow + ADVERTISE_INTERVAL;
+                }
+
+                for (auto& device : devices)
+                    serviceDevice(device, wallNow);
+
+                if (wallNow >= nextReport)
+                {
+                    report(wallNow - start);
+                    nextReport += 1.0;
+                }
+            }
+
+            server.stop();
+            report(now() - start);
+            return 0;
+        }
+
+    private:
+        /** One ring per device, named after this process so several simulators can run side by side. */
+        void createRings()
+        {
+            for (auto& device : devices)
+            {
+                const std::string name = "/heartsync-sim-" + std::to_string(::getpid()) + "-" + std::to_string(device.index + 1);
+                std::string error;
+                device.ring = BiometricSharedRing::create(name, BiometricSharedRing::DEFAULT_CAPACITY, error);
+
+                if (device.ring == nullptr)
+                {
+                    std::fprintf(stderr, "shared memory unavailable (%s), using the socket only\n", error.c_str());
+                    for (auto& created : devices)
+                        created.ring.reset();
+                    return;
+                }
+            }
+        }
+
+        //==============================================================================
+        void clientConnected(BridgeServer::ClientId client)
+        {
+            clientStates[client] = ClientState();
+
+            // Until the plugin scans or connects it only needs liveness and control messages
+            BridgeServer::Subscription subscription;
+            subscription.types = BridgeServer::Heartbeat | BridgeServer::Control;
+            server.setSubscription(client, subscription);
+
+            log(client, "connected");
+        }
+
+        void clientDisconnected(BridgeServer::ClientId client, const std::string& reason)
+        {
+            for (auto& device : devices)
+                release(device, client);
+
+            clientStates.erase(client);
+            log(client, reason);
+        }
+
+        void handleCommand(BridgeServer::ClientId client, const std::string& json)
+        {
+            ++stats.commands;
+
+            auto& state = clientStates[client];
+            const std::string type = jsonString(json, "type");
+            const std::string requestId = jsonString(json, "request_id");
+            bool ok = true;
+            std::string error;
+
+            if (type == "handshake")
+            {
+                state.version = std::min(BridgeProtocol::PROTOCOL_VERSION, std::max(1, std::atoi(jsonString(json, "version").c_str())));
+                const bool binary = state.version >= BridgeProtocol::FIRST_BINARY_VERSION
+                                    && json.find("\"binary_frames\"") != std::string::npos;
+                server.setFormat(client, binary ? BridgeServer::Format::Binary : BridgeServer::Format::Json);
+                state.sharedMemory = jsonString(json, "shared_memory") == std::to_string(BiometricSharedRing::LAYOUT_VERSION);
+
+                reply(client, "{\"type\":\"ready\",\"version\":" + std::to_string(state.version) + "}");
+                reply(client, "{\"type\":\"permission\",\"state\":\"authorized\"}");
+                log(client, "handshake v" + std::to_string(state.version) + (binary ? " (binary frames)" : " (JSON)"));
+            }
+            else if (type == "status")
+            {
+                reply(client, "{\"type\":\"permission\",\"state\":\"authorized\"}");
+                if (state.device >= 0 && ! devices[(size_t)state.device].linkDown)
+                    reply(client, "{\"type\":\"connected\",\"id\":\"" + deviceId(state.device) + "\"}");
+            }
+            else if (type == "subscribe")
+            {
+                // {"type":"subscribe","types":["hr","rr",...],"devices":["SIM-0001",...]}
+                BridgeServer::Subscription subscription;
+                const auto typeNames = jsonStringArray(json, "types");
+                subscription.types = typeNames.empty() ? (uint32_t)BridgeServer::AllTypes : parseMessageTypes(typeNames);
+                subscription.devices = jsonStringArray(json, "devices");
+                server.setSubscription(client, std::move(subscription));
+                state.explicitSubscription = true;
+            }
+            else if (type == "scan")
+            {
+                if (! state.explicitSubscription)
+                    updateSubscription(client, BridgeServer::Advertisements, jsonString(json, "on") != "false");
+            }
+            else if (type == "connect")
+            {
+                const std::string id = jsonString(json, "id");
+                const auto device = std::find_if(devices.begin(), devices.end(), [&id](const Device& d) { return d.id == id; });
+
+                if (device == devices.end())
+                {
+                    ok = false;
+                    error = "unknown device " + id;
+                }
+                else
+                {
+                    connect(client, *device);
+                }
+            }
+            else if (type == "disconnect")
+            {
+                if (state.device >= 0)
+                {
+                    reply(client, "{\"type\":\"disconnected\",\"id\":\"" + deviceId(state.device) + "\",\"reason\":\"requested\"}");
+                    release(devices[(size_t)state.device], client);
+                }
+            }
+            else if (type == "ecg")
+            {
+                ok = false;
+                error = "ECG is not simulated";
+            }
+            else if (type == "shm")
+            {
+                // Answer to a shm_offer; not a command, so nothing to acknowledge
+                acceptRing(client, jsonString(json, "name"), jsonString(json, "on") == "true");
+                return;
+            }
+            else
+            {
+                ok = false;
+                error = "unknown command " + type;
+            }
+
+            if (! requestId.empty())
+            {
+                reply(client, "{\"type\":\"ack\",\"request_id\":" + requestId + ",\"ok\":" + (ok ? "true" : "false")
+                              + (ok ? std::string() : ",\"error\":\"" + escapeJson(error) + "\"") + "}");
+            }
+        }
+
+        void updateSubscription(BridgeServer::ClientId client, uint32_t types, bool enable)
+        {
+            if (const auto* current = server.getSubscription(client))
+            {
+                auto subscription = *current;
+                subscription.types = enable ? (subscription.types | types) : (subscription.types & ~types);
+                server.setSubscription(client, std::move(subscription));
+            }
+        }
+
+        void acceptRing(BridgeServer::ClientId client, const std::string& name, bool on)
+        {
+            auto& state = clientStates[client];
+            if (state.device < 0 || devices[(size_t)state.device].ring == nullptr
+                || devices[(size_t)state.device].ring->getName() != name)
+                return; // stale answer for a device the client has since left
+
+            state.usingRing = on;
+            if (! state.explicitSubscription)
+                updateSubscription(client, RING_TYPES, ! on);
+
+            log(client, on ? "reading " + name : "declined " + name + ", using the socket");
+        }
+
+        /** A plugin instance follows one strap: it gets that device's stream and status only. */
+        void connect(BridgeServer::ClientId client, Device& device)
+        {
+            auto& state = clientStates[client];
+            if (state.device >= 0 && state.device != device.index)
+                release(devices[(size_t)state.device], client);
+
+            state.device = device.index;
+            if (std::find(device.owners.begin(), device.owners.end(), client) == device.owners.end())
+                device.owners.push_back(client);
+
+            if (! state.explicitSubscription)
+            {
+                BridgeServer::Subscription subscription = *server.getSubscription(client);
+                subscription.types |= STREAM_TYPES;
+                subscription.devices = { device.id };
+                server.setSubscription(client, std::move(subscription));
+            }
+
+            // The socket keeps carrying heart rate until the client accepts the ring
+            state.usingRing = false;
+            if (state.sharedMemory && device.ring != nullptr)
+            {
+                reply(client, "{\"type\":\"shm_offer\",\"id\":\"" + device.id + "\",\"name\":\"" + device.ring->getName()
+                              + "\",\"capacity\":" + std::to_string(device.ring->getCapacity()) + "}");
+            }
+
+            if (! device.isStreaming())
+            {
+                startStreaming(device);
+                publishStatus(device, "{\"type\":\"connected\",\"id\":\"" + device.id + "\"}");
+            }
+            else if (! device.linkDown)
+            {
+                // Already streaming for another instance: only the newcomer needs telling
+                reply(client, "{\"type\":\"connected\",\"id\":\"" + device.id + "\"}");
+            }
+
+            log(client, "streaming " + device.id + " (" + std::to_string(device.owners.size()) + " client(s))");
+        }
+
+        void release(Device& device, BridgeServer::ClientId client)
+        {
+            const auto owner = std::find(device.owners.begin(), device.owners.end(), client);
+            if (owner == device.owners.end())
+                return;
+
+            device.owners.erase(owner);
+
+            auto state = clientStates.find(client);
+            if (state != clientStates.end())
+            {
+                state->second.device = -1;
+                state->second.usingRing = false;
+                if (! state->second.explicitSubscription)
+                    updateSubscription(client, STREAM_TYPES, false);
+            }
+
+            // The strap is only released once nobody is listening to it
+            if (device.owners.empty())
+                device.source.reset();
+        }
+
+        void startStreaming(Device& device)
+        {
+            if (session.empty())
+                device.source = std::make_unique<SyntheticSource>(device.index, options.seed);
+            else
+                device.source = std::make_unique<RecordedSource>(session);
+
+            device.linkDown = false;
+            device.source->next(device.pending);
+            device.wallOrigin = now() - device.pending.time / options.speed;
+            device.pendingDue = now();
+            device.nextOutageStart = device.pending.time + nextOutageGap();
+        }
+
+        double nextOutageGap()
+        {
+            if (options.outageEvery <= 0.0)
+                return 1.0e300;
+
+            std::exponential_distribution<double> gap(1.0 / options.outageEvery);
+            return gap(random);
+        }
+
+        //==============================================================================
+        void serviceDevice(Device& device, double wallNow)
+        {
+            // Catch up on everything due; at high speed that is many messages per wake-up
+            while (device.isStreaming() && wallNow >= device.pendingDue)
+            {
+                deliver(device, device.pending);
+
+                device.source->next(device.pending);
+                const double due = device.wallOrigin + device.pending.time / options.speed;
+                std::uniform_real_distribution<double> jitter(0.0, options.jitterMs / 1000.0);
+                device.pendingDue = std::max(device.pendingDue, due + (options.jitterMs > 0.0 ? jitter(random) : 0.0));
+            }
+        }
+
+        void deliver(Device& device, const Sample& sample)
+        {
+            if (device.linkDown)
+            {
+                if (sample.time < device.outageEnd)
+                    return;
+
+                device.linkDown = false;
+                device.nextOutageStart = sample.time + nextOutageGap();
+                publishStatus(device, "{\"type\":\"connected\",\"id\":\"" + device.id + "\"}");
+            }
+            else if (sample.time >= device.nextOutageStart)
+            {
+                device.linkDown = true;
+                device.outageEnd = sample.time + options.outageFor;
+                ++stats.outages;
+                publishStatus(device, "{\"type\":\"disconnected\",\"id\":\"" + device.id + "\",\"reason\":\"link lost\"}");
+                return;
+            }
+
+            const uint32_t sequence = device.heartRateSequence++;
+
+            if (options.dropProbability > 0.0 && std::uniform_real_distribution<double>(0.0, 1.0)(random) < options.dropProbability)
+            {
+                ++stats.dropped;   // the gap is visible in the binary sequence numbers
+                return;
+            }
+
+            // Stamped with the nominal notification time, so --jitter shows up as
+            // transport delay in the plugin's latency statistics
+            const double notifiedAt = std::min(now(), device.wallOrigin + sample.time / options.speed);
+
+            if (device.ring != nullptr)
+                writeRing(*device.ring, sequence, sample, notifiedAt);
+
+            // Serialised at most once per wire format, however many instances follow this strap
+            const int recipients = server.publish(BridgeServer::HeartRate, device.id, [&](BridgeServer::Format format)
+            {
+                if (format == BridgeServer::Format::Binary)
+                {
+                    std::vector<uint8_t> frame;
+                    BridgeProtocol::encodeHeartRateFrame(sequence, sample.bpm, notifiedAt,
+                                                         sample.rrMs.data(), (int)sample.rrMs.size(), frame);
+                    return BridgeServer::makeFrame(std::move(frame));
+                }
+
+                std::string json = "{\"type\":\"hr_data\",\"id\":\"" + device.id + "\",\"bpm\":" + std::to_string((int)std::lround(sample.bpm)) + ",\"rr\":[";
+                for (size_t i = 0; i < sample.rrMs.size(); ++i)
+                    json += (i > 0 ? "," : "") + std::to_string((int)std::lround(sample.rrMs[i]));
+                json += "],\"timestamp\":" + std::to_string(notifiedAt) + "}";
+                return BridgeServer::makeJsonFrame(json);
+            });
+
+            ++stats.heartRateMessages;
+            stats.deliveries += (uint64_t)recipients;
+        }
+
+        /** The heart rate with its first RR intervals, then any remaining intervals in RR-only records. */
+        void writeRing(BiometricSharedRing& ring, uint32_t sequence, const Sample& sample, double notifiedAt)
+        {
+            BiometricSharedRing::Record record;
+            record.type = BiometricSharedRing::RecordType::HeartRate;
+            record.sequence = sequence;
+            record.timestampSeconds = notifiedAt;   // steady_clock seconds, the ring's timebase
+            record.bpm = sample.bpm;
+
+            size_t position = 0;
+            do
+            {
+                record.numRrIntervals = (int)std::min(sample.rrMs.size() - position, (size_t)BiometricSharedRing::MAX_RR_PER_RECORD);
+                std::copy_n(sample.rrMs.begin() + (std::ptrdiff_t)position, record.numRrIntervals, record.rrIntervalsMs.begin());
+                position += (size_t)record.numRrIntervals;
+
+                ring.write(record);
+                ++stats.ringRecords;
+
+                record.type = BiometricSharedRing::RecordType::RrIntervals;
+                record.bpm = 0.0f;
+            }
+            while (position < sample.rrMs.size());
+        }
+
+        void publishStatus(const Device& device, const std::string& json)
+        {
+            const auto frame = BridgeServer::makeJsonFrame(json);
+            server.publish(BridgeServer::DeviceStatus, device.id, [&frame](BridgeServer::Format) { return frame; });
+        }
+
+        void publishHeartbeat()
+        {
+            server.publish(BridgeServer::Heartbeat, {}, [this](BridgeServer::Format format)
+            {
+                if (format == BridgeServer::Format::Json)
+                    return BridgeServer::makeJsonFrame("{\"type\":\"bridge_heartbeat\",\"timestamp\":" + std::to_string(now()) + "}");
+
+                std::vector<uint8_t> frame;
+                BridgeProtocol::encodeHeartbeatFrame(heartbeatSequence++, now(), frame);
+                return BridgeServer::makeFrame(std::move(frame));
+            });
+        }
+
+        void publishAdvertisements()
+        {
+            std::uniform_int_distribution<int> rssi(-80, -45);
+
+            for (const auto& device : devices)
+            {
+                const auto frame = BridgeServer::makeJsonFrame("{\"type\":\"device_found\",\"id\":\"" + device.id
+                                                               + "\",\"name\":\"HeartSync Sim " + std::to_string(device.index + 1)
+                                                               + "\",\"rssi\":" + std::to_string(rssi(random))
+                                                               + ",\"services\":[\"180D\"]}");
+                server.publish(BridgeServer::Advertisements, device.id, [&frame](BridgeServer::Format) { return frame; });
+            }
+        }
+
+        void reply(BridgeServer::ClientId client, const std::string& json)
+        {
+            server.send(client, BridgeServer::makeJsonFrame(json));
+        }
+
+        //==============================================================================
+        void log(BridgeServer::ClientId client, const std::string& message) const
+        {
+            if (! options.quiet)
+                std::fprintf(stderr, "client %u: %s\n", client, message.c_str());
+        }
+
+        void report(double elapsed)
+        {
+            if (options.quiet)
+                return;
+
+            const auto serverStats = server.getStats();
+            std::fprintf(stderr, "[%7.1fs] clients=%d hr=%llu (+%llu/s) delivered=%llu shm=%llu encoded=%llu bytes=%llu dropped=%llu outages=%llu evicted=%llu\n",
+                         elapsed, serverStats.clients,
+                         (unsigned long long)stats.heartRateMessages,
+                         (unsigned long long)(stats.heartRateMessages - lastReportedMessages),
+                         (unsigned long long)stats.deliveries, (unsigned long long)stats.ringRecords,
+                         (unsigned long long)serverStats.encoded,
+                         (unsigned long long)serverStats.bytesSent, (unsigned long long)stats.dropped,
+                         (unsigned long long)stats.outages, (unsigned long long)serverStats.evicted);
+            lastReportedMessages = stats.heartRateMessages;
+        }
+
+        const Options options;
+        std::vector<Sample> session;
+        std::mt19937 random;
+        BridgeServer server;
+        std::vector<Device> devices;
+        std::map<BridgeServer::ClientId, ClientState> clientStates;
+        uint32_t heartbeatSequence = 0;
+        SimStats stats;
+        uint64_t lastReportedMessages = 0;
+    };
+
+    void handleSignal(int)
+    {
+        stopRequested = 1;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    options.socketPath = defaultSocketPath();
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--socket" && hasValue)
+            options.socketPath = argv[++i];
+        else if (arg == "--session" && hasValue)
+            options.sessionPath = argv[++i];
+        else if (arg == "--synthetic")
+            options.sessionPath.clear();
+        else if (arg == "--devices" && hasValue)
+            options.numDevices = std::atoi(argv[++i]);
+        else if (arg == "--speed" && hasValue)
+            options.speed = std::atof(argv[++i]);
+        else if (arg == "--jitter" && hasValue)
+            options.jitterMs = std::atof(argv[++i]);
+        else if (arg == "--drop" && hasValue)
+            options.dropProbability = std::atof(argv[++i]);
+        else if (arg == "--outage-every" && hasValue)
+            options.outageEvery = std::atof(argv[++i]);
+        else if (arg == "--outage-for" && hasValue)
+            options.outageFor = std::atof(argv[++i]);
+        else if (arg == "--duration" && hasValue)
+            options.duration = std::atof(argv[++i]);
+        else if (arg == "--max-queue" && hasValue)
+            options.maxQueuedBytes = (size_t)std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--seed" && hasValue)
+            options.seed = (unsigned)std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--no-shm")
+            options.sharedMemory = false;
+        else if (arg == "--quiet")
+            options.quiet = true;
+        else
+        {
+            printUsage();
+            return 2;
+        }
+    }
+
+    if (options.speed < 1.0 || options.speed > 1000.0 || options.numDevices < 1 || options.numDevices > 99
+        || options.jitterMs < 0.0 || options.dropProbability < 0.0 || options.dropProbability > 1.0
+        || options.outageFor < 0.0)
+    {
+        printUsage();
+        return 2;
+    }
+
+    ::signal(SIGINT, handleSignal);
+    ::signal(SIGTERM, handleSignal);
+    ::signal(SIGPIPE, SIG_IGN);
+
+    Simulator simulator(options);
+    if (! simulator.loadSource())
+        return 1;
+
+    return simulator.run();
+}
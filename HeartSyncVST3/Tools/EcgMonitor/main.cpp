@@ -0,0 +1,265 @@
+/*
+    heartsync-ecg-monitor
+
+    Runs the plugin's bridge frame decoder and R-peak detector outside a DAW.
+
+        heartsync-ecg-monitor --socket <path>
+            Connects to a bridge socket (or tools/ecg_replay.py standing in
+            for one), negotiates protocol v2 and prints every beat found in
+            the ECG frames along with any heart-rate/RR frames.
+
+        heartsync-ecg-monitor --file <ecg.txt> [--rate 130]
+            Runs the detector over a recorded file (one microvolt sample per
+            line; the last column is used for CSV/semicolon separated files).
+*/
+
+#include "BridgeProtocol.h"
+#include "RPeakDetector.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    void printUsage()
+    {
+        std::fprintf(stderr,
+                     "usage: heartsync-ecg-monitor --socket <path>\n"
+                     "       heartsync-ecg-monitor --file <ecg.txt> [--rate <Hz>]\n");
+    }
+
+    void attachPrinter(RPeakDetector& detector)
+    {
+        detector.onBeat = [](const RPeakDetector::Beat& beat)
+        {
+            if (beat.rrMs > 0.0)
+                std::printf("beat t=%9.3fs rr=%7.1fms hr=%6.1f%s\n", beat.timeSeconds, beat.rrMs,
+                            60000.0 / beat.rrMs, beat.fromSearchBack ? " (search-back)" : "");
+            else
+                std::printf("beat t=%9.3fs\n", beat.timeSeconds);
+
+            std::fflush(stdout);
+        };
+    }
+
+    bool readExactly(int fd, uint8_t* dest, size_t size)
+    {
+        size_t total = 0;
+        while (total < size)
+        {
+            const ssize_t n = ::recv(fd, dest + total, size - total, 0);
+            if (n <= 0)
+                return false;
+            total += (size_t)n;
+        }
+        return true;
+    }
+
+    bool sendHandshake(int fd)
+    {
+        char json[160];
+        const int length = std::snprintf(json, sizeof(json),
+                                         "{\"type\":\"handshake\",\"version\":%d,"
+                                         "\"binary_frames\":[\"hr\",\"rr\",\"ecg\",\"heartbeat\"]}",
+                                         BridgeProtocol::PROTOCOL_VERSION);
+
+        const uint32_t prefix = htonl((uint32_t)length);
+        return ::send(fd, &prefix, 4, 0) == 4 && ::send(fd, json, (size_t)length, 0) == length;
+    }
+
+    void printHeartRateFrame(const BridgeProtocol::HeartRateFrame& frame)
+    {
+        if (frame.bpm > 0.0f)
+            std::printf("hr   %5.1f bpm", frame.bpm);
+        else
+            std::printf("rr  ");
+
+        for (int i = 0; i < frame.numRrIntervals; ++i)
+            std::printf(" %.0f", frame.rrIntervalsMs[(size_t)i]);
+
+        std::printf("\n");
+    }
+
+    int runSocket(const std::string& path)
+    {
+        const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0)
+        {
+            std::perror("socket");
+            return 1;
+        }
+
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            std::perror(("connect " + path).c_str());
+            ::close(fd);
+            return 1;
+        }
+
+        if (! sendHandshake(fd))
+        {
+            std::perror("handshake");
+            ::close(fd);
+            return 1;
+        }
+
+        RPeakDetector detector;
+        attachPrinter(detector);
+
+        std::vector<uint8_t> payload;
+        BridgeProtocol::HeartRateFrame heartRate;
+        std::vector<float> samples((size_t)BridgeProtocol::MAX_ECG_SAMPLES);
+        double detectorRate = 0.0;
+        uint32_t expectedSequence = 0;
+        bool sequenceValid = false;
+
+        for (;;)
+        {
+            uint32_t prefix = 0;
+            if (! readExactly(fd, reinterpret_cast<uint8_t*>(&prefix), 4))
+                break;
+
+            const uint32_t length = ntohl(prefix);
+            if (length == 0 || length > BridgeProtocol::MAX_PAYLOAD_SIZE)
+            {
+                std::fprintf(stderr, "invalid message length %u\n", length);
+                break;
+            }
+
+            payload.resize(length);
+            if (! readExactly(fd, payload.data(), length))
+                break;
+
+            if (! BridgeProtocol::isBinaryFrame(payload.data(), payload.size()))
+            {
+                std::printf("json %.*s\n", (int)payload.size(), reinterpret_cast<const char*>(payload.data()));
+                continue;
+            }
+
+            BridgeProtocol::FrameHeader header;
+            if (BridgeProtocol::decodeHeader(payload.data(), payload.size(), header)
+                && header.type != BridgeProtocol::FrameType::Ecg)
+            {
+                if (header.type == BridgeProtocol::FrameType::HeartRate
+                    || header.type == BridgeProtocol::FrameType::RrIntervals)
+                {
+                    if (BridgeProtocol::decodeHeartRateFrame(payload.data(), payload.size(), heartRate))
+                        printHeartRateFrame(heartRate);
+                    else
+                        std::fprintf(stderr, "malformed heart-rate frame (%u bytes)\n", length);
+                }
+
+                // Heartbeats only keep the connection alive
+                continue;
+            }
+
+            BridgeProtocol::EcgFrame frame;
+            if (! BridgeProtocol::decodeEcgFrame(payload.data(), payload.size(), frame, samples.data(), (int)samples.size()))
+            {
+                std::fprintf(stderr, "malformed binary frame (%u bytes)\n", length);
+                sequenceValid = false;
+                continue;
+            }
+
+            const bool gap = sequenceValid && frame.sequence != expectedSequence;
+            if (gap)
+                std::printf("gap: expected frame %u, got %u\n", expectedSequence, frame.sequence);
+
+            if (gap || frame.sampleRateHz != detectorRate)
+            {
+                detector.prepare(frame.sampleRateHz);
+                detectorRate = frame.sampleRateHz;
+            }
+
+            expectedSequence = frame.sequence + 1;
+            sequenceValid = true;
+            detector.process(samples.data(), frame.numSamples);
+        }
+
+        ::close(fd);
+        return 0;
+    }
+
+    int runFile(const std::string& path, double sampleRate)
+    {
+        std::ifstream input(path);
+        if (! input)
+        {
+            std::fprintf(stderr, "cannot open %s\n", path.c_str());
+            return 1;
+        }
+
+        std::vector<float> samples;
+        std::string line;
+        while (std::getline(input, line))
+        {
+            for (auto& c : line)
+                if (c == ',' || c == ';' || c == '\t')
+                    c = ' ';
+
+            std::istringstream fields(line);
+            std::string field, last;
+            while (fields >> field)
+                last = field;
+
+            // Header lines do not parse as numbers and are skipped
+            char* end = nullptr;
+            const double value = std::strtod(last.c_str(), &end);
+            if (! last.empty() && end != last.c_str())
+                samples.push_back((float)value);
+        }
+
+        RPeakDetector detector;
+        detector.prepare(sampleRate);
+        attachPrinter(detector);
+        detector.process(samples.data(), (int)samples.size());
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::string socketPath, filePath;
+    double sampleRate = 130.0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--socket" && hasValue)
+            socketPath = argv[++i];
+        else if (arg == "--file" && hasValue)
+            filePath = argv[++i];
+        else if (arg == "--rate" && hasValue)
+            sampleRate = std::atof(argv[++i]);
+        else
+        {
+            printUsage();
+            return 2;
+        }
+    }
+
+    if (! socketPath.empty())
+        return runSocket(socketPath);
+
+    if (! filePath.empty())
+        return runFile(filePath, sampleRate);
+
+    printUsage();
+    return 2;
+}
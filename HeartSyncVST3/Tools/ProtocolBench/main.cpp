@@ -0,0 +1,124 @@
+/*
+    heartsync-protocol-bench
+
+    Compares the bridge receive path for heart-rate messages: the JSON path
+    (per-message MemoryBlock, String, JSON::parse into DynamicObjects and an
+    RR juce::Array, as HeartSyncBLEClient did before protocol v2) against
+    decoding protocol v2 binary frames. Reports messages/second and CPU time
+    per message for each.
+
+        heartsync-protocol-bench [messages]     (default 200000)
+*/
+
+#include <juce_core/juce_core.h>
+#include "../../Source/Core/BridgeProtocol.h"
+
+#include <cstdio>
+#include <ctime>
+#include <vector>
+
+namespace
+{
+    struct Result
+    {
+        double wallSeconds{0.0};
+        double cpuSeconds{0.0};
+        double checksum{0.0};   // keeps the optimiser honest
+    };
+
+    uint32_t readLength(const uint8_t* p)
+    {
+        return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+    }
+
+    template <typename Decoder>
+    Result run(const std::vector<uint8_t>& stream, Decoder&& decode)
+    {
+        Result result;
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+        const auto startCpu = std::clock();
+
+        size_t position = 0;
+        while (position + 4 <= stream.size())
+        {
+            const uint32_t length = readLength(stream.data() + position);
+            position += 4;
+            result.checksum += decode(stream.data() + position, (size_t)length);
+            position += length;
+        }
+
+        result.cpuSeconds = (double)(std::clock() - startCpu) / CLOCKS_PER_SEC;
+        result.wallSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+        return result;
+    }
+
+    void print(const char* name, const Result& result, int messages, size_t streamBytes)
+    {
+        std::printf("%-8s %12.0f msg/s  %8.1f ns CPU/msg  %6.1f bytes/msg\n",
+                    name,
+                    messages / result.wallSeconds,
+                    1.0e9 * result.cpuSeconds / messages,
+                    (double)streamBytes / messages);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const int messages = argc > 1 ? juce::jmax(1, juce::String(argv[1]).getIntValue()) : 200000;
+    const float rr[] = { 812.0f, 845.0f };
+
+    // Identical content in both encodings: one hr_data per beat with two RR values
+    std::vector<uint8_t> jsonStream, binaryStream, frame;
+    for (int i = 0; i < messages; ++i)
+    {
+        const float bpm = 60.0f + (float)(i % 40);
+        const double timestamp = 1700000000.0 + i * 0.8;
+
+        const juce::String json = "{\"type\":\"hr_data\",\"bpm\":" + juce::String(bpm, 1)
+                                  + ",\"timestamp\":" + juce::String(timestamp, 3)
+                                  + ",\"rr\":[" + juce::String(rr[0], 1) + "," + juce::String(rr[1], 1) + "]}";
+        const auto length = (uint32_t)json.getNumBytesAsUTF8();
+        jsonStream.push_back((uint8_t)(length >> 24));
+        jsonStream.push_back((uint8_t)(length >> 16));
+        jsonStream.push_back((uint8_t)(length >> 8));
+        jsonStream.push_back((uint8_t)length);
+        jsonStream.insert(jsonStream.end(), json.toRawUTF8(), json.toRawUTF8() + length);
+
+        BridgeProtocol::encodeHeartRateFrame((uint32_t)i, bpm, timestamp, rr, 2, frame);
+        binaryStream.insert(binaryStream.end(), frame.begin(), frame.end());
+    }
+
+    const auto jsonResult = run(jsonStream, [](const uint8_t* payload, size_t size)
+    {
+        juce::MemoryBlock messageData(size);
+        messageData.copyFrom(payload, 0, size);
+
+        const auto parsed = juce::JSON::parse(juce::String::fromUTF8(static_cast<const char*>(messageData.getData()), (int)size));
+        if (parsed.getProperty("type", juce::String()).toString() != "hr_data")
+            return 0.0;
+
+        juce::Array<float> rrIntervals;
+        if (auto* arr = parsed.getProperty("rr", juce::var()).getArray())
+            for (const auto& v : *arr)
+                rrIntervals.add((float)v);
+
+        return (double)(float)parsed.getProperty("bpm", 0) + (rrIntervals.isEmpty() ? 0.0 : rrIntervals.getFirst());
+    });
+
+    BridgeProtocol::HeartRateFrame decoded;
+    const auto binaryResult = run(binaryStream, [&decoded](const uint8_t* payload, size_t size)
+    {
+        if (! BridgeProtocol::isBinaryFrame(payload, size) || ! BridgeProtocol::decodeHeartRateFrame(payload, size, decoded))
+            return 0.0;
+
+        return (double)decoded.bpm + (decoded.numRrIntervals > 0 ? decoded.rrIntervalsMs[0] : 0.0f);
+    });
+
+    std::printf("%d heart-rate messages (2 RR values each)\n", messages);
+    print("json", jsonResult, messages, jsonStream.size());
+    print("binary", binaryResult, messages, binaryStream.size());
+    std::printf("speed-up %.1fx (checksums %.0f / %.0f)\n",
+                jsonResult.cpuSeconds / binaryResult.cpuSeconds,
+                jsonResult.checksum, binaryResult.checksum);
+    return 0;
+}
@@ -0,0 +1,236 @@
+#!/usr/bin/env python3
+"""
+ECG Replay Stand-in for the HeartSync Bridge
+Serves a recorded ECG file on a local socket using the bridge protocol, so the
+ECG path (binary frames, R-peak detection) can be exercised without a strap or
+macOS.
+
+Usage:
+    python3 ecg_replay.py ecg.txt --socket /tmp/heartsync-bridge.sock
+    python3 ecg_replay.py ecg.txt --rate 130 --frame 73 --speed 4 --loop
+    python3 ecg_replay.py --synthetic --socket /tmp/heartsync-bridge.sock
+
+Input files hold one sample (microvolts) per line; for CSV or semicolon
+separated exports (e.g. Polar "timestamp;ecg") the last column is used and
+non-numeric header lines are skipped.
+
+Then connect a client, e.g.:
+    heartsync-ecg-monitor --socket /tmp/heartsync-bridge.sock
+"""
+
+import argparse
+import json
+import math
+import os
+import random
+import socket
+import struct
+import sys
+import time
+
+PROTOCOL_VERSION = 2
+FRAME_MAGIC = 0xB5
+FRAME_VERSION = 2
+FRAME_TYPE_ECG = 1
+FRAME_TYPE_HEARTBEAT = 4
+MAX_PAYLOAD = 65536
+
+
+def default_socket_path():
+    """The first path the plugin tries on this platform."""
+    if sys.platform.startswith("linux"):
+        runtime_dir = os.environ.get("XDG_RUNTIME_DIR")
+        if runtime_dir:
+            return os.path.join(runtime_dir, "heartsync", "bridge.sock")
+        return f"/tmp/heartsync-{os.getuid()}/bridge.sock"
+    return os.path.expanduser("~/Library/Application Support/HeartSync/bridge.sock")
+
+
+DEFAULT_SOCKET = default_socket_path()
+
+
+def send_json(conn, message):
+    """Send a length-prefixed JSON message."""
+    payload = json.dumps(message).encode("utf-8")
+    conn.sendall(struct.pack(">I", len(payload)) + payload)
+
+
+def binary_frame(frame_type, sequence, count, body):
+    """Length-prefixed protocol v2 frame: big-endian length, little-endian payload."""
+    header = struct.pack("<BBBBIHH", FRAME_MAGIC, FRAME_VERSION, frame_type, 0,
+                         sequence & 0xFFFFFFFF, count, 0)
+    payload = header + body
+    if len(payload) > MAX_PAYLOAD:
+        raise ValueError("frame too large")
+    return struct.pack(">I", len(payload)) + payload
+
+
+def ecg_frame(sequence, rate_hz, samples):
+    """Binary ECG frame (see Source/Core/BridgeProtocol.h)."""
+    body = struct.pack("<I", int(round(rate_hz * 1000))) + struct.pack("<%di" % len(samples), *samples)
+    return binary_frame(FRAME_TYPE_ECG, sequence, len(samples), body)
+
+
+def heartbeat_frame(sequence):
+    """Binary heartbeat frame carrying the bridge wall-clock time."""
+    return binary_frame(FRAME_TYPE_HEARTBEAT, sequence, 0, struct.pack("<d", time.time()))
+
+
+def read_handshake(conn, timeout=1.0):
+    """Return the client's handshake message, or None if it sent none in time."""
+    conn.settimeout(timeout)
+    try:
+        prefix = conn.recv(4)
+        if len(prefix) < 4:
+            return None
+        length = struct.unpack(">I", prefix)[0]
+        payload = b""
+        while len(payload) < length:
+            chunk = conn.recv(length - len(payload))
+            if not chunk:
+                return None
+            payload += chunk
+        message = json.loads(payload.decode("utf-8"))
+        return message if message.get("type") == "handshake" else None
+    except (socket.timeout, ValueError):
+        return None
+    finally:
+        conn.settimeout(None)
+
+
+def load_samples(path):
+    """Read microvolt samples from a text/CSV file."""
+    samples = []
+    with open(path, "r") as handle:
+        for line in handle:
+            fields = line.replace(",", " ").replace(";", " ").replace("\t", " ").split()
+            if not fields:
+                continue
+            try:
+                samples.append(int(round(float(fields[-1]))))
+            except ValueError:
+                continue  # header line
+    return samples
+
+
+def synthetic_samples(rate_hz, seconds=300.0, seed=1):
+    """Gaussian-wave ECG with respiratory sinus arrhythmia (15 breaths/min)."""
+    rng = random.Random(seed)
+    beats, t = [], 0.5
+    while t < seconds:
+        beats.append(t)
+        t += 0.85 + 0.05 * math.sin(2 * math.pi * 0.25 * t) + rng.gauss(0, 0.01)
+
+    samples, beat_index = [], 0
+    for i in range(int(seconds * rate_hz)):
+        ti = i / rate_hz
+        value = 200 * math.sin(2 * math.pi * 0.3 * ti) + rng.gauss(0, 30)
+        while beat_index < len(beats) and beats[beat_index] < ti - 0.6:
+            beat_index += 1
+        for b in beats[beat_index:beat_index + 2]:
+            d = ti - b
+            value += 1000 * math.exp(-d * d / (2 * 0.012 ** 2))
+            value += 350 * math.exp(-(d - 0.28) ** 2 / (2 * 0.045 ** 2))
+            value += 120 * math.exp(-(d + 0.16) ** 2 / (2 * 0.025 ** 2))
+        samples.append(int(round(value)))
+    return samples
+
+
+def serve(conn, samples, args):
+    """Stream one client until it disconnects (or the file ends without --loop)."""
+    handshake = read_handshake(conn)
+    version = min(PROTOCOL_VERSION, int(handshake.get("version", 1))) if handshake else 1
+    if version < 2:
+        print("  client did not negotiate protocol v2; ECG frames are binary-only, sending anyway")
+
+    send_json(conn, {"type": "ready", "version": version})
+    send_json(conn, {"type": "permission", "state": "authorized"})
+    send_json(conn, {"type": "connected", "id": "ECG-REPLAY"})
+
+    frame_period = args.frame / args.rate / args.speed
+    next_send = time.monotonic()
+    next_heartbeat = next_send
+    sequence, position, heartbeat_sequence = 0, 0, 0
+
+    while True:
+        if position + args.frame > len(samples):
+            if not args.loop:
+                return
+            position = 0
+
+        now = time.monotonic()
+        if now >= next_heartbeat:
+            if version >= 2:
+                conn.sendall(heartbeat_frame(heartbeat_sequence))
+                heartbeat_sequence += 1
+            else:
+                send_json(conn, {"type": "bridge_heartbeat"})
+            next_heartbeat = now + 1.0
+
+        chunk = samples[position:position + args.frame]
+        if args.drop and random.random() < args.drop:
+            print(f"  dropping frame {sequence}")
+        else:
+            conn.sendall(ecg_frame(sequence, args.rate, chunk))
+
+        sequence += 1
+        position += args.frame
+        next_send += frame_period
+        time.sleep(max(0.0, next_send - time.monotonic()))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("file", nargs="?", help="recorded ECG (microvolts)")
+    parser.add_argument("--synthetic", action="store_true", help="generate a synthetic ECG instead of a file")
+    parser.add_argument("--socket", default=DEFAULT_SOCKET, help="socket path to listen on")
+    parser.add_argument("--rate", type=float, default=130.0, help="sample rate in Hz (default 130, Polar H10)")
+    parser.add_argument("--frame", type=int, default=73, help="samples per frame (default 73)")
+    parser.add_argument("--speed", type=float, default=1.0, help="playback speed multiplier")
+    parser.add_argument("--drop", type=float, default=0.0, help="probability of dropping a frame")
+    parser.add_argument("--loop", action="store_true", help="restart the file at its end")
+    args = parser.parse_args()
+
+    if args.synthetic:
+        samples = synthetic_samples(args.rate)
+    elif args.file:
+        samples = load_samples(args.file)
+    else:
+        parser.error("give an ECG file or --synthetic")
+
+    if len(samples) < args.frame:
+        print("ERROR: not enough samples", file=sys.stderr)
+        sys.exit(1)
+
+    os.makedirs(os.path.dirname(args.socket) or ".", mode=0o700, exist_ok=True)
+    if os.path.exists(args.socket):
+        os.unlink(args.socket)
+
+    server = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    server.bind(args.socket)
+    server.listen(1)
+    print(f"✓ Serving {len(samples)} samples at {args.rate:g} Hz on {args.socket}")
+
+    try:
+        while True:
+            conn, _ = server.accept()
+            print("✓ Client connected")
+            try:
+                serve(conn, samples, args)
+            except (BrokenPipeError, ConnectionResetError):
+                pass
+            finally:
+                conn.close()
+                print("✓ Client disconnected")
+            if not args.loop:
+                break
+    except KeyboardInterrupt:
+        pass
+    finally:
+        server.close()
+        if os.path.exists(args.socket):
+            os.unlink(args.socket)
+
+
+if __name__ == "__main__":
+    main()